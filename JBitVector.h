@@ -0,0 +1,1006 @@
+#pragma once
+#ifndef _JBITVECTOR_
+#define _JBITVECTOR_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "JVector.h"
+#include "jstd_simd.h"
+
+// Reference to one bit of a JBitVector.
+class JBitVector_Reference
+{
+public:
+	using word_type = _STD uint64_t;
+
+	JBitVector_Reference(word_type *word, const word_type mask) noexcept
+		: m_word(word),
+		  m_mask(mask)
+		{}
+
+	JBitVector_Reference(const JBitVector_Reference&) noexcept = default;
+
+	JBitVector_Reference& operator=(const bool value) noexcept
+	{
+		if (value)
+		{
+			*m_word |= m_mask;
+		}
+		else
+		{
+			*m_word &= ~m_mask;
+		}
+
+		return *this;
+	}
+
+	// Assigns the bit referred to, not the reference.
+	JBitVector_Reference& operator=(const JBitVector_Reference &other) noexcept
+	{
+		return *this = static_cast<bool>(other);
+	}
+
+	operator bool() const noexcept
+	{
+		return (*m_word & m_mask) != 0;
+	}
+
+	NODISCARD bool operator~() const noexcept
+	{
+		return (*m_word & m_mask) == 0;
+	}
+
+	JBitVector_Reference& flip() noexcept
+	{
+		*m_word ^= m_mask;
+		return *this;
+	}
+
+	// Swaps the bits, for algorithms that swap through the iterators.
+	friend void swap(JBitVector_Reference left, JBitVector_Reference right) noexcept
+	{
+		const bool temp = left;
+		left            = right;
+		right           = temp;
+	}
+
+private:
+	word_type *m_word;
+	word_type  m_mask;
+};
+
+// JBitVector random access iterator. It refers to the vector and a bit index.
+template <class MyVector>
+class JBitVector_Const_Iterator
+{
+public:
+	using iterator_category = _STD random_access_iterator_tag;
+	using value_type        = bool;
+	using difference_type   = typename MyVector::difference_type;
+	using pointer           = void;
+	using reference         = bool;
+
+	MyVector    *vec;
+	_STD size_t index;
+
+	JBitVector_Const_Iterator() noexcept
+		: vec(nullptr),
+		  index(0)
+		{}
+
+	JBitVector_Const_Iterator(MyVector *vector, const _STD size_t pos) noexcept
+		: vec(vector),
+		  index(pos)
+		{}
+
+	reference operator*() const noexcept
+	{
+		return vec->test(index);
+	}
+
+	reference operator[](const difference_type off) const noexcept
+	{
+		return vec->test(index + off);
+	}
+
+	JBitVector_Const_Iterator& operator++() noexcept
+	{
+		++index;
+		return *this;
+	}
+
+	JBitVector_Const_Iterator operator++(int) noexcept
+	{
+		JBitVector_Const_Iterator temp = *this;
+		++index;
+		return temp;
+	}
+
+	JBitVector_Const_Iterator& operator--() noexcept
+	{
+		--index;
+		return *this;
+	}
+
+	JBitVector_Const_Iterator operator--(int) noexcept
+	{
+		JBitVector_Const_Iterator temp = *this;
+		--index;
+		return temp;
+	}
+
+	JBitVector_Const_Iterator& operator+=(const difference_type off) noexcept
+	{
+		index += off;
+		return *this;
+	}
+
+	JBitVector_Const_Iterator& operator-=(const difference_type off) noexcept
+	{
+		index -= off;
+		return *this;
+	}
+
+	NODISCARD JBitVector_Const_Iterator operator+(const difference_type off) const noexcept
+	{
+		return JBitVector_Const_Iterator(vec, index + off);
+	}
+
+	NODISCARD friend JBitVector_Const_Iterator operator+(const difference_type off,
+		const JBitVector_Const_Iterator &iter) noexcept
+	{
+		return iter + off;
+	}
+
+	NODISCARD JBitVector_Const_Iterator operator-(const difference_type off) const noexcept
+	{
+		return JBitVector_Const_Iterator(vec, index - off);
+	}
+
+	NODISCARD difference_type operator-(const JBitVector_Const_Iterator &right) const noexcept
+	{
+		return static_cast<difference_type>(index) - static_cast<difference_type>(right.index);
+	}
+
+	NODISCARD bool operator==(const JBitVector_Const_Iterator &right) const noexcept
+	{
+		return index == right.index;
+	}
+
+	NODISCARD bool operator!=(const JBitVector_Const_Iterator &right) const noexcept
+	{
+		return index != right.index;
+	}
+
+	NODISCARD bool operator<(const JBitVector_Const_Iterator &right) const noexcept
+	{
+		return index < right.index;
+	}
+
+	NODISCARD bool operator>(const JBitVector_Const_Iterator &right) const noexcept
+	{
+		return index > right.index;
+	}
+
+	NODISCARD bool operator<=(const JBitVector_Const_Iterator &right) const noexcept
+	{
+		return index <= right.index;
+	}
+
+	NODISCARD bool operator>=(const JBitVector_Const_Iterator &right) const noexcept
+	{
+		return index >= right.index;
+	}
+};
+
+template <class MyVector>
+class JBitVector_Iterator : public JBitVector_Const_Iterator<MyVector>
+{
+public:
+	using my_base           = JBitVector_Const_Iterator<MyVector>;
+
+	using iterator_category = _STD random_access_iterator_tag;
+	using value_type        = bool;
+	using difference_type   = typename MyVector::difference_type;
+	using pointer           = void;
+	using reference         = JBitVector_Reference;
+
+	using my_base::my_base;
+
+	reference operator*() const noexcept
+	{
+		return (*this->vec)[this->index];
+	}
+
+	reference operator[](const difference_type off) const noexcept
+	{
+		return (*this->vec)[this->index + off];
+	}
+
+	JBitVector_Iterator& operator++() noexcept
+	{
+		my_base::operator++();
+		return *this;
+	}
+
+	JBitVector_Iterator operator++(int) noexcept
+	{
+		JBitVector_Iterator temp = *this;
+		my_base::operator++();
+		return temp;
+	}
+
+	JBitVector_Iterator& operator--() noexcept
+	{
+		my_base::operator--();
+		return *this;
+	}
+
+	JBitVector_Iterator operator--(int) noexcept
+	{
+		JBitVector_Iterator temp = *this;
+		my_base::operator--();
+		return temp;
+	}
+
+	JBitVector_Iterator& operator+=(const difference_type off) noexcept
+	{
+		my_base::operator+=(off);
+		return *this;
+	}
+
+	JBitVector_Iterator& operator-=(const difference_type off) noexcept
+	{
+		my_base::operator-=(off);
+		return *this;
+	}
+
+	NODISCARD JBitVector_Iterator operator+(const difference_type off) const noexcept
+	{
+		return JBitVector_Iterator(this->vec, this->index + off);
+	}
+
+	NODISCARD friend JBitVector_Iterator operator+(const difference_type off, const JBitVector_Iterator &iter) noexcept
+	{
+		return iter + off;
+	}
+
+	NODISCARD JBitVector_Iterator operator-(const difference_type off) const noexcept
+	{
+		return JBitVector_Iterator(this->vec, this->index - off);
+	}
+
+	using my_base::operator-;
+};
+
+// A vector of bits packed 64 to a word, held in a JVector of words, so it grows like one.
+// The bits past size() in the last word are always zero, which lets count(), the searches and comparisons
+// work a word at a time. count() uses POPCNT where the CPU has it, the searches TZCNT.
+template <class Alloc = _STD allocator<_STD uint64_t>>
+class JBitVector
+{
+public:
+	using word_type              = _STD uint64_t;
+	using value_type             = bool;
+	using allocator_type         = Alloc;
+	using reference              = JBitVector_Reference;
+	using const_reference        = bool;
+	using size_type              = _STD size_t;
+	using difference_type        = _STD ptrdiff_t;
+	using iterator               = JBitVector_Iterator<JBitVector<Alloc>>;
+	using const_iterator         = JBitVector_Const_Iterator<JBitVector<Alloc>>;
+	using reverse_iterator       = _STD reverse_iterator<iterator>;
+	using const_reverse_iterator = _STD reverse_iterator<const_iterator>;
+
+	static constexpr size_type word_bits = 64;
+	static constexpr size_type npos      = static_cast<size_type>(-1);
+
+private:
+	using words_type = JVector<word_type, typename _STD allocator_traits<Alloc>::template rebind_alloc<word_type>>;
+
+	words_type m_words;
+	size_type  m_size;
+
+	NODISCARD static size_type words_for(const size_type bits) noexcept;
+
+	NODISCARD static word_type bit_mask(const size_type pos) noexcept;
+
+	// Zeroes the bits past size() in the last word.
+	void clear_tail() noexcept;
+
+	// First set bit at or after pos.
+	NODISCARD size_type find_from(const size_type pos) const noexcept;
+
+public:
+	JBitVector() noexcept(_STD is_nothrow_default_constructible_v<words_type>);
+
+	explicit JBitVector(const Alloc &al) noexcept;
+
+	explicit JBitVector(const size_type count, const bool value = false, const Alloc &al = Alloc());
+
+	JBitVector(_STD initializer_list<bool> init, const Alloc &al = Alloc());
+
+	NODISCARD allocator_type get_allocator() const noexcept;
+
+	NODISCARD reference operator[](const size_type pos) noexcept;
+
+	NODISCARD const_reference operator[](const size_type pos) const noexcept;
+
+	NODISCARD reference at(const size_type pos);
+
+	NODISCARD const_reference at(const size_type pos) const;
+
+	NODISCARD bool test(const size_type pos) const noexcept;
+
+	void set(const size_type pos, const bool value = true) noexcept;
+
+	void reset(const size_type pos) noexcept;
+
+	void flip(const size_type pos) noexcept;
+
+	// The whole vector, a word at a time.
+	void set() noexcept;
+
+	void reset() noexcept;
+
+	void flip() noexcept;
+
+	NODISCARD reference front() noexcept;
+
+	NODISCARD const_reference front() const noexcept;
+
+	NODISCARD reference back() noexcept;
+
+	NODISCARD const_reference back() const noexcept;
+
+	// The packed words, bit i in bit i % 64 of word i / 64.
+	NODISCARD const word_type* data() const noexcept;
+
+	NODISCARD size_type word_count() const noexcept;
+
+	NODISCARD iterator begin() noexcept;
+
+	NODISCARD const_iterator begin() const noexcept;
+
+	NODISCARD iterator end() noexcept;
+
+	NODISCARD const_iterator end() const noexcept;
+
+	NODISCARD reverse_iterator rbegin() noexcept;
+
+	NODISCARD const_reverse_iterator rbegin() const noexcept;
+
+	NODISCARD reverse_iterator rend() noexcept;
+
+	NODISCARD const_reverse_iterator rend() const noexcept;
+
+	NODISCARD const_iterator cbegin() const noexcept;
+
+	NODISCARD const_iterator cend() const noexcept;
+
+	NODISCARD bool empty() const noexcept;
+
+	NODISCARD size_type size() const noexcept;
+
+	NODISCARD size_type max_size() const noexcept;
+
+	NODISCARD size_type capacity() const noexcept;
+
+	void reserve(const size_type new_cap);
+
+	void shrink_to_fit();
+
+	void clear() noexcept;
+
+	void push_back(const bool value);
+
+	void pop_back() noexcept;
+
+	// New bits are value, filled a word at a time.
+	void resize(const size_type count, const bool value = false);
+
+	// Number of set bits.
+	NODISCARD size_type count() const noexcept;
+
+	NODISCARD bool any() const noexcept;
+
+	NODISCARD bool none() const noexcept;
+
+	NODISCARD bool all() const noexcept;
+
+	// Index of the first set bit, or npos.
+	NODISCARD size_type find_first() const noexcept;
+
+	// Index of the first set bit after pos, or npos.
+	NODISCARD size_type find_next(const size_type pos) const noexcept;
+
+	// Both vectors must have the same size.
+	JBitVector& operator&=(const JBitVector &other) noexcept;
+
+	JBitVector& operator|=(const JBitVector &other) noexcept;
+
+	JBitVector& operator^=(const JBitVector &other) noexcept;
+
+	NODISCARD JBitVector operator~() const;
+
+	void swap(JBitVector &other) noexcept;
+
+	NODISCARD bool operator==(const JBitVector &other) const noexcept;
+
+	NODISCARD bool operator!=(const JBitVector &other) const noexcept;
+};
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::size_type
+JBitVector<Alloc>::words_for(const size_type bits) noexcept
+{
+	return bits / word_bits + (bits % word_bits != 0);
+}
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::word_type
+JBitVector<Alloc>::bit_mask(const size_type pos) noexcept
+{
+	return static_cast<word_type>(1) << (pos % word_bits);
+}
+
+template <class Alloc>
+inline void
+JBitVector<Alloc>::clear_tail() noexcept
+{
+	if (m_size % word_bits != 0)
+	{
+		m_words.back() &= bit_mask(m_size) - 1;
+	}
+}
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::size_type
+JBitVector<Alloc>::find_from(const size_type pos) const noexcept
+{
+	if (pos >= m_size)
+	{
+		return npos;
+	}
+
+	const word_type *words = m_words.data();
+	size_type index        = pos / word_bits;
+
+	// The first word without the bits below pos, then whole words.
+	word_type word = words[index] & ~(bit_mask(pos) - 1);
+
+	while (word == 0)
+	{
+		if (++index == m_words.size())
+		{
+			return npos;
+		}
+
+		word = words[index];
+	}
+
+	return index * word_bits + JSTD::trailing_zeros(word);
+}
+
+template <class Alloc>
+inline
+JBitVector<Alloc>::JBitVector() noexcept(_STD is_nothrow_default_constructible_v<words_type>)
+	: m_words(),
+	  m_size(0)
+	{}
+
+template <class Alloc>
+inline
+JBitVector<Alloc>::JBitVector(const Alloc &al) noexcept
+	: m_words(typename words_type::allocator_type(al)),
+	  m_size(0)
+	{}
+
+template <class Alloc>
+inline
+JBitVector<Alloc>::JBitVector(const size_type count, const bool value, const Alloc &al)
+	: m_words(words_for(count), value ? ~word_type(0) : word_type(0), typename words_type::allocator_type(al)),
+	  m_size(count)
+{
+	clear_tail();
+}
+
+template <class Alloc>
+inline
+JBitVector<Alloc>::JBitVector(_STD initializer_list<bool> init, const Alloc &al)
+	: JBitVector(init.size(), false, al)
+{
+	size_type pos = 0;
+
+	for (const bool value : init)
+	{
+		set(pos++, value);
+	}
+}
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::allocator_type
+JBitVector<Alloc>::get_allocator() const noexcept
+{
+	return static_cast<allocator_type>(m_words.get_allocator());
+}
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::reference
+JBitVector<Alloc>::operator[](const size_type pos) noexcept
+{
+	return reference(m_words.data() + pos / word_bits, bit_mask(pos));
+}
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::const_reference
+JBitVector<Alloc>::operator[](const size_type pos) const noexcept
+{
+	return test(pos);
+}
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::reference
+JBitVector<Alloc>::at(const size_type pos)
+{
+	if (pos >= m_size)
+	{
+		throw _STD out_of_range("Index out of range.");
+	}
+
+	return (*this)[pos];
+}
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::const_reference
+JBitVector<Alloc>::at(const size_type pos) const
+{
+	if (pos >= m_size)
+	{
+		throw _STD out_of_range("Index out of range.");
+	}
+
+	return test(pos);
+}
+
+template <class Alloc>
+inline bool
+JBitVector<Alloc>::test(const size_type pos) const noexcept
+{
+	return (m_words.data()[pos / word_bits] & bit_mask(pos)) != 0;
+}
+
+template <class Alloc>
+inline void
+JBitVector<Alloc>::set(const size_type pos, const bool value) noexcept
+{
+	(*this)[pos] = value;
+}
+
+template <class Alloc>
+inline void
+JBitVector<Alloc>::reset(const size_type pos) noexcept
+{
+	m_words.data()[pos / word_bits] &= ~bit_mask(pos);
+}
+
+template <class Alloc>
+inline void
+JBitVector<Alloc>::flip(const size_type pos) noexcept
+{
+	m_words.data()[pos / word_bits] ^= bit_mask(pos);
+}
+
+template <class Alloc>
+inline void
+JBitVector<Alloc>::set() noexcept
+{
+	_STD fill(m_words.begin(), m_words.end(), ~word_type(0));
+	clear_tail();
+}
+
+template <class Alloc>
+inline void
+JBitVector<Alloc>::reset() noexcept
+{
+	_STD fill(m_words.begin(), m_words.end(), word_type(0));
+}
+
+template <class Alloc>
+inline void
+JBitVector<Alloc>::flip() noexcept
+{
+	for (word_type &word : m_words)
+	{
+		word = ~word;
+	}
+
+	clear_tail();
+}
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::reference
+JBitVector<Alloc>::front() noexcept
+{
+	return (*this)[0];
+}
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::const_reference
+JBitVector<Alloc>::front() const noexcept
+{
+	return test(0);
+}
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::reference
+JBitVector<Alloc>::back() noexcept
+{
+	return (*this)[m_size - 1];
+}
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::const_reference
+JBitVector<Alloc>::back() const noexcept
+{
+	return test(m_size - 1);
+}
+
+template <class Alloc>
+inline const typename JBitVector<Alloc>::word_type*
+JBitVector<Alloc>::data() const noexcept
+{
+	return m_words.data();
+}
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::size_type
+JBitVector<Alloc>::word_count() const noexcept
+{
+	return m_words.size();
+}
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::iterator
+JBitVector<Alloc>::begin() noexcept
+{
+	return iterator(this, 0);
+}
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::const_iterator
+JBitVector<Alloc>::begin() const noexcept
+{
+	// Const iterators only read through the pointer, so both iterators can share it and convert.
+	return const_iterator(const_cast<JBitVector*>(this), 0);
+}
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::iterator
+JBitVector<Alloc>::end() noexcept
+{
+	return iterator(this, m_size);
+}
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::const_iterator
+JBitVector<Alloc>::end() const noexcept
+{
+	return const_iterator(const_cast<JBitVector*>(this), m_size);
+}
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::reverse_iterator
+JBitVector<Alloc>::rbegin() noexcept
+{
+	return reverse_iterator(end());
+}
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::const_reverse_iterator
+JBitVector<Alloc>::rbegin() const noexcept
+{
+	return const_reverse_iterator(end());
+}
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::reverse_iterator
+JBitVector<Alloc>::rend() noexcept
+{
+	return reverse_iterator(begin());
+}
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::const_reverse_iterator
+JBitVector<Alloc>::rend() const noexcept
+{
+	return const_reverse_iterator(begin());
+}
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::const_iterator
+JBitVector<Alloc>::cbegin() const noexcept
+{
+	return begin();
+}
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::const_iterator
+JBitVector<Alloc>::cend() const noexcept
+{
+	return end();
+}
+
+template <class Alloc>
+inline bool
+JBitVector<Alloc>::empty() const noexcept
+{
+	return m_size == 0;
+}
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::size_type
+JBitVector<Alloc>::size() const noexcept
+{
+	return m_size;
+}
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::size_type
+JBitVector<Alloc>::max_size() const noexcept
+{
+	const size_type words = m_words.max_size();
+	return words > npos / word_bits ? npos - 1 : words * word_bits;
+}
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::size_type
+JBitVector<Alloc>::capacity() const noexcept
+{
+	return m_words.capacity() * word_bits;
+}
+
+template <class Alloc>
+inline void
+JBitVector<Alloc>::reserve(const size_type new_cap)
+{
+	m_words.reserve(words_for(new_cap));
+}
+
+template <class Alloc>
+inline void
+JBitVector<Alloc>::shrink_to_fit()
+{
+	m_words.shrink_to_fit();
+}
+
+template <class Alloc>
+inline void
+JBitVector<Alloc>::clear() noexcept
+{
+	m_words.clear();
+	m_size = 0;
+}
+
+template <class Alloc>
+inline void
+JBitVector<Alloc>::push_back(const bool value)
+{
+	if (m_size % word_bits == 0)
+	{
+		m_words.push_back(value ? word_type(1) : word_type(0));
+	}
+	else if (value)
+	{
+		m_words.back() |= bit_mask(m_size);
+	}
+
+	++m_size;
+}
+
+template <class Alloc>
+inline void
+JBitVector<Alloc>::pop_back() noexcept
+{
+	--m_size;
+
+	if (m_size % word_bits == 0)
+	{
+		m_words.pop_back();
+	}
+	else
+	{
+		reset(m_size);
+	}
+}
+
+template <class Alloc>
+inline void
+JBitVector<Alloc>::resize(const size_type count, const bool value)
+{
+	if (count > m_size && value && m_size % word_bits != 0)
+	{
+		// The rest of the last word, the new words are filled whole.
+		m_words.back() |= ~(bit_mask(m_size) - 1);
+	}
+
+	m_words.resize(words_for(count), value ? ~word_type(0) : word_type(0));
+	m_size = count;
+	clear_tail();
+}
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::size_type
+JBitVector<Alloc>::count() const noexcept
+{
+	return JSTD::popcount_words(m_words.data(), m_words.size());
+}
+
+template <class Alloc>
+inline bool
+JBitVector<Alloc>::any() const noexcept
+{
+	return _STD any_of(m_words.begin(), m_words.end(), [](const word_type word) { return word != 0; });
+}
+
+template <class Alloc>
+inline bool
+JBitVector<Alloc>::none() const noexcept
+{
+	return !any();
+}
+
+template <class Alloc>
+inline bool
+JBitVector<Alloc>::all() const noexcept
+{
+	const size_type full = m_size / word_bits;
+	const word_type *words = m_words.data();
+
+	for (size_type index = 0; index < full; ++index)
+	{
+		if (words[index] != ~word_type(0))
+		{
+			return false;
+		}
+	}
+
+	return m_size % word_bits == 0 || words[full] == bit_mask(m_size) - 1;
+}
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::size_type
+JBitVector<Alloc>::find_first() const noexcept
+{
+	return find_from(0);
+}
+
+template <class Alloc>
+inline typename JBitVector<Alloc>::size_type
+JBitVector<Alloc>::find_next(const size_type pos) const noexcept
+{
+	return pos == npos ? npos : find_from(pos + 1);
+}
+
+template <class Alloc>
+inline JBitVector<Alloc>&
+JBitVector<Alloc>::operator&=(const JBitVector &other) noexcept
+{
+	assert(m_size == other.m_size);
+
+	word_type *words        = m_words.data();
+	const word_type *others = other.m_words.data();
+
+	for (size_type index = 0, count = m_words.size(); index < count; ++index)
+	{
+		words[index] &= others[index];
+	}
+
+	return *this;
+}
+
+template <class Alloc>
+inline JBitVector<Alloc>&
+JBitVector<Alloc>::operator|=(const JBitVector &other) noexcept
+{
+	assert(m_size == other.m_size);
+
+	word_type *words        = m_words.data();
+	const word_type *others = other.m_words.data();
+
+	for (size_type index = 0, count = m_words.size(); index < count; ++index)
+	{
+		words[index] |= others[index];
+	}
+
+	return *this;
+}
+
+template <class Alloc>
+inline JBitVector<Alloc>&
+JBitVector<Alloc>::operator^=(const JBitVector &other) noexcept
+{
+	assert(m_size == other.m_size);
+
+	word_type *words        = m_words.data();
+	const word_type *others = other.m_words.data();
+
+	for (size_type index = 0, count = m_words.size(); index < count; ++index)
+	{
+		words[index] ^= others[index];
+	}
+
+	return *this;
+}
+
+template <class Alloc>
+inline JBitVector<Alloc>
+JBitVector<Alloc>::operator~() const
+{
+	JBitVector result(*this);
+	result.flip();
+	return result;
+}
+
+template <class Alloc>
+inline void
+JBitVector<Alloc>::swap(JBitVector &other) noexcept
+{
+	m_words.swap(other.m_words);
+	_STD swap(m_size, other.m_size);
+}
+
+template <class Alloc>
+inline bool
+JBitVector<Alloc>::operator==(const JBitVector &other) const noexcept
+{
+	return m_size == other.m_size && _STD equal(m_words.begin(), m_words.end(), other.m_words.begin());
+}
+
+template <class Alloc>
+inline bool
+JBitVector<Alloc>::operator!=(const JBitVector &other) const noexcept
+{
+	return !(*this == other);
+}
+
+template <class Alloc>
+NODISCARD JBitVector<Alloc>
+operator&(JBitVector<Alloc> left, const JBitVector<Alloc> &right)
+{
+	left &= right;
+	return left;
+}
+
+template <class Alloc>
+NODISCARD JBitVector<Alloc>
+operator|(JBitVector<Alloc> left, const JBitVector<Alloc> &right)
+{
+	left |= right;
+	return left;
+}
+
+template <class Alloc>
+NODISCARD JBitVector<Alloc>
+operator^(JBitVector<Alloc> left, const JBitVector<Alloc> &right)
+{
+	left ^= right;
+	return left;
+}
+
+template <class Alloc>
+void
+swap(JBitVector<Alloc> &left, JBitVector<Alloc> &right) noexcept
+{
+	left.swap(right);
+}
+
+#endif // !_JBITVECTOR_
@@ -0,0 +1,859 @@
+#pragma once
+#ifndef _JCONCURRENTVECTOR_
+#define _JCONCURRENTVECTOR_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "JVector.h"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif // _MSC_VER
+
+// JConcurrentVector random access iterator. It refers to the vector and an index, the elements are not contiguous.
+template <class MyVector>
+class JConcurrentVector_Const_Iterator
+{
+public:
+	using iterator_category = _STD random_access_iterator_tag;
+	using value_type        = typename MyVector::value_type;
+	using difference_type   = typename MyVector::difference_type;
+	using pointer           = typename MyVector::const_pointer;
+	using reference         = const value_type&;
+
+	MyVector    *vec;
+	_STD size_t index;
+
+	JConcurrentVector_Const_Iterator() noexcept
+		: vec(nullptr),
+		  index(0)
+		{}
+
+	JConcurrentVector_Const_Iterator(MyVector *vector, const _STD size_t pos) noexcept
+		: vec(vector),
+		  index(pos)
+		{}
+
+	reference operator*() const noexcept
+	{
+		return _STD as_const(*vec)[index];
+	}
+
+	pointer operator->() const noexcept
+	{
+		return _STD addressof(_STD as_const(*vec)[index]);
+	}
+
+	reference operator[](const difference_type off) const noexcept
+	{
+		return _STD as_const(*vec)[index + off];
+	}
+
+	JConcurrentVector_Const_Iterator& operator++() noexcept
+	{
+		++index;
+		return *this;
+	}
+
+	JConcurrentVector_Const_Iterator operator++(int) noexcept
+	{
+		JConcurrentVector_Const_Iterator temp = *this;
+		++index;
+		return temp;
+	}
+
+	JConcurrentVector_Const_Iterator& operator--() noexcept
+	{
+		--index;
+		return *this;
+	}
+
+	JConcurrentVector_Const_Iterator operator--(int) noexcept
+	{
+		JConcurrentVector_Const_Iterator temp = *this;
+		--index;
+		return temp;
+	}
+
+	JConcurrentVector_Const_Iterator& operator+=(const difference_type off) noexcept
+	{
+		index += off;
+		return *this;
+	}
+
+	JConcurrentVector_Const_Iterator& operator-=(const difference_type off) noexcept
+	{
+		index -= off;
+		return *this;
+	}
+
+	NODISCARD JConcurrentVector_Const_Iterator operator+(const difference_type off) const noexcept
+	{
+		return JConcurrentVector_Const_Iterator(vec, index + off);
+	}
+
+	NODISCARD friend JConcurrentVector_Const_Iterator operator+(const difference_type off,
+		const JConcurrentVector_Const_Iterator &iter) noexcept
+	{
+		return iter + off;
+	}
+
+	NODISCARD JConcurrentVector_Const_Iterator operator-(const difference_type off) const noexcept
+	{
+		return JConcurrentVector_Const_Iterator(vec, index - off);
+	}
+
+	NODISCARD difference_type operator-(const JConcurrentVector_Const_Iterator &right) const noexcept
+	{
+		return static_cast<difference_type>(index) - static_cast<difference_type>(right.index);
+	}
+
+	NODISCARD bool operator==(const JConcurrentVector_Const_Iterator &right) const noexcept
+	{
+		return index == right.index;
+	}
+
+	NODISCARD bool operator!=(const JConcurrentVector_Const_Iterator &right) const noexcept
+	{
+		return index != right.index;
+	}
+
+	NODISCARD bool operator<(const JConcurrentVector_Const_Iterator &right) const noexcept
+	{
+		return index < right.index;
+	}
+
+	NODISCARD bool operator>(const JConcurrentVector_Const_Iterator &right) const noexcept
+	{
+		return index > right.index;
+	}
+
+	NODISCARD bool operator<=(const JConcurrentVector_Const_Iterator &right) const noexcept
+	{
+		return index <= right.index;
+	}
+
+	NODISCARD bool operator>=(const JConcurrentVector_Const_Iterator &right) const noexcept
+	{
+		return index >= right.index;
+	}
+};
+
+template <class MyVector>
+class JConcurrentVector_Iterator : public JConcurrentVector_Const_Iterator<MyVector>
+{
+public:
+	using my_base           = JConcurrentVector_Const_Iterator<MyVector>;
+
+	using iterator_category = _STD random_access_iterator_tag;
+	using value_type        = typename MyVector::value_type;
+	using difference_type   = typename MyVector::difference_type;
+	using pointer           = typename MyVector::pointer;
+	using reference         = value_type&;
+
+	using my_base::my_base;
+
+	reference operator*() const noexcept
+	{
+		return (*this->vec)[this->index];
+	}
+
+	pointer operator->() const noexcept
+	{
+		return _STD addressof((*this->vec)[this->index]);
+	}
+
+	reference operator[](const difference_type off) const noexcept
+	{
+		return (*this->vec)[this->index + off];
+	}
+
+	JConcurrentVector_Iterator& operator++() noexcept
+	{
+		my_base::operator++();
+		return *this;
+	}
+
+	JConcurrentVector_Iterator operator++(int) noexcept
+	{
+		JConcurrentVector_Iterator temp = *this;
+		my_base::operator++();
+		return temp;
+	}
+
+	JConcurrentVector_Iterator& operator--() noexcept
+	{
+		my_base::operator--();
+		return *this;
+	}
+
+	JConcurrentVector_Iterator operator--(int) noexcept
+	{
+		JConcurrentVector_Iterator temp = *this;
+		my_base::operator--();
+		return temp;
+	}
+
+	JConcurrentVector_Iterator& operator+=(const difference_type off) noexcept
+	{
+		my_base::operator+=(off);
+		return *this;
+	}
+
+	JConcurrentVector_Iterator& operator-=(const difference_type off) noexcept
+	{
+		my_base::operator-=(off);
+		return *this;
+	}
+
+	NODISCARD JConcurrentVector_Iterator operator+(const difference_type off) const noexcept
+	{
+		return JConcurrentVector_Iterator(this->vec, this->index + off);
+	}
+
+	NODISCARD friend JConcurrentVector_Iterator operator+(const difference_type off,
+		const JConcurrentVector_Iterator &iter) noexcept
+	{
+		return iter + off;
+	}
+
+	NODISCARD JConcurrentVector_Iterator operator-(const difference_type off) const noexcept
+	{
+		return JConcurrentVector_Iterator(this->vec, this->index - off);
+	}
+
+	using my_base::operator-;
+};
+
+// A vector that many threads may append to and read from at once, without a lock.
+// Elements live in segments of 32, 64, 128, ... elements that are never moved or freed while the vector lives,
+// so references and indices stay valid as it grows. An append reserves an index with one atomic increment, constructs
+// the element in place and marks it ready; size() counts the elements ready without a gap, so every index below it
+// can be read. If a segment cannot be allocated for an index already reserved, the vector ends there: size() stops
+// below that index and every later append throws bad_alloc, until clear().
+// Clearing, freezing and destroying the vector must not overlap other calls.
+// The allocator is called from several threads at once.
+template <class T, class Alloc = _STD allocator<T>>
+class JConcurrentVector
+	: private JVector_Alloc_Holder<typename _STD allocator_traits<Alloc>::template rebind_alloc<T>>
+{
+private:
+	using alty              = typename _STD allocator_traits<Alloc>::template rebind_alloc<T>;
+	using alty_traits       = _STD allocator_traits<alty>;
+	using flag_type         = _STD atomic<unsigned char>;
+	using flag_alloc        = typename _STD allocator_traits<Alloc>::template rebind_alloc<flag_type>;
+	using flag_alloc_traits = _STD allocator_traits<flag_alloc>;
+	using my_base           = JVector_Alloc_Holder<alty>;
+
+	static_assert(_STD is_same_v<typename alty_traits::pointer, T*>,
+		"JConcurrentVector requires an allocator whose pointer type is T*.");
+
+	// The first segment holds 2^first_bits elements, each next one twice as many.
+	static constexpr _STD size_t first_bits = 5;
+	static constexpr _STD size_t segments   = 64 - first_bits;
+
+public:
+	using value_type      = T;
+	using allocator_type  = Alloc;
+	using pointer         = T*;
+	using const_pointer   = const T*;
+	using reference       = value_type&;
+	using const_reference = const value_type&;
+	using size_type       = _STD size_t;
+	using difference_type = _STD ptrdiff_t;
+	using iterator        = JConcurrentVector_Iterator<JConcurrentVector<T, Alloc>>;
+	using const_iterator  = JConcurrentVector_Const_Iterator<JConcurrentVector<T, Alloc>>;
+
+private:
+	NODISCARD static size_type floor_log2(const _STD uint64_t value) noexcept;
+
+	NODISCARD static size_type segment_of(const size_type index) noexcept;
+
+	NODISCARD static size_type segment_start(const size_type segment) noexcept;
+
+	NODISCARD static size_type segment_size(const size_type segment) noexcept;
+
+	pointer acquire_segment(const size_type segment);
+
+	pointer acquire_reserved_segment(const size_type segment);
+
+	void publish(const size_type index) noexcept;
+
+	void destroy_all() noexcept;
+
+public:
+	JConcurrentVector() noexcept(_STD is_nothrow_default_constructible_v<alty>);
+
+	explicit JConcurrentVector(const Alloc &al) noexcept;
+
+	JConcurrentVector(const JConcurrentVector&) = delete;
+
+	JConcurrentVector& operator=(const JConcurrentVector&) = delete;
+
+	~JConcurrentVector() noexcept;
+
+	NODISCARD allocator_type get_allocator() const noexcept;
+
+	// Returns a reference to the new element, valid for the life of the vector. Throws bad_alloc without appending if
+	// its segment cannot be allocated.
+	template <class... Args>
+	reference emplace_back(Args&&... args);
+
+	reference push_back(const T &value);
+
+	reference push_back(T &&value);
+
+	// Allocates the segments for count elements ahead of the appends.
+	void reserve(const size_type count);
+
+	NODISCARD reference operator[](const size_type pos) noexcept;
+
+	NODISCARD const_reference operator[](const size_type pos) const noexcept;
+
+	NODISCARD reference at(const size_type pos);
+
+	NODISCARD const_reference at(const size_type pos) const;
+
+	// Elements below size() are constructed and may be read while appends go on.
+	NODISCARD size_type size() const noexcept;
+
+	NODISCARD bool empty() const noexcept;
+
+	NODISCARD size_type capacity() const noexcept;
+
+	NODISCARD size_type max_size() const noexcept;
+
+	// Iterators cover the elements published when end() was called.
+	NODISCARD iterator begin() noexcept;
+
+	NODISCARD const_iterator begin() const noexcept;
+
+	NODISCARD iterator end() noexcept;
+
+	NODISCARD const_iterator end() const noexcept;
+
+	NODISCARD const_iterator cbegin() const noexcept;
+
+	NODISCARD const_iterator cend() const noexcept;
+
+	// Destroys the elements and keeps the segments. Not safe while other threads use the vector.
+	void clear() noexcept;
+
+	// Copies the elements into one contiguous JVector.
+	NODISCARD JVector<T, Alloc> freeze() const &;
+
+	// Moves the elements into one contiguous JVector and leaves this vector empty. Not safe while others use it.
+	NODISCARD JVector<T, Alloc> freeze() &&;
+
+private:
+	_STD atomic<pointer>                m_segments[segments];
+	_STD atomic<flag_type*>             m_ready[segments];
+	// The first segment that could not be allocated for a reserved index, segments if none.
+	_STD atomic<size_type>              m_failed;
+	alignas(64) _STD atomic<size_type>  m_reserved;
+	alignas(64) _STD atomic<size_type>  m_size;
+};
+
+template <class T, class Alloc>
+inline typename JConcurrentVector<T, Alloc>::size_type
+JConcurrentVector<T, Alloc>::floor_log2(const _STD uint64_t value) noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+	unsigned long index;
+	_BitScanReverse64(&index, value);
+	return static_cast<size_type>(index);
+#else
+	return static_cast<size_type>(63 - __builtin_clzll(value));
+#endif // _MSC_VER
+}
+
+template <class T, class Alloc>
+inline typename JConcurrentVector<T, Alloc>::size_type
+JConcurrentVector<T, Alloc>::segment_of(const size_type index) noexcept
+{
+	return floor_log2((index >> first_bits) + 1);
+}
+
+template <class T, class Alloc>
+inline typename JConcurrentVector<T, Alloc>::size_type
+JConcurrentVector<T, Alloc>::segment_start(const size_type segment) noexcept
+{
+	return ((static_cast<size_type>(1) << segment) - 1) << first_bits;
+}
+
+template <class T, class Alloc>
+inline typename JConcurrentVector<T, Alloc>::size_type
+JConcurrentVector<T, Alloc>::segment_size(const size_type segment) noexcept
+{
+	return static_cast<size_type>(1) << (segment + first_bits);
+}
+
+template <class T, class Alloc>
+inline typename JConcurrentVector<T, Alloc>::pointer
+JConcurrentVector<T, Alloc>::acquire_segment(const size_type segment)
+{
+	// Threads reaching a missing segment race to install one, the losers free theirs.
+	if (m_ready[segment].load(_STD memory_order_acquire) == nullptr)
+	{
+		flag_alloc flag_al(this->get_al());
+		flag_type *flags = flag_alloc_traits::allocate(flag_al, segment_size(segment));
+
+		for (size_type i = 0; i < segment_size(segment); ++i)
+		{
+			::new (static_cast<void*>(flags + i)) flag_type(0);
+		}
+
+		flag_type *expected = nullptr;
+
+		if (!m_ready[segment].compare_exchange_strong(expected, flags, _STD memory_order_acq_rel))
+		{
+			flag_alloc_traits::deallocate(flag_al, flags, segment_size(segment));
+		}
+	}
+
+	pointer data = m_segments[segment].load(_STD memory_order_acquire);
+
+	if (data == nullptr)
+	{
+		pointer fresh = alty_traits::allocate(this->get_al(), segment_size(segment));
+
+		if (m_segments[segment].compare_exchange_strong(data, fresh, _STD memory_order_acq_rel))
+		{
+			data = fresh;
+		}
+		else
+		{
+			alty_traits::deallocate(this->get_al(), fresh, segment_size(segment));
+		}
+	}
+
+	return data;
+}
+
+template <class T, class Alloc>
+inline typename JConcurrentVector<T, Alloc>::pointer
+JConcurrentVector<T, Alloc>::acquire_reserved_segment(const size_type segment)
+{
+	// The caller holds an index it cannot give back, so the allocation is retried once. If that fails too, the segment
+	// is marked failed: the index is never published, so size() stops below it, and later appends there and past it
+	// throw instead of leaving more gaps.
+	try
+	{
+		return acquire_segment(segment);
+	}
+	catch (...)
+	{
+	}
+
+	try
+	{
+		return acquire_segment(segment);
+	}
+	catch (...)
+	{
+		size_type failed = m_failed.load(_STD memory_order_relaxed);
+
+		while (segment < failed && !m_failed.compare_exchange_weak(failed, segment, _STD memory_order_release))
+		{
+		}
+
+		throw;
+	}
+}
+
+template <class T, class Alloc>
+inline void
+JConcurrentVector<T, Alloc>::publish(const size_type index) noexcept
+{
+	// The element next in line moves size() past itself directly. Any other is marked ready, and size() is moved over
+	// every ready element that follows, so whichever thread finishes the element at size() last carries it forward
+	// and no thread waits for another. Sequentially consistent so that of two neighbours finishing at once,
+	// at least one sees the other's flag.
+	size_type size = index;
+
+	if (m_size.load(_STD memory_order_relaxed) == index && m_size.compare_exchange_strong(size, index + 1))
+	{
+		size = index + 1;
+	}
+	else
+	{
+		const size_type segment = segment_of(index);
+		m_ready[segment].load(_STD memory_order_acquire)[index - segment_start(segment)].store(1);
+		size = m_size.load();
+	}
+
+	while (size < m_reserved.load())
+	{
+		const size_type next_segment = segment_of(size);
+		flag_type *flags             = m_ready[next_segment].load();
+
+		if (flags == nullptr || flags[size - segment_start(next_segment)].load() == 0)
+		{
+			break;
+		}
+
+		// On failure size holds the newer value, which some other thread has moved past.
+		if (m_size.compare_exchange_weak(size, size + 1))
+		{
+			++size;
+		}
+	}
+}
+
+template <class T, class Alloc>
+inline void
+JConcurrentVector<T, Alloc>::destroy_all() noexcept
+{
+	// Past size() only a failed segment leaves elements, published out of order and marked ready.
+	const size_type count    = m_size.load(_STD memory_order_relaxed);
+	const size_type reserved = (_STD min)(m_reserved.load(_STD memory_order_relaxed), max_size());
+
+	for (size_type segment = 0; segment < segments && segment_start(segment) < reserved; ++segment)
+	{
+		pointer data     = m_segments[segment].load(_STD memory_order_relaxed);
+		flag_type *flags = m_ready[segment].load(_STD memory_order_relaxed);
+
+		if (data == nullptr || flags == nullptr)
+		{
+			continue;
+		}
+
+		const size_type start = segment_start(segment);
+		const size_type end   = (_STD min)(reserved, start + segment_size(segment));
+
+		for (size_type index = start; index < end; ++index)
+		{
+			flag_type &ready = flags[index - start];
+
+			if (index < count || ready.load(_STD memory_order_relaxed) != 0)
+			{
+				if constexpr (!_STD is_trivially_destructible_v<value_type>)
+				{
+					alty_traits::destroy(this->get_al(), data + (index - start));
+				}
+			}
+
+			ready.store(0, _STD memory_order_relaxed);
+		}
+	}
+
+	m_size.store(0, _STD memory_order_relaxed);
+	m_reserved.store(0, _STD memory_order_relaxed);
+	m_failed.store(segments, _STD memory_order_relaxed);
+}
+
+template <class T, class Alloc>
+inline
+JConcurrentVector<T, Alloc>::JConcurrentVector() noexcept(_STD is_nothrow_default_constructible_v<alty>)
+	: my_base(),
+	  m_segments{},
+	  m_ready{},
+	  m_failed(segments),
+	  m_reserved(0),
+	  m_size(0)
+	{}
+
+template <class T, class Alloc>
+inline
+JConcurrentVector<T, Alloc>::JConcurrentVector(const Alloc &al) noexcept
+	: my_base(al),
+	  m_segments{},
+	  m_ready{},
+	  m_failed(segments),
+	  m_reserved(0),
+	  m_size(0)
+	{}
+
+template <class T, class Alloc>
+inline
+JConcurrentVector<T, Alloc>::~JConcurrentVector() noexcept
+{
+	destroy_all();
+
+	flag_alloc flag_al(this->get_al());
+
+	for (size_type segment = 0; segment < segments; ++segment)
+	{
+		if (pointer data = m_segments[segment].load(_STD memory_order_relaxed))
+		{
+			alty_traits::deallocate(this->get_al(), data, segment_size(segment));
+		}
+
+		if (flag_type *flags = m_ready[segment].load(_STD memory_order_relaxed))
+		{
+			flag_alloc_traits::deallocate(flag_al, flags, segment_size(segment));
+		}
+	}
+}
+
+template <class T, class Alloc>
+inline typename JConcurrentVector<T, Alloc>::allocator_type
+JConcurrentVector<T, Alloc>::get_allocator() const noexcept
+{
+	return static_cast<allocator_type>(this->get_al());
+}
+
+template <class T, class Alloc>
+template <class... Args>
+inline typename JConcurrentVector<T, Alloc>::reference
+JConcurrentVector<T, Alloc>::emplace_back(Args&&... args)
+{
+	// An index once reserved must be published, or size() stops below it for good. A constructor that may throw
+	// therefore runs on a temporary before the index is taken, and the segment of the next index is allocated before
+	// too, so running out of memory throws without appending. Only an index carried into a new segment by other
+	// appends meanwhile allocates after it, through acquire_reserved_segment, which ends the vector if it fails.
+	if constexpr (_STD is_nothrow_constructible_v<value_type, Args...>)
+	{
+		const size_type next = m_reserved.load(_STD memory_order_relaxed);
+		size_type segment    = segments;
+		pointer data         = nullptr;
+
+		if (next < max_size())
+		{
+			segment = segment_of(next);
+			data    = acquire_segment(segment);
+		}
+
+		const size_type index = m_reserved.fetch_add(1);
+
+		if (index >= max_size())
+		{
+			throw _STD runtime_error("Vector too long.");
+		}
+
+		if (segment_of(index) >= m_failed.load(_STD memory_order_acquire))
+		{
+			throw _STD bad_alloc();
+		}
+
+		if (segment_of(index) != segment)
+		{
+			segment = segment_of(index);
+			data    = acquire_reserved_segment(segment);
+		}
+
+		pointer element = data + (index - segment_start(segment));
+		alty_traits::construct(this->get_al(), element, _STD forward<Args>(args)...);
+		publish(index);
+		return *element;
+	}
+	else
+	{
+		static_assert(_STD is_nothrow_move_constructible_v<value_type>,
+			"JConcurrentVector needs elements constructible without throwing, or nothrow movable.");
+
+		value_type value(_STD forward<Args>(args)...);
+		return emplace_back(_STD move(value));
+	}
+}
+
+template <class T, class Alloc>
+inline typename JConcurrentVector<T, Alloc>::reference
+JConcurrentVector<T, Alloc>::push_back(const T &value)
+{
+	return emplace_back(value);
+}
+
+template <class T, class Alloc>
+inline typename JConcurrentVector<T, Alloc>::reference
+JConcurrentVector<T, Alloc>::push_back(T &&value)
+{
+	return emplace_back(_STD move(value));
+}
+
+template <class T, class Alloc>
+inline void
+JConcurrentVector<T, Alloc>::reserve(const size_type count)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	if (count > max_size())
+	{
+		throw _STD runtime_error("Vector too long.");
+	}
+
+	const size_type last = segment_of(count - 1);
+
+	for (size_type segment = 0; segment <= last; ++segment)
+	{
+		acquire_segment(segment);
+	}
+}
+
+template <class T, class Alloc>
+inline typename JConcurrentVector<T, Alloc>::reference
+JConcurrentVector<T, Alloc>::operator[](const size_type pos) noexcept
+{
+	const size_type segment = segment_of(pos);
+	return m_segments[segment].load(_STD memory_order_acquire)[pos - segment_start(segment)];
+}
+
+template <class T, class Alloc>
+inline typename JConcurrentVector<T, Alloc>::const_reference
+JConcurrentVector<T, Alloc>::operator[](const size_type pos) const noexcept
+{
+	const size_type segment = segment_of(pos);
+	return m_segments[segment].load(_STD memory_order_acquire)[pos - segment_start(segment)];
+}
+
+template <class T, class Alloc>
+inline typename JConcurrentVector<T, Alloc>::reference
+JConcurrentVector<T, Alloc>::at(const size_type pos)
+{
+	if (pos >= size())
+	{
+		throw _STD out_of_range("Index out of range.");
+	}
+
+	return (*this)[pos];
+}
+
+template <class T, class Alloc>
+inline typename JConcurrentVector<T, Alloc>::const_reference
+JConcurrentVector<T, Alloc>::at(const size_type pos) const
+{
+	if (pos >= size())
+	{
+		throw _STD out_of_range("Index out of range.");
+	}
+
+	return (*this)[pos];
+}
+
+template <class T, class Alloc>
+inline typename JConcurrentVector<T, Alloc>::size_type
+JConcurrentVector<T, Alloc>::size() const noexcept
+{
+	return m_size.load(_STD memory_order_acquire);
+}
+
+template <class T, class Alloc>
+inline bool
+JConcurrentVector<T, Alloc>::empty() const noexcept
+{
+	return size() == 0;
+}
+
+template <class T, class Alloc>
+inline typename JConcurrentVector<T, Alloc>::size_type
+JConcurrentVector<T, Alloc>::capacity() const noexcept
+{
+	size_type segment = 0;
+
+	while (segment < segments && m_segments[segment].load(_STD memory_order_acquire) != nullptr)
+	{
+		++segment;
+	}
+
+	return segment_start(segment);
+}
+
+template <class T, class Alloc>
+inline typename JConcurrentVector<T, Alloc>::size_type
+JConcurrentVector<T, Alloc>::max_size() const noexcept
+{
+	return (_STD min)(static_cast<size_type>(alty_traits::max_size(this->get_al())), segment_start(segments - 1));
+}
+
+template <class T, class Alloc>
+inline typename JConcurrentVector<T, Alloc>::iterator
+JConcurrentVector<T, Alloc>::begin() noexcept
+{
+	return iterator(this, 0);
+}
+
+template <class T, class Alloc>
+inline typename JConcurrentVector<T, Alloc>::const_iterator
+JConcurrentVector<T, Alloc>::begin() const noexcept
+{
+	// Const iterators only read through the pointer, so both iterators can share it and convert.
+	return const_iterator(const_cast<JConcurrentVector*>(this), 0);
+}
+
+template <class T, class Alloc>
+inline typename JConcurrentVector<T, Alloc>::iterator
+JConcurrentVector<T, Alloc>::end() noexcept
+{
+	return iterator(this, size());
+}
+
+template <class T, class Alloc>
+inline typename JConcurrentVector<T, Alloc>::const_iterator
+JConcurrentVector<T, Alloc>::end() const noexcept
+{
+	return const_iterator(const_cast<JConcurrentVector*>(this), size());
+}
+
+template <class T, class Alloc>
+inline typename JConcurrentVector<T, Alloc>::const_iterator
+JConcurrentVector<T, Alloc>::cbegin() const noexcept
+{
+	return begin();
+}
+
+template <class T, class Alloc>
+inline typename JConcurrentVector<T, Alloc>::const_iterator
+JConcurrentVector<T, Alloc>::cend() const noexcept
+{
+	return end();
+}
+
+template <class T, class Alloc>
+inline void
+JConcurrentVector<T, Alloc>::clear() noexcept
+{
+	destroy_all();
+}
+
+template <class T, class Alloc>
+inline JVector<T, Alloc>
+JConcurrentVector<T, Alloc>::freeze() const &
+{
+	const size_type count = size();
+	JVector<T, Alloc> result(get_allocator());
+	result.reserve(count);
+
+	// One range per segment, so trivially copyable elements are copied segment by segment.
+	for (size_type segment = 0; segment_start(segment) < count; ++segment)
+	{
+		const_pointer data    = m_segments[segment].load(_STD memory_order_acquire);
+		const size_type start = segment_start(segment);
+		const size_type end   = (_STD min)(count, start + segment_size(segment));
+		result.insert(result.end(), data, data + (end - start));
+	}
+
+	return result;
+}
+
+template <class T, class Alloc>
+inline JVector<T, Alloc>
+JConcurrentVector<T, Alloc>::freeze() &&
+{
+	const size_type count = size();
+	JVector<T, Alloc> result(get_allocator());
+	result.reserve(count);
+
+	for (size_type segment = 0; segment_start(segment) < count; ++segment)
+	{
+		pointer data          = m_segments[segment].load(_STD memory_order_relaxed);
+		const size_type start = segment_start(segment);
+		const size_type end   = (_STD min)(count, start + segment_size(segment));
+		result.insert(result.end(), _STD make_move_iterator(data), _STD make_move_iterator(data + (end - start)));
+	}
+
+	destroy_all();
+	return result;
+}
+
+#endif // !_JCONCURRENTVECTOR_
@@ -0,0 +1,1009 @@
+#pragma once
+#ifndef _JINCREMENTALVECTOR_
+#define _JINCREMENTALVECTOR_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "JVector.h"
+
+// JIncrementalVector random access iterator. It refers to the vector and an index, the elements are not contiguous
+// while a migration is in progress.
+template <class MyVector>
+class JIncrementalVector_Const_Iterator
+{
+public:
+	using iterator_category = _STD random_access_iterator_tag;
+	using value_type        = typename MyVector::value_type;
+	using difference_type   = typename MyVector::difference_type;
+	using pointer           = typename MyVector::const_pointer;
+	using reference         = const value_type&;
+
+	MyVector    *vec;
+	_STD size_t index;
+
+	JIncrementalVector_Const_Iterator() noexcept
+		: vec(nullptr),
+		  index(0)
+		{}
+
+	JIncrementalVector_Const_Iterator(MyVector *vector, const _STD size_t pos) noexcept
+		: vec(vector),
+		  index(pos)
+		{}
+
+	reference operator*() const noexcept
+	{
+		return _STD as_const(*vec)[index];
+	}
+
+	pointer operator->() const noexcept
+	{
+		return _STD addressof(_STD as_const(*vec)[index]);
+	}
+
+	reference operator[](const difference_type off) const noexcept
+	{
+		return _STD as_const(*vec)[index + off];
+	}
+
+	JIncrementalVector_Const_Iterator& operator++() noexcept
+	{
+		++index;
+		return *this;
+	}
+
+	JIncrementalVector_Const_Iterator operator++(int) noexcept
+	{
+		JIncrementalVector_Const_Iterator temp = *this;
+		++index;
+		return temp;
+	}
+
+	JIncrementalVector_Const_Iterator& operator--() noexcept
+	{
+		--index;
+		return *this;
+	}
+
+	JIncrementalVector_Const_Iterator operator--(int) noexcept
+	{
+		JIncrementalVector_Const_Iterator temp = *this;
+		--index;
+		return temp;
+	}
+
+	JIncrementalVector_Const_Iterator& operator+=(const difference_type off) noexcept
+	{
+		index += off;
+		return *this;
+	}
+
+	JIncrementalVector_Const_Iterator& operator-=(const difference_type off) noexcept
+	{
+		index -= off;
+		return *this;
+	}
+
+	NODISCARD JIncrementalVector_Const_Iterator operator+(const difference_type off) const noexcept
+	{
+		return JIncrementalVector_Const_Iterator(vec, index + off);
+	}
+
+	NODISCARD friend JIncrementalVector_Const_Iterator operator+(const difference_type off,
+		const JIncrementalVector_Const_Iterator &iter) noexcept
+	{
+		return iter + off;
+	}
+
+	NODISCARD JIncrementalVector_Const_Iterator operator-(const difference_type off) const noexcept
+	{
+		return JIncrementalVector_Const_Iterator(vec, index - off);
+	}
+
+	NODISCARD difference_type operator-(const JIncrementalVector_Const_Iterator &right) const noexcept
+	{
+		return static_cast<difference_type>(index) - static_cast<difference_type>(right.index);
+	}
+
+	NODISCARD bool operator==(const JIncrementalVector_Const_Iterator &right) const noexcept
+	{
+		return index == right.index;
+	}
+
+	NODISCARD bool operator!=(const JIncrementalVector_Const_Iterator &right) const noexcept
+	{
+		return index != right.index;
+	}
+
+	NODISCARD bool operator<(const JIncrementalVector_Const_Iterator &right) const noexcept
+	{
+		return index < right.index;
+	}
+
+	NODISCARD bool operator>(const JIncrementalVector_Const_Iterator &right) const noexcept
+	{
+		return index > right.index;
+	}
+
+	NODISCARD bool operator<=(const JIncrementalVector_Const_Iterator &right) const noexcept
+	{
+		return index <= right.index;
+	}
+
+	NODISCARD bool operator>=(const JIncrementalVector_Const_Iterator &right) const noexcept
+	{
+		return index >= right.index;
+	}
+};
+
+template <class MyVector>
+class JIncrementalVector_Iterator : public JIncrementalVector_Const_Iterator<MyVector>
+{
+public:
+	using my_base           = JIncrementalVector_Const_Iterator<MyVector>;
+
+	using iterator_category = _STD random_access_iterator_tag;
+	using value_type        = typename MyVector::value_type;
+	using difference_type   = typename MyVector::difference_type;
+	using pointer           = typename MyVector::pointer;
+	using reference         = value_type&;
+
+	using my_base::my_base;
+
+	reference operator*() const noexcept
+	{
+		return (*this->vec)[this->index];
+	}
+
+	pointer operator->() const noexcept
+	{
+		return _STD addressof((*this->vec)[this->index]);
+	}
+
+	reference operator[](const difference_type off) const noexcept
+	{
+		return (*this->vec)[this->index + off];
+	}
+
+	JIncrementalVector_Iterator& operator++() noexcept
+	{
+		my_base::operator++();
+		return *this;
+	}
+
+	JIncrementalVector_Iterator operator++(int) noexcept
+	{
+		JIncrementalVector_Iterator temp = *this;
+		my_base::operator++();
+		return temp;
+	}
+
+	JIncrementalVector_Iterator& operator--() noexcept
+	{
+		my_base::operator--();
+		return *this;
+	}
+
+	JIncrementalVector_Iterator operator--(int) noexcept
+	{
+		JIncrementalVector_Iterator temp = *this;
+		my_base::operator--();
+		return temp;
+	}
+
+	JIncrementalVector_Iterator& operator+=(const difference_type off) noexcept
+	{
+		my_base::operator+=(off);
+		return *this;
+	}
+
+	JIncrementalVector_Iterator& operator-=(const difference_type off) noexcept
+	{
+		my_base::operator-=(off);
+		return *this;
+	}
+
+	NODISCARD JIncrementalVector_Iterator operator+(const difference_type off) const noexcept
+	{
+		return JIncrementalVector_Iterator(this->vec, this->index + off);
+	}
+
+	NODISCARD friend JIncrementalVector_Iterator operator+(const difference_type off,
+		const JIncrementalVector_Iterator &iter) noexcept
+	{
+		return iter + off;
+	}
+
+	NODISCARD JIncrementalVector_Iterator operator-(const difference_type off) const noexcept
+	{
+		return JIncrementalVector_Iterator(this->vec, this->index - off);
+	}
+
+	using my_base::operator-;
+};
+
+// A vector that grows without moving all its elements at once. When it is full it allocates the larger buffer,
+// keeps the old one, and every later push_back or pop_back moves a few elements across, the way hash tables
+// rehash incrementally. The number moved per call is picked when the migration starts so that it ends before
+// the new buffer fills: about size / free capacity, 2 or 3 with the default 1.5x growth.
+// While a migration runs the elements [moved, split) are still in the old buffer; indexing checks that range.
+// Elements are contiguous, and data() is available, only once the migration is over.
+template <class T, class Alloc = _STD allocator<T>, class Growth = JSTD::default_growth>
+class JIncrementalVector
+	: private JVector_Alloc_Holder<typename _STD allocator_traits<Alloc>::template rebind_alloc<T>>
+{
+private:
+	using alty        = typename _STD allocator_traits<Alloc>::template rebind_alloc<T>;
+	using alty_traits = _STD allocator_traits<alty>;
+	using my_base     = JVector_Alloc_Holder<alty>;
+
+	static_assert(_STD is_same_v<typename alty_traits::pointer, T*>,
+		"JIncrementalVector requires an allocator whose pointer type is T*.");
+
+	// Relocation bypasses the allocator's construct() and destroy().
+	static constexpr bool trivially_relocatable = JSTD::is_trivially_relocatable_v<T>;
+
+public:
+	using value_type             = T;
+	using allocator_type         = Alloc;
+	using pointer                = T*;
+	using const_pointer          = const T*;
+	using reference              = value_type&;
+	using const_reference        = const value_type&;
+	using size_type              = _STD size_t;
+	using difference_type        = _STD ptrdiff_t;
+	using iterator               = JIncrementalVector_Iterator<JIncrementalVector<T, Alloc, Growth>>;
+	using const_iterator         = JIncrementalVector_Const_Iterator<JIncrementalVector<T, Alloc, Growth>>;
+	using reverse_iterator       = _STD reverse_iterator<iterator>;
+	using const_reverse_iterator = _STD reverse_iterator<const_iterator>;
+
+private:
+	size_type m_size;
+	size_type m_capacity;
+	pointer   m_data;
+
+	// The buffer being emptied, null when no migration runs.
+	pointer   m_old;
+	size_type m_old_capacity;
+
+	// [m_moved, m_split) are still in m_old, everything else is in m_data. Both are 0 when no migration runs.
+	size_type m_moved;
+	size_type m_split;
+	size_type m_step;
+
+	NODISCARD bool in_old(const size_type pos) const noexcept;
+
+	// Moves elements [m_moved, m_moved + count) into the new buffer and frees the old one when it is empty.
+	void migrate(size_type count);
+
+	void end_migration() noexcept;
+
+	// Starts moving the elements into a buffer of new_capacity, all at once when incremental is false.
+	void grow_to(const size_type new_capacity, const bool incremental);
+
+	void destroy_all() noexcept;
+
+	void tidy() noexcept;
+
+	NODISCARD bool equal_allocator(const JIncrementalVector &other) const noexcept;
+
+public:
+	JIncrementalVector() noexcept(_STD is_nothrow_default_constructible_v<alty>);
+
+	explicit JIncrementalVector(const Alloc &al) noexcept;
+
+	JIncrementalVector(_STD initializer_list<T> init, const Alloc &al = Alloc());
+
+	JIncrementalVector(const JIncrementalVector &other);
+
+	JIncrementalVector(JIncrementalVector &&other) noexcept;
+
+	~JIncrementalVector() noexcept;
+
+	JIncrementalVector& operator=(const JIncrementalVector &other);
+
+	JIncrementalVector& operator=(JIncrementalVector &&other)
+		noexcept(alty_traits::propagate_on_container_move_assignment::value || alty_traits::is_always_equal::value);
+
+	NODISCARD allocator_type get_allocator() const noexcept;
+
+	template <class... Args>
+	reference emplace_back(Args&&... args);
+
+	void push_back(const T &value);
+
+	void push_back(T &&value);
+
+	void pop_back();
+
+	NODISCARD reference operator[](const size_type pos) noexcept;
+
+	NODISCARD const_reference operator[](const size_type pos) const noexcept;
+
+	NODISCARD reference at(const size_type pos);
+
+	NODISCARD const_reference at(const size_type pos) const;
+
+	NODISCARD reference front() noexcept;
+
+	NODISCARD const_reference front() const noexcept;
+
+	NODISCARD reference back() noexcept;
+
+	NODISCARD const_reference back() const noexcept;
+
+	// Finishes any migration first, so the elements are contiguous.
+	NODISCARD pointer data();
+
+	NODISCARD iterator begin() noexcept;
+
+	NODISCARD const_iterator begin() const noexcept;
+
+	NODISCARD iterator end() noexcept;
+
+	NODISCARD const_iterator end() const noexcept;
+
+	NODISCARD reverse_iterator rbegin() noexcept;
+
+	NODISCARD const_reverse_iterator rbegin() const noexcept;
+
+	NODISCARD reverse_iterator rend() noexcept;
+
+	NODISCARD const_reverse_iterator rend() const noexcept;
+
+	NODISCARD const_iterator cbegin() const noexcept;
+
+	NODISCARD const_iterator cend() const noexcept;
+
+	NODISCARD bool empty() const noexcept;
+
+	NODISCARD size_type size() const noexcept;
+
+	NODISCARD size_type max_size() const noexcept;
+
+	NODISCARD size_type capacity() const noexcept;
+
+	// Whether elements are still waiting in the old buffer.
+	NODISCARD bool migrating() const noexcept;
+
+	// Moves the remaining elements of a migration at once.
+	void finish_migration();
+
+	// Reallocates at once, like JVector::reserve.
+	void reserve(const size_type new_cap);
+
+	void clear() noexcept;
+
+	void swap(JIncrementalVector &other) noexcept;
+};
+
+template <class T, class Alloc, class Growth>
+inline bool
+JIncrementalVector<T, Alloc, Growth>::in_old(const size_type pos) const noexcept
+{
+	// One unsigned comparison, always false when no migration runs.
+	return pos - m_moved < m_split - m_moved;
+}
+
+template <class T, class Alloc, class Growth>
+inline void
+JIncrementalVector<T, Alloc, Growth>::migrate(size_type count)
+{
+	count = (_STD min)(count, m_split - m_moved);
+
+	if constexpr (trivially_relocatable)
+	{
+		if (count != 0)
+		{
+			_STD memcpy(static_cast<void*>(m_data + m_moved), static_cast<const void*>(m_old + m_moved),
+				count * sizeof(T));
+			m_moved += count;
+		}
+	}
+	else
+	{
+		// m_moved follows each element, so a throwing copy leaves the vector as it was before that element.
+		for (const size_type last = m_moved + count; m_moved < last; ++m_moved)
+		{
+			alty_traits::construct(this->get_al(), m_data + m_moved, _STD move_if_noexcept(m_old[m_moved]));
+			alty_traits::destroy(this->get_al(), m_old + m_moved);
+		}
+	}
+
+	if (m_moved == m_split)
+	{
+		end_migration();
+	}
+}
+
+template <class T, class Alloc, class Growth>
+inline void
+JIncrementalVector<T, Alloc, Growth>::end_migration() noexcept
+{
+	if (m_old != nullptr)
+	{
+		alty_traits::deallocate(this->get_al(), m_old, m_old_capacity);
+	}
+
+	m_old          = nullptr;
+	m_old_capacity = 0;
+	m_moved        = 0;
+	m_split        = 0;
+}
+
+template <class T, class Alloc, class Growth>
+inline void
+JIncrementalVector<T, Alloc, Growth>::grow_to(const size_type new_capacity, const bool incremental)
+{
+	finish_migration();
+
+	pointer new_data = alty_traits::allocate(this->get_al(), new_capacity);
+
+	m_old          = m_data;
+	m_old_capacity = m_capacity;
+	m_data         = new_data;
+	m_capacity     = new_capacity;
+	m_moved        = 0;
+	m_split        = m_size;
+	// The push_back that grows takes one free slot without moving anything, the others share the move.
+	const size_type calls = new_capacity - m_size - 1;
+	m_step                = calls == 0 ? m_size : (m_size + calls - 1) / calls;
+
+	if (m_size == 0 || !incremental)
+	{
+		finish_migration();
+	}
+}
+
+template <class T, class Alloc, class Growth>
+inline void
+JIncrementalVector<T, Alloc, Growth>::destroy_all() noexcept
+{
+	if constexpr (!_STD is_trivially_destructible_v<value_type>)
+	{
+		for (size_type pos = 0; pos < m_size; ++pos)
+		{
+			alty_traits::destroy(this->get_al(), _STD addressof((*this)[pos]));
+		}
+	}
+
+	m_size = 0;
+	end_migration();
+}
+
+template <class T, class Alloc, class Growth>
+inline void
+JIncrementalVector<T, Alloc, Growth>::tidy() noexcept
+{
+	destroy_all();
+
+	if (m_data != nullptr)
+	{
+		alty_traits::deallocate(this->get_al(), m_data, m_capacity);
+	}
+
+	m_data     = nullptr;
+	m_capacity = 0;
+}
+
+template <class T, class Alloc, class Growth>
+inline bool
+JIncrementalVector<T, Alloc, Growth>::equal_allocator(const JIncrementalVector &other) const noexcept
+{
+	if constexpr (alty_traits::is_always_equal::value)
+	{
+		return true;
+	}
+	else
+	{
+		return this->get_al() == other.get_al();
+	}
+}
+
+template <class T, class Alloc, class Growth>
+inline
+JIncrementalVector<T, Alloc, Growth>::JIncrementalVector() noexcept(_STD is_nothrow_default_constructible_v<alty>)
+	: my_base(),
+	  m_size(0),
+	  m_capacity(0),
+	  m_data(nullptr),
+	  m_old(nullptr),
+	  m_old_capacity(0),
+	  m_moved(0),
+	  m_split(0),
+	  m_step(0)
+	{}
+
+template <class T, class Alloc, class Growth>
+inline
+JIncrementalVector<T, Alloc, Growth>::JIncrementalVector(const Alloc &al) noexcept
+	: my_base(al),
+	  m_size(0),
+	  m_capacity(0),
+	  m_data(nullptr),
+	  m_old(nullptr),
+	  m_old_capacity(0),
+	  m_moved(0),
+	  m_split(0),
+	  m_step(0)
+	{}
+
+template <class T, class Alloc, class Growth>
+inline
+JIncrementalVector<T, Alloc, Growth>::JIncrementalVector(_STD initializer_list<T> init, const Alloc &al)
+	: JIncrementalVector(al)
+{
+	try
+	{
+		reserve(init.size());
+
+		for (const T &value : init)
+		{
+			emplace_back(value);
+		}
+	}
+	catch (...)
+	{
+		// Called from a constructor, where the destructor will not run.
+		tidy();
+		throw;
+	}
+}
+
+template <class T, class Alloc, class Growth>
+inline
+JIncrementalVector<T, Alloc, Growth>::JIncrementalVector(const JIncrementalVector &other)
+	: JIncrementalVector(static_cast<Alloc>(alty_traits::select_on_container_copy_construction(other.get_al())))
+{
+	try
+	{
+		reserve(other.m_size);
+
+		for (size_type pos = 0; pos < other.m_size; ++pos)
+		{
+			emplace_back(other[pos]);
+		}
+	}
+	catch (...)
+	{
+		tidy();
+		throw;
+	}
+}
+
+template <class T, class Alloc, class Growth>
+inline
+JIncrementalVector<T, Alloc, Growth>::JIncrementalVector(JIncrementalVector &&other) noexcept
+	: my_base(_STD move(other.get_al())),
+	  m_size(_STD exchange(other.m_size, 0)),
+	  m_capacity(_STD exchange(other.m_capacity, 0)),
+	  m_data(_STD exchange(other.m_data, nullptr)),
+	  m_old(_STD exchange(other.m_old, nullptr)),
+	  m_old_capacity(_STD exchange(other.m_old_capacity, 0)),
+	  m_moved(_STD exchange(other.m_moved, 0)),
+	  m_split(_STD exchange(other.m_split, 0)),
+	  m_step(_STD exchange(other.m_step, 0))
+	{}
+
+template <class T, class Alloc, class Growth>
+inline
+JIncrementalVector<T, Alloc, Growth>::~JIncrementalVector() noexcept
+{
+	tidy();
+}
+
+template <class T, class Alloc, class Growth>
+inline JIncrementalVector<T, Alloc, Growth>&
+JIncrementalVector<T, Alloc, Growth>::operator=(const JIncrementalVector &other)
+{
+	if (this != _STD addressof(other))
+	{
+		if constexpr (alty_traits::propagate_on_container_copy_assignment::value)
+		{
+			if (!equal_allocator(other))
+			{
+				// The buffers go back to the allocator they came from before it is replaced.
+				tidy();
+			}
+
+			this->get_al() = other.get_al();
+		}
+
+		clear();
+		reserve(other.m_size);
+
+		for (size_type pos = 0; pos < other.m_size; ++pos)
+		{
+			emplace_back(other[pos]);
+		}
+	}
+
+	return *this;
+}
+
+template <class T, class Alloc, class Growth>
+inline JIncrementalVector<T, Alloc, Growth>&
+JIncrementalVector<T, Alloc, Growth>::operator=(JIncrementalVector &&other)
+	noexcept(alty_traits::propagate_on_container_move_assignment::value || alty_traits::is_always_equal::value)
+{
+	if (this != _STD addressof(other))
+	{
+		if (alty_traits::propagate_on_container_move_assignment::value || equal_allocator(other))
+		{
+			tidy();
+
+			if constexpr (alty_traits::propagate_on_container_move_assignment::value)
+			{
+				this->get_al() = _STD move(other.get_al());
+			}
+
+			m_size         = _STD exchange(other.m_size, 0);
+			m_capacity     = _STD exchange(other.m_capacity, 0);
+			m_data         = _STD exchange(other.m_data, nullptr);
+			m_old          = _STD exchange(other.m_old, nullptr);
+			m_old_capacity = _STD exchange(other.m_old_capacity, 0);
+			m_moved        = _STD exchange(other.m_moved, 0);
+			m_split        = _STD exchange(other.m_split, 0);
+			m_step         = _STD exchange(other.m_step, 0);
+		}
+		else
+		{
+			// Buffers from another allocator cannot be taken over, the elements are moved one by one.
+			clear();
+			reserve(other.m_size);
+
+			for (size_type pos = 0; pos < other.m_size; ++pos)
+			{
+				emplace_back(_STD move(other[pos]));
+			}
+		}
+	}
+
+	return *this;
+}
+
+template <class T, class Alloc, class Growth>
+inline typename JIncrementalVector<T, Alloc, Growth>::allocator_type
+JIncrementalVector<T, Alloc, Growth>::get_allocator() const noexcept
+{
+	return static_cast<allocator_type>(this->get_al());
+}
+
+template <class T, class Alloc, class Growth>
+template <class... Args>
+inline typename JIncrementalVector<T, Alloc, Growth>::reference
+JIncrementalVector<T, Alloc, Growth>::emplace_back(Args&&... args)
+{
+	if (m_size == m_capacity)
+	{
+		if (m_size == max_size())
+		{
+			throw _STD runtime_error("Vector too long.");
+		}
+
+		// args may refer to an element, so build the new one before any is moved.
+		value_type new_obj(_STD forward<Args>(args)...);
+		grow_to(static_cast<size_type>(Growth::template next_capacity<value_type>(m_capacity, m_size + 1, max_size())),
+			true);
+		alty_traits::construct(this->get_al(), m_data + m_size, _STD move(new_obj));
+		return m_data[m_size++];
+	}
+
+	alty_traits::construct(this->get_al(), m_data + m_size, _STD forward<Args>(args)...);
+	++m_size;
+
+	if (m_old != nullptr)
+	{
+		try
+		{
+			migrate(m_step);
+		}
+		catch (...)
+		{
+			--m_size;
+			alty_traits::destroy(this->get_al(), m_data + m_size);
+			throw;
+		}
+	}
+
+	return m_data[m_size - 1];
+}
+
+template <class T, class Alloc, class Growth>
+inline void
+JIncrementalVector<T, Alloc, Growth>::push_back(const T &value)
+{
+	emplace_back(value);
+}
+
+template <class T, class Alloc, class Growth>
+inline void
+JIncrementalVector<T, Alloc, Growth>::push_back(T &&value)
+{
+	emplace_back(_STD move(value));
+}
+
+template <class T, class Alloc, class Growth>
+inline void
+JIncrementalVector<T, Alloc, Growth>::pop_back()
+{
+	// Moves before popping, so a throwing copy leaves the last element in place.
+	if (m_old != nullptr)
+	{
+		migrate(m_step);
+	}
+
+	--m_size;
+	alty_traits::destroy(this->get_al(), _STD addressof((*this)[m_size]));
+
+	// Popped into the part not moved yet.
+	if (m_size < m_split)
+	{
+		m_split = m_size;
+
+		if (m_moved == m_split)
+		{
+			end_migration();
+		}
+	}
+}
+
+template <class T, class Alloc, class Growth>
+inline typename JIncrementalVector<T, Alloc, Growth>::reference
+JIncrementalVector<T, Alloc, Growth>::operator[](const size_type pos) noexcept
+{
+	return in_old(pos) ? m_old[pos] : m_data[pos];
+}
+
+template <class T, class Alloc, class Growth>
+inline typename JIncrementalVector<T, Alloc, Growth>::const_reference
+JIncrementalVector<T, Alloc, Growth>::operator[](const size_type pos) const noexcept
+{
+	return in_old(pos) ? m_old[pos] : m_data[pos];
+}
+
+template <class T, class Alloc, class Growth>
+inline typename JIncrementalVector<T, Alloc, Growth>::reference
+JIncrementalVector<T, Alloc, Growth>::at(const size_type pos)
+{
+	if (pos >= m_size)
+	{
+		throw _STD out_of_range("Index out of range.");
+	}
+
+	return (*this)[pos];
+}
+
+template <class T, class Alloc, class Growth>
+inline typename JIncrementalVector<T, Alloc, Growth>::const_reference
+JIncrementalVector<T, Alloc, Growth>::at(const size_type pos) const
+{
+	if (pos >= m_size)
+	{
+		throw _STD out_of_range("Index out of range.");
+	}
+
+	return (*this)[pos];
+}
+
+template <class T, class Alloc, class Growth>
+inline typename JIncrementalVector<T, Alloc, Growth>::reference
+JIncrementalVector<T, Alloc, Growth>::front() noexcept
+{
+	return (*this)[0];
+}
+
+template <class T, class Alloc, class Growth>
+inline typename JIncrementalVector<T, Alloc, Growth>::const_reference
+JIncrementalVector<T, Alloc, Growth>::front() const noexcept
+{
+	return (*this)[0];
+}
+
+template <class T, class Alloc, class Growth>
+inline typename JIncrementalVector<T, Alloc, Growth>::reference
+JIncrementalVector<T, Alloc, Growth>::back() noexcept
+{
+	return (*this)[m_size - 1];
+}
+
+template <class T, class Alloc, class Growth>
+inline typename JIncrementalVector<T, Alloc, Growth>::const_reference
+JIncrementalVector<T, Alloc, Growth>::back() const noexcept
+{
+	return (*this)[m_size - 1];
+}
+
+template <class T, class Alloc, class Growth>
+inline typename JIncrementalVector<T, Alloc, Growth>::pointer
+JIncrementalVector<T, Alloc, Growth>::data()
+{
+	finish_migration();
+	return m_data;
+}
+
+template <class T, class Alloc, class Growth>
+inline typename JIncrementalVector<T, Alloc, Growth>::iterator
+JIncrementalVector<T, Alloc, Growth>::begin() noexcept
+{
+	return iterator(this, 0);
+}
+
+template <class T, class Alloc, class Growth>
+inline typename JIncrementalVector<T, Alloc, Growth>::const_iterator
+JIncrementalVector<T, Alloc, Growth>::begin() const noexcept
+{
+	// Const iterators only read through the pointer, so both iterators can share it and convert.
+	return const_iterator(const_cast<JIncrementalVector*>(this), 0);
+}
+
+template <class T, class Alloc, class Growth>
+inline typename JIncrementalVector<T, Alloc, Growth>::iterator
+JIncrementalVector<T, Alloc, Growth>::end() noexcept
+{
+	return iterator(this, m_size);
+}
+
+template <class T, class Alloc, class Growth>
+inline typename JIncrementalVector<T, Alloc, Growth>::const_iterator
+JIncrementalVector<T, Alloc, Growth>::end() const noexcept
+{
+	return const_iterator(const_cast<JIncrementalVector*>(this), m_size);
+}
+
+template <class T, class Alloc, class Growth>
+inline typename JIncrementalVector<T, Alloc, Growth>::reverse_iterator
+JIncrementalVector<T, Alloc, Growth>::rbegin() noexcept
+{
+	return reverse_iterator(end());
+}
+
+template <class T, class Alloc, class Growth>
+inline typename JIncrementalVector<T, Alloc, Growth>::const_reverse_iterator
+JIncrementalVector<T, Alloc, Growth>::rbegin() const noexcept
+{
+	return const_reverse_iterator(end());
+}
+
+template <class T, class Alloc, class Growth>
+inline typename JIncrementalVector<T, Alloc, Growth>::reverse_iterator
+JIncrementalVector<T, Alloc, Growth>::rend() noexcept
+{
+	return reverse_iterator(begin());
+}
+
+template <class T, class Alloc, class Growth>
+inline typename JIncrementalVector<T, Alloc, Growth>::const_reverse_iterator
+JIncrementalVector<T, Alloc, Growth>::rend() const noexcept
+{
+	return const_reverse_iterator(begin());
+}
+
+template <class T, class Alloc, class Growth>
+inline typename JIncrementalVector<T, Alloc, Growth>::const_iterator
+JIncrementalVector<T, Alloc, Growth>::cbegin() const noexcept
+{
+	return begin();
+}
+
+template <class T, class Alloc, class Growth>
+inline typename JIncrementalVector<T, Alloc, Growth>::const_iterator
+JIncrementalVector<T, Alloc, Growth>::cend() const noexcept
+{
+	return end();
+}
+
+template <class T, class Alloc, class Growth>
+inline bool
+JIncrementalVector<T, Alloc, Growth>::empty() const noexcept
+{
+	return m_size == 0;
+}
+
+template <class T, class Alloc, class Growth>
+inline typename JIncrementalVector<T, Alloc, Growth>::size_type
+JIncrementalVector<T, Alloc, Growth>::size() const noexcept
+{
+	return m_size;
+}
+
+template <class T, class Alloc, class Growth>
+inline typename JIncrementalVector<T, Alloc, Growth>::size_type
+JIncrementalVector<T, Alloc, Growth>::max_size() const noexcept
+{
+	return (_STD min)(static_cast<size_type>(alty_traits::max_size(this->get_al())),
+		static_cast<size_type>(PTRDIFF_MAX / sizeof(T)));
+}
+
+template <class T, class Alloc, class Growth>
+inline typename JIncrementalVector<T, Alloc, Growth>::size_type
+JIncrementalVector<T, Alloc, Growth>::capacity() const noexcept
+{
+	return m_capacity;
+}
+
+template <class T, class Alloc, class Growth>
+inline bool
+JIncrementalVector<T, Alloc, Growth>::migrating() const noexcept
+{
+	return m_old != nullptr;
+}
+
+template <class T, class Alloc, class Growth>
+inline void
+JIncrementalVector<T, Alloc, Growth>::finish_migration()
+{
+	if (m_old != nullptr)
+	{
+		migrate(m_split - m_moved);
+	}
+}
+
+template <class T, class Alloc, class Growth>
+inline void
+JIncrementalVector<T, Alloc, Growth>::reserve(const size_type new_cap)
+{
+	if (new_cap > m_capacity)
+	{
+		if (new_cap > max_size())
+		{
+			throw _STD runtime_error("Vector too long.");
+		}
+
+		grow_to(new_cap, false);
+	}
+}
+
+template <class T, class Alloc, class Growth>
+inline void
+JIncrementalVector<T, Alloc, Growth>::clear() noexcept
+{
+	destroy_all();
+}
+
+template <class T, class Alloc, class Growth>
+inline void
+JIncrementalVector<T, Alloc, Growth>::swap(JIncrementalVector &other) noexcept
+{
+	if (this != _STD addressof(other))
+	{
+		using _STD swap;
+
+		if constexpr (alty_traits::propagate_on_container_swap::value)
+		{
+			swap(this->get_al(), other.get_al());
+		}
+		else
+		{
+			// Swapping vectors with unequal allocators which do not propagate is undefined behaviour.
+			assert(equal_allocator(other));
+		}
+
+		swap(m_size, other.m_size);
+		swap(m_capacity, other.m_capacity);
+		swap(m_data, other.m_data);
+		swap(m_old, other.m_old);
+		swap(m_old_capacity, other.m_old_capacity);
+		swap(m_moved, other.m_moved);
+		swap(m_split, other.m_split);
+		swap(m_step, other.m_step);
+	}
+}
+
+template <class T, class Alloc, class Growth>
+void
+swap(JIncrementalVector<T, Alloc, Growth> &left, JIncrementalVector<T, Alloc, Growth> &right) noexcept
+{
+	left.swap(right);
+}
+
+#endif // !_JINCREMENTALVECTOR_
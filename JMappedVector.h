@@ -0,0 +1,1006 @@
+#pragma once
+#ifndef _JMAPPEDVECTOR_
+#define _JMAPPEDVECTOR_
+
+#include "JVector.h"
+
+#include <cerrno>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#error "JMappedVector needs POSIX mmap."
+#endif // __unix__ || __APPLE__
+
+// How a JMappedVector maps its file. A read-only file is mapped copy-on-write: writes through references to its
+// elements stay private to the vector and never reach the file, and members that would change its size throw
+// std::logic_error.
+enum class JMappedVector_Mode
+{
+	read_only,
+	read_write
+};
+
+// Access patterns passed on to madvise().
+enum class JMappedVector_Advice
+{
+	normal,
+	sequential,
+	random,
+	will_need,
+	dont_need
+};
+
+// A vector of trivially copyable elements kept in a file through a shared mapping, so processes opening the same file
+// share its pages through the page cache instead of each reading a copy. The file holds the elements and nothing else.
+// While open, a writable file is as long as the capacity, close() truncates it to the size.
+// Growth extends the file with ftruncate and the mapping with mremap, or by mapping it again where there is no mremap.
+template <class T, class Growth = JSTD::default_growth>
+class JMappedVector
+{
+public:
+	static_assert(_STD is_trivially_copyable_v<T>, "JMappedVector requires trivially copyable elements.");
+
+	using value_type             = T;
+	using pointer                = T*;
+	using const_pointer          = const T*;
+	using reference              = value_type&;
+	using const_reference        = const value_type&;
+	using size_type              = _STD size_t;
+	using difference_type        = _STD ptrdiff_t;
+	using iterator               = JVector_Iterator<JMappedVector<T, Growth>>;
+	using const_iterator         = JVector_Const_Iterator<JMappedVector<T, Growth>>;
+	using reverse_iterator       = _STD reverse_iterator<iterator>;
+	using const_reverse_iterator = _STD reverse_iterator<const_iterator>;
+
+private:
+	NODISCARD static _STD size_t page_bytes() noexcept;
+
+	[[noreturn]] static void throw_errno(const char *what);
+
+	void map_file(const _STD size_t bytes);
+
+	void grow_to(const size_type min_capacity);
+
+	void require_writable() const;
+
+	void require_mutable() const;
+
+	pointer make_room(const pointer pos, const size_type count);
+
+public:
+	JMappedVector() noexcept;
+
+	JMappedVector(const char *path, JMappedVector_Mode mode = JMappedVector_Mode::read_write);
+
+	JMappedVector(JMappedVector &&other) noexcept;
+
+	JMappedVector(const JMappedVector&) = delete;
+
+	~JMappedVector() noexcept;
+
+	JMappedVector& operator=(JMappedVector &&other) noexcept;
+
+	JMappedVector& operator=(const JMappedVector&) = delete;
+
+	// Creates or truncates the file at path and maps it writable and empty.
+	void create(const char *path, size_type initial_capacity = 0);
+
+	// Maps an existing file in place, its length must be a multiple of sizeof(T).
+	void open(const char *path, JMappedVector_Mode mode = JMappedVector_Mode::read_write);
+
+	// Unmaps the file, truncated to the size if writable.
+	void close();
+
+	NODISCARD bool is_open() const noexcept;
+
+	NODISCARD bool writable() const noexcept;
+
+	// Writes dirty pages back to the file, waiting for it unless wait is false.
+	void sync(bool wait = true);
+
+	void advise(JMappedVector_Advice advice);
+
+	NODISCARD reference at(const size_type pos);
+
+	NODISCARD const_reference at(const size_type pos) const;
+
+	NODISCARD reference operator[](const size_type pos) noexcept;
+
+	NODISCARD const_reference operator[](const size_type pos) const noexcept;
+
+	NODISCARD reference front() noexcept;
+
+	NODISCARD const_reference front() const noexcept;
+
+	NODISCARD reference back() noexcept;
+
+	NODISCARD const_reference back() const noexcept;
+
+	NODISCARD pointer data() noexcept;
+
+	NODISCARD const_pointer data() const noexcept;
+
+	NODISCARD iterator begin() noexcept;
+
+	NODISCARD const_iterator begin() const noexcept;
+
+	NODISCARD iterator end() noexcept;
+
+	NODISCARD const_iterator end() const noexcept;
+
+	NODISCARD reverse_iterator rbegin() noexcept;
+
+	NODISCARD const_reverse_iterator rbegin() const noexcept;
+
+	NODISCARD reverse_iterator rend() noexcept;
+
+	NODISCARD const_reverse_iterator rend() const noexcept;
+
+	NODISCARD const_iterator cbegin() const noexcept;
+
+	NODISCARD const_iterator cend() const noexcept;
+
+	NODISCARD const_reverse_iterator crbegin() const noexcept;
+
+	NODISCARD const_reverse_iterator crend() const noexcept;
+
+	NODISCARD bool empty() const noexcept;
+
+	NODISCARD size_type size() const noexcept;
+
+	NODISCARD size_type max_size() const noexcept;
+
+	NODISCARD size_type capacity() const noexcept;
+
+	void reserve(const size_type new_cap);
+
+	// Gives the file's pages past the size back, keeping whole pages.
+	void shrink_to_fit();
+
+	void clear();
+
+	template <class... Args>
+	reference emplace_back(Args&&... args);
+
+	void push_back(const T &value);
+
+	void pop_back();
+
+	template <class... Args>
+	iterator emplace(const_iterator pos, Args&&... args);
+
+	iterator insert(const_iterator pos, const T &value);
+
+	iterator insert(const_iterator pos, size_type count, const T &value);
+
+	template <class Iter, class = _STD enable_if_t<JSTD::is_iterator_v<Iter>>>
+	iterator insert(const_iterator pos, Iter first, Iter last);
+
+	iterator insert(const_iterator pos, _STD initializer_list<T> ilist);
+
+	iterator erase(const_iterator pos);
+
+	iterator erase(const_iterator first, const_iterator last);
+
+	void assign(size_type count, const T &value);
+
+	template <class Iter, class = _STD enable_if_t<JSTD::is_iterator_v<Iter>>>
+	void assign(Iter first, Iter last);
+
+	void assign(_STD initializer_list<T> ilist);
+
+	void resize(size_type count);
+
+	void resize(size_type count, const value_type &value);
+
+	void swap(JMappedVector &other) noexcept;
+
+private:
+	pointer   m_data;
+	size_type m_size;
+	size_type m_capacity;
+	int       m_fd;
+	bool      m_writable;
+};
+
+template <class T, class Growth>
+inline _STD size_t
+JMappedVector<T, Growth>::page_bytes() noexcept
+{
+	static const _STD size_t bytes = static_cast<_STD size_t>(::sysconf(_SC_PAGESIZE));
+	return bytes;
+}
+
+template <class T, class Growth>
+[[noreturn]] inline void
+JMappedVector<T, Growth>::throw_errno(const char *what)
+{
+	throw _STD system_error(errno, _STD generic_category(), what);
+}
+
+template <class T, class Growth>
+inline void
+JMappedVector<T, Growth>::map_file(const _STD size_t bytes)
+{
+	// The file is already bytes long. Nothing is mapped for an empty file.
+	if (bytes == 0)
+	{
+		m_data     = nullptr;
+		m_capacity = 0;
+		return;
+	}
+
+	// A read-only file is mapped private and writable, a stray write copies the page instead of faulting.
+	const int sharing = m_writable ? MAP_SHARED : MAP_PRIVATE;
+	void *ptr         = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, sharing, m_fd, 0);
+
+	if (ptr == MAP_FAILED)
+	{
+		throw_errno("JMappedVector: mmap");
+	}
+
+	m_data     = static_cast<pointer>(ptr);
+	m_capacity = bytes / sizeof(value_type);
+}
+
+template <class T, class Growth>
+inline void
+JMappedVector<T, Growth>::grow_to(const size_type min_capacity)
+{
+	// Extends the file first, then the mapping. The elements stay in the page cache, nothing is copied.
+	require_writable();
+
+	if (min_capacity > max_size())
+	{
+		throw _STD runtime_error("Vector too long.");
+	}
+
+	const size_type new_capacity = Growth::template next_capacity<value_type>(m_capacity, min_capacity, max_size());
+	const _STD size_t page       = page_bytes();
+	const _STD size_t old_bytes  = m_capacity * sizeof(value_type);
+	const _STD size_t new_bytes  = (new_capacity * sizeof(value_type) + page - 1) / page * page;
+
+	if (::ftruncate(m_fd, static_cast<off_t>(new_bytes)) != 0)
+	{
+		throw_errno("JMappedVector: ftruncate");
+	}
+
+	if (m_data == nullptr)
+	{
+		map_file(new_bytes);
+		return;
+	}
+
+#if defined(__linux__)
+	void *ptr = ::mremap(m_data, old_bytes, new_bytes, MREMAP_MAYMOVE);
+
+	if (ptr == MAP_FAILED)
+	{
+		throw_errno("JMappedVector: mremap");
+	}
+
+	m_data     = static_cast<pointer>(ptr);
+	m_capacity = new_bytes / sizeof(value_type);
+#else
+	// The file holds the elements, mapping it again at its new length keeps them.
+	::munmap(m_data, old_bytes);
+	m_data = nullptr;
+	map_file(new_bytes);
+#endif // __linux__
+}
+
+template <class T, class Growth>
+inline void
+JMappedVector<T, Growth>::require_writable() const
+{
+	if (m_fd < 0 || !m_writable)
+	{
+		throw _STD logic_error("JMappedVector is not open for writing.");
+	}
+}
+
+template <class T, class Growth>
+inline void
+JMappedVector<T, Growth>::require_mutable() const
+{
+	// Unlike require_writable, a closed vector passes: it is empty and nothing can be written through it.
+	if (m_fd >= 0 && !m_writable)
+	{
+		throw _STD logic_error("JMappedVector is not open for writing.");
+	}
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::pointer
+JMappedVector<T, Growth>::make_room(const pointer pos, const size_type count)
+{
+	// Opens a gap of count elements at pos and returns it, pos is rebased if the mapping moves.
+	const size_type offset = static_cast<size_type>(pos - m_data);
+
+	if (count > max_size() - m_size)
+	{
+		throw _STD runtime_error("Vector too long.");
+	}
+
+	if (m_size + count > m_capacity)
+	{
+		grow_to(m_size + count);
+	}
+	else
+	{
+		require_writable();
+	}
+
+	pointer gap = m_data + offset;
+	_STD memmove(static_cast<void*>(gap + count), gap, (m_size - offset) * sizeof(value_type));
+	m_size += count;
+	return gap;
+}
+
+template <class T, class Growth>
+inline
+JMappedVector<T, Growth>::JMappedVector() noexcept
+	: m_data(nullptr),
+	  m_size(0),
+	  m_capacity(0),
+	  m_fd(-1),
+	  m_writable(false)
+	{}
+
+template <class T, class Growth>
+inline
+JMappedVector<T, Growth>::JMappedVector(const char *path, JMappedVector_Mode mode)
+	: JMappedVector()
+{
+	open(path, mode);
+}
+
+template <class T, class Growth>
+inline
+JMappedVector<T, Growth>::JMappedVector(JMappedVector &&other) noexcept
+	: JMappedVector()
+{
+	swap(other);
+}
+
+template <class T, class Growth>
+inline
+JMappedVector<T, Growth>::~JMappedVector() noexcept
+{
+	try
+	{
+		close();
+	}
+	catch (...)
+	{
+		// The mapping and the descriptor are released even if truncating fails.
+	}
+}
+
+template <class T, class Growth>
+inline JMappedVector<T, Growth>&
+JMappedVector<T, Growth>::operator=(JMappedVector &&other) noexcept
+{
+	if (this != &other)
+	{
+		JMappedVector temp(_STD move(other));
+		swap(temp);
+	}
+
+	return *this;
+}
+
+template <class T, class Growth>
+inline void
+JMappedVector<T, Growth>::create(const char *path, size_type initial_capacity)
+{
+	close();
+
+	m_fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+	if (m_fd < 0)
+	{
+		throw_errno("JMappedVector: open");
+	}
+
+	m_writable = true;
+
+	if (initial_capacity != 0)
+	{
+		reserve(initial_capacity);
+	}
+}
+
+template <class T, class Growth>
+inline void
+JMappedVector<T, Growth>::open(const char *path, JMappedVector_Mode mode)
+{
+	close();
+
+	const bool writable = mode == JMappedVector_Mode::read_write;
+	m_fd                = ::open(path, (writable ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+
+	if (m_fd < 0)
+	{
+		throw_errno("JMappedVector: open");
+	}
+
+	m_writable = writable;
+
+	try
+	{
+		struct stat info;
+
+		if (::fstat(m_fd, &info) != 0)
+		{
+			throw_errno("JMappedVector: fstat");
+		}
+
+		const _STD size_t bytes = static_cast<_STD size_t>(info.st_size);
+
+		if (bytes % sizeof(value_type) != 0)
+		{
+			throw _STD runtime_error("JMappedVector: file length is not a multiple of the element size.");
+		}
+
+		map_file(bytes);
+		m_size = m_capacity;
+	}
+	catch (...)
+	{
+		::close(m_fd);
+		m_fd       = -1;
+		m_writable = false;
+		throw;
+	}
+}
+
+template <class T, class Growth>
+inline void
+JMappedVector<T, Growth>::close()
+{
+	if (m_fd < 0)
+	{
+		return;
+	}
+
+	if (m_data != nullptr)
+	{
+		::munmap(m_data, m_capacity * sizeof(value_type));
+	}
+
+	const int fd        = m_fd;
+	const bool truncate = m_writable && m_size != m_capacity;
+	const _STD size_t bytes = m_size * sizeof(value_type);
+
+	m_data     = nullptr;
+	m_size     = 0;
+	m_capacity = 0;
+	m_fd       = -1;
+	m_writable = false;
+
+	const bool truncated = !truncate || ::ftruncate(fd, static_cast<off_t>(bytes)) == 0;
+	const int error      = errno;
+	::close(fd);
+
+	if (!truncated)
+	{
+		throw _STD system_error(error, _STD generic_category(), "JMappedVector: ftruncate");
+	}
+}
+
+template <class T, class Growth>
+inline bool
+JMappedVector<T, Growth>::is_open() const noexcept
+{
+	return m_fd >= 0;
+}
+
+template <class T, class Growth>
+inline bool
+JMappedVector<T, Growth>::writable() const noexcept
+{
+	return m_writable;
+}
+
+template <class T, class Growth>
+inline void
+JMappedVector<T, Growth>::sync(bool wait)
+{
+	if (m_data != nullptr && ::msync(m_data, m_capacity * sizeof(value_type), wait ? MS_SYNC : MS_ASYNC) != 0)
+	{
+		throw_errno("JMappedVector: msync");
+	}
+}
+
+template <class T, class Growth>
+inline void
+JMappedVector<T, Growth>::advise(JMappedVector_Advice advice)
+{
+	if (m_data == nullptr)
+	{
+		return;
+	}
+
+	int flag = MADV_NORMAL;
+
+	switch (advice)
+	{
+	case JMappedVector_Advice::sequential:
+		flag = MADV_SEQUENTIAL;
+		break;
+	case JMappedVector_Advice::random:
+		flag = MADV_RANDOM;
+		break;
+	case JMappedVector_Advice::will_need:
+		flag = MADV_WILLNEED;
+		break;
+	case JMappedVector_Advice::dont_need:
+		flag = MADV_DONTNEED;
+		break;
+	default:
+		break;
+	}
+
+	if (::madvise(static_cast<void*>(m_data), m_capacity * sizeof(value_type), flag) != 0)
+	{
+		throw_errno("JMappedVector: madvise");
+	}
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::reference
+JMappedVector<T, Growth>::at(const size_type pos)
+{
+	if (pos >= m_size)
+	{
+		throw _STD out_of_range("Index out of range.");
+	}
+
+	return m_data[pos];
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::const_reference
+JMappedVector<T, Growth>::at(const size_type pos) const
+{
+	if (pos >= m_size)
+	{
+		throw _STD out_of_range("Index out of range.");
+	}
+
+	return m_data[pos];
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::reference
+JMappedVector<T, Growth>::operator[](const size_type pos) noexcept
+{
+	return m_data[pos];
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::const_reference
+JMappedVector<T, Growth>::operator[](const size_type pos) const noexcept
+{
+	return m_data[pos];
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::reference
+JMappedVector<T, Growth>::front() noexcept
+{
+	return m_data[0];
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::const_reference
+JMappedVector<T, Growth>::front() const noexcept
+{
+	return m_data[0];
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::reference
+JMappedVector<T, Growth>::back() noexcept
+{
+	return m_data[m_size - 1];
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::const_reference
+JMappedVector<T, Growth>::back() const noexcept
+{
+	return m_data[m_size - 1];
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::pointer
+JMappedVector<T, Growth>::data() noexcept
+{
+	return m_data;
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::const_pointer
+JMappedVector<T, Growth>::data() const noexcept
+{
+	return m_data;
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::iterator
+JMappedVector<T, Growth>::begin() noexcept
+{
+	return iterator(m_data);
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::const_iterator
+JMappedVector<T, Growth>::begin() const noexcept
+{
+	return const_iterator(m_data);
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::iterator
+JMappedVector<T, Growth>::end() noexcept
+{
+	return iterator(m_data + m_size);
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::const_iterator
+JMappedVector<T, Growth>::end() const noexcept
+{
+	return const_iterator(m_data + m_size);
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::reverse_iterator
+JMappedVector<T, Growth>::rbegin() noexcept
+{
+	return reverse_iterator(end());
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::const_reverse_iterator
+JMappedVector<T, Growth>::rbegin() const noexcept
+{
+	return const_reverse_iterator(end());
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::reverse_iterator
+JMappedVector<T, Growth>::rend() noexcept
+{
+	return reverse_iterator(begin());
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::const_reverse_iterator
+JMappedVector<T, Growth>::rend() const noexcept
+{
+	return const_reverse_iterator(begin());
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::const_iterator
+JMappedVector<T, Growth>::cbegin() const noexcept
+{
+	return begin();
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::const_iterator
+JMappedVector<T, Growth>::cend() const noexcept
+{
+	return end();
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::const_reverse_iterator
+JMappedVector<T, Growth>::crbegin() const noexcept
+{
+	return rbegin();
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::const_reverse_iterator
+JMappedVector<T, Growth>::crend() const noexcept
+{
+	return rend();
+}
+
+template <class T, class Growth>
+inline bool
+JMappedVector<T, Growth>::empty() const noexcept
+{
+	return m_size == 0;
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::size_type
+JMappedVector<T, Growth>::size() const noexcept
+{
+	return m_size;
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::size_type
+JMappedVector<T, Growth>::max_size() const noexcept
+{
+	// The file length must fit off_t.
+	const _STD size_t max_bytes = static_cast<_STD size_t>((_STD numeric_limits<off_t>::max)());
+	return max_bytes / sizeof(value_type);
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::size_type
+JMappedVector<T, Growth>::capacity() const noexcept
+{
+	return m_capacity;
+}
+
+template <class T, class Growth>
+inline void
+JMappedVector<T, Growth>::reserve(const size_type new_cap)
+{
+	if (new_cap > m_capacity)
+	{
+		grow_to(new_cap);
+	}
+}
+
+template <class T, class Growth>
+inline void
+JMappedVector<T, Growth>::shrink_to_fit()
+{
+	require_writable();
+
+	const _STD size_t page      = page_bytes();
+	const _STD size_t old_bytes = m_capacity * sizeof(value_type);
+	const _STD size_t new_bytes = (m_size * sizeof(value_type) + page - 1) / page * page;
+
+	if (new_bytes >= old_bytes)
+	{
+		return;
+	}
+
+	// Unmapping the tail first, the file then drops the pages.
+	if (new_bytes == 0)
+	{
+		::munmap(m_data, old_bytes);
+		m_data = nullptr;
+	}
+	else
+	{
+		::munmap(reinterpret_cast<unsigned char*>(m_data) + new_bytes, old_bytes - new_bytes);
+	}
+
+	m_capacity = new_bytes / sizeof(value_type);
+
+	if (::ftruncate(m_fd, static_cast<off_t>(new_bytes)) != 0)
+	{
+		throw_errno("JMappedVector: ftruncate");
+	}
+}
+
+template <class T, class Growth>
+inline void
+JMappedVector<T, Growth>::clear()
+{
+	require_mutable();
+	m_size = 0;
+}
+
+template <class T, class Growth>
+template <class... Args>
+inline typename JMappedVector<T, Growth>::reference
+JMappedVector<T, Growth>::emplace_back(Args&&... args)
+{
+	if (m_size == m_capacity)
+	{
+		// args may refer to an element, construct it before the mapping can move.
+		value_type value(_STD forward<Args>(args)...);
+		grow_to(m_size + 1);
+		return *::new (static_cast<void*>(m_data + m_size++)) value_type(value);
+	}
+
+	require_writable();
+	return *::new (static_cast<void*>(m_data + m_size++)) value_type(_STD forward<Args>(args)...);
+}
+
+template <class T, class Growth>
+inline void
+JMappedVector<T, Growth>::push_back(const T &value)
+{
+	emplace_back(value);
+}
+
+template <class T, class Growth>
+inline void
+JMappedVector<T, Growth>::pop_back()
+{
+	require_mutable();
+	--m_size;
+}
+
+template <class T, class Growth>
+template <class... Args>
+inline typename JMappedVector<T, Growth>::iterator
+JMappedVector<T, Growth>::emplace(const_iterator pos, Args&&... args)
+{
+	value_type value(_STD forward<Args>(args)...);
+	pointer gap = make_room(pos.ptr, 1);
+	::new (static_cast<void*>(gap)) value_type(value);
+	return iterator(gap);
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::iterator
+JMappedVector<T, Growth>::insert(const_iterator pos, const T &value)
+{
+	return emplace(pos, value);
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::iterator
+JMappedVector<T, Growth>::insert(const_iterator pos, size_type count, const T &value)
+{
+	const value_type copy(value);
+	pointer gap = make_room(pos.ptr, count);
+	JSTD::simd_fill(gap, count, copy);
+	return iterator(gap);
+}
+
+template <class T, class Growth>
+template <class Iter, class>
+inline typename JMappedVector<T, Growth>::iterator
+JMappedVector<T, Growth>::insert(const_iterator pos, Iter first, Iter last)
+{
+	// The source may lie in this vector, copy it out before the mapping can move.
+	JVector<value_type> copy(first, last);
+	const size_type count = copy.size();
+	pointer gap           = make_room(pos.ptr, count);
+
+	if (count != 0)
+	{
+		_STD memcpy(static_cast<void*>(gap), copy.data(), count * sizeof(value_type));
+	}
+
+	return iterator(gap);
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::iterator
+JMappedVector<T, Growth>::insert(const_iterator pos, _STD initializer_list<T> ilist)
+{
+	return insert(pos, ilist.begin(), ilist.end());
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::iterator
+JMappedVector<T, Growth>::erase(const_iterator pos)
+{
+	return erase(pos, pos + 1);
+}
+
+template <class T, class Growth>
+inline typename JMappedVector<T, Growth>::iterator
+JMappedVector<T, Growth>::erase(const_iterator first, const_iterator last)
+{
+	const pointer from = first.ptr;
+	const pointer to   = last.ptr;
+
+	// An empty range changes nothing, even in a closed or read-only vector.
+	if (from == to)
+	{
+		return iterator(from);
+	}
+
+	require_mutable();
+	_STD memmove(static_cast<void*>(from), to, static_cast<size_type>(m_data + m_size - to) * sizeof(value_type));
+	m_size -= static_cast<size_type>(to - from);
+	return iterator(from);
+}
+
+template <class T, class Growth>
+inline void
+JMappedVector<T, Growth>::assign(size_type count, const T &value)
+{
+	const value_type copy(value);
+	reserve(count);
+	require_writable();
+	JSTD::simd_fill(m_data, count, copy);
+	m_size = count;
+}
+
+template <class T, class Growth>
+template <class Iter, class>
+inline void
+JMappedVector<T, Growth>::assign(Iter first, Iter last)
+{
+	JVector<value_type> copy(first, last);
+	reserve(copy.size());
+	require_writable();
+
+	if (!copy.empty())
+	{
+		_STD memcpy(static_cast<void*>(m_data), copy.data(), copy.size() * sizeof(value_type));
+	}
+
+	m_size = copy.size();
+}
+
+template <class T, class Growth>
+inline void
+JMappedVector<T, Growth>::assign(_STD initializer_list<T> ilist)
+{
+	assign(ilist.begin(), ilist.end());
+}
+
+template <class T, class Growth>
+inline void
+JMappedVector<T, Growth>::resize(size_type count)
+{
+	resize(count, value_type());
+}
+
+template <class T, class Growth>
+inline void
+JMappedVector<T, Growth>::resize(size_type count, const value_type &value)
+{
+	require_mutable();
+
+	if (count <= m_size)
+	{
+		m_size = count;
+		return;
+	}
+
+	const value_type copy(value);
+	reserve(count);
+	require_writable();
+	JSTD::simd_fill(m_data + m_size, count - m_size, copy);
+	m_size = count;
+}
+
+template <class T, class Growth>
+inline void
+JMappedVector<T, Growth>::swap(JMappedVector &other) noexcept
+{
+	_STD swap(m_data, other.m_data);
+	_STD swap(m_size, other.m_size);
+	_STD swap(m_capacity, other.m_capacity);
+	_STD swap(m_fd, other.m_fd);
+	_STD swap(m_writable, other.m_writable);
+}
+
+template <class T, class Growth>
+NODISCARD bool
+operator==(const JMappedVector<T, Growth> &left, const JMappedVector<T, Growth> &right)
+{
+	return left.size() == right.size() && _STD equal(left.begin(), left.end(), right.begin());
+}
+
+template <class T, class Growth>
+NODISCARD bool
+operator!=(const JMappedVector<T, Growth> &left, const JMappedVector<T, Growth> &right)
+{
+	return !(left == right);
+}
+
+template <class T, class Growth>
+void
+swap(JMappedVector<T, Growth> &left, JMappedVector<T, Growth> &right) noexcept
+{
+	left.swap(right);
+}
+
+#endif // !_JMAPPEDVECTOR_
@@ -0,0 +1,639 @@
+#pragma once
+#ifndef _JPACKEDVECTOR_
+#define _JPACKEDVECTOR_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "JVector.h"
+#include "jstd_simd.h"
+
+// JPackedVector iterator. Values are decoded a block at a time into the iterator, so it reads by value.
+template <class MyVector>
+class JPackedVector_Const_Iterator
+{
+public:
+	using iterator_category = _STD input_iterator_tag;
+	using value_type        = typename MyVector::value_type;
+	using difference_type   = typename MyVector::difference_type;
+	using pointer           = const value_type*;
+	using reference         = value_type;
+
+	JPackedVector_Const_Iterator() noexcept
+		: m_vec(nullptr),
+		  m_index(0),
+		  m_block(MyVector::npos)
+		{}
+
+	JPackedVector_Const_Iterator(const MyVector *vector, const _STD size_t pos) noexcept
+		: m_vec(vector),
+		  m_index(pos),
+		  m_block(MyVector::npos)
+		{}
+
+	reference operator*() const noexcept
+	{
+		const _STD size_t block = m_index / MyVector::block_size;
+
+		if (block != m_block)
+		{
+			m_vec->decode_block(block, m_values);
+			m_block = block;
+		}
+
+		return m_values[m_index % MyVector::block_size];
+	}
+
+	JPackedVector_Const_Iterator& operator++() noexcept
+	{
+		++m_index;
+		return *this;
+	}
+
+	JPackedVector_Const_Iterator operator++(int) noexcept
+	{
+		JPackedVector_Const_Iterator temp = *this;
+		++m_index;
+		return temp;
+	}
+
+	NODISCARD _STD size_t index() const noexcept
+	{
+		return m_index;
+	}
+
+	NODISCARD bool operator==(const JPackedVector_Const_Iterator &right) const noexcept
+	{
+		return m_index == right.m_index;
+	}
+
+	NODISCARD bool operator!=(const JPackedVector_Const_Iterator &right) const noexcept
+	{
+		return m_index != right.m_index;
+	}
+
+private:
+	const MyVector     *m_vec;
+	_STD size_t         m_index;
+	mutable _STD size_t m_block;
+	mutable value_type  m_values[MyVector::block_size];
+};
+
+// A compressed vector of 32 or 64-bit integers for sorted or clustered ids, such as posting lists.
+// Values are appended to an open block. Every 128 values are sealed into one block, encoded in one of two ways:
+// as offsets from the block minimum (frame of reference), or, when the block is sorted, as differences
+// between neighbours (delta). Whichever encoding needs fewer bits is bit-packed. Blocks that would need
+// more than 32 bits are stored as they are. Decoding unpacks and sums a block with SSE2.
+// The block headers form a skip index, so lower_bound() finds a value in O(log n) and decodes one block.
+// operator[] decodes one value of a frame-of-reference block and a whole delta block.
+template <class Int>
+class JPackedVector
+{
+	static_assert(_STD is_integral_v<Int> && (sizeof(Int) == 4 || sizeof(Int) == 8),
+		"JPackedVector holds 32 or 64-bit integers.");
+
+public:
+	using value_type      = Int;
+	using size_type       = _STD size_t;
+	using difference_type = _STD ptrdiff_t;
+	using const_reference = Int;
+	using const_iterator  = JPackedVector_Const_Iterator<JPackedVector<Int>>;
+	using iterator        = const_iterator;
+
+	static constexpr size_type block_size = JSTD::packed_block_size;
+	static constexpr size_type npos       = static_cast<size_type>(-1);
+
+	enum class encoding : unsigned char
+	{
+		frame,
+		delta,
+		raw
+	};
+
+private:
+	using unsigned_type = _STD make_unsigned_t<Int>;
+
+	struct block_header
+	{
+		Int           first;
+		Int           base;
+		size_type     offset;
+		unsigned char bits;
+		encoding      kind;
+	};
+
+	static constexpr size_type raw_words = block_size * sizeof(Int) / sizeof(_STD uint32_t);
+
+	JVector<block_header>    m_blocks;
+	JVector<_STD uint32_t>   m_words;
+	JVector<Int>             m_tail;
+
+	NODISCARD static unsigned bit_width(unsigned_type value) noexcept;
+
+	// Encodes the full open block.
+	void seal();
+
+public:
+	JPackedVector() noexcept = default;
+
+	template <class Iter, class = _STD enable_if_t<JSTD::is_iterator_v<Iter>>>
+	JPackedVector(Iter first, Iter last);
+
+	JPackedVector(_STD initializer_list<Int> init);
+
+	explicit JPackedVector(const JVector<Int> &values);
+
+	NODISCARD JVector<Int> to_vector() const;
+
+	NODISCARD const_reference operator[](const size_type pos) const noexcept;
+
+	NODISCARD const_reference at(const size_type pos) const;
+
+	NODISCARD const_reference front() const noexcept;
+
+	NODISCARD const_reference back() const noexcept;
+
+	NODISCARD const_iterator begin() const noexcept;
+
+	NODISCARD const_iterator end() const noexcept;
+
+	NODISCARD const_iterator cbegin() const noexcept;
+
+	NODISCARD const_iterator cend() const noexcept;
+
+	NODISCARD bool empty() const noexcept;
+
+	NODISCARD size_type size() const noexcept;
+
+	// Sealed blocks, and the open block if it has values.
+	NODISCARD size_type block_count() const noexcept;
+
+	NODISCARD encoding block_encoding(const size_type block) const noexcept;
+
+	// Bytes used by the block headers, the packed words and the open block.
+	NODISCARD size_type compressed_bytes() const noexcept;
+
+	// Writes the values of a block to out, which has room for block_size values, and returns how many there are.
+	size_type decode_block(const size_type block, Int *out) const noexcept;
+
+	// Index of the first value not less than value, or size(). The values must be sorted.
+	NODISCARD size_type lower_bound(const Int value) const noexcept;
+
+	void push_back(const Int value);
+
+	void clear() noexcept;
+
+	void shrink_to_fit();
+
+	void swap(JPackedVector &other) noexcept;
+
+	NODISCARD bool operator==(const JPackedVector &other) const noexcept;
+
+	NODISCARD bool operator!=(const JPackedVector &other) const noexcept;
+};
+
+template <class Int>
+inline unsigned
+JPackedVector<Int>::bit_width(unsigned_type value) noexcept
+{
+	unsigned bits = 0;
+
+	while (value != 0)
+	{
+		++bits;
+		value >>= 1;
+	}
+
+	return bits;
+}
+
+template <class Int>
+inline void
+JPackedVector<Int>::seal()
+{
+	const Int *values = m_tail.data();
+
+	Int low                 = values[0];
+	bool sorted             = true;
+	unsigned_type max_delta = 0;
+
+	for (size_type j = 1; j != block_size; ++j)
+	{
+		low    = _STD min(low, values[j]);
+		sorted = sorted && values[j - 1] <= values[j];
+
+		if (sorted)
+		{
+			max_delta = _STD max(max_delta, static_cast<unsigned_type>(
+				static_cast<unsigned_type>(values[j]) - static_cast<unsigned_type>(values[j - 1])));
+		}
+	}
+
+	unsigned_type max_offset = 0;
+
+	for (size_type j = 0; j != block_size; ++j)
+	{
+		max_offset = _STD max(max_offset, static_cast<unsigned_type>(
+			static_cast<unsigned_type>(values[j]) - static_cast<unsigned_type>(low)));
+	}
+
+	// Frame of reference on a tie, since it decodes a single value without the rest of the block.
+	const unsigned frame_bits = bit_width(max_offset);
+	const unsigned delta_bits = sorted ? bit_width(max_delta) : frame_bits + 1;
+
+	block_header header;
+	header.first  = values[0];
+	header.offset = m_words.size();
+
+	if (_STD min(frame_bits, delta_bits) > 32)
+	{
+		header.base = values[0];
+		header.bits = static_cast<unsigned char>(sizeof(Int) * 8);
+		header.kind = encoding::raw;
+
+		m_words.resize_default_init(header.offset + raw_words);
+		_STD memcpy(m_words.data() + header.offset, values, block_size * sizeof(Int));
+	}
+	else
+	{
+		const bool delta = delta_bits < frame_bits;
+
+		header.base = delta ? values[0] : low;
+		header.bits = static_cast<unsigned char>(delta ? delta_bits : frame_bits);
+		header.kind = delta ? encoding::delta : encoding::frame;
+
+		_STD uint32_t residuals[block_size];
+
+		for (size_type j = 0; j != block_size; ++j)
+		{
+			const unsigned_type from = static_cast<unsigned_type>(delta && j != 0 ? values[j - 1] : header.base);
+			residuals[j]             = static_cast<_STD uint32_t>(static_cast<unsigned_type>(values[j]) - from);
+		}
+
+		// Equal residuals take no words.
+		if (header.bits != 0)
+		{
+			m_words.resize_default_init(header.offset + 4 * size_type(header.bits));
+			JSTD::pack_block(residuals, header.bits, m_words.data() + header.offset);
+		}
+	}
+
+	try
+	{
+		m_blocks.push_back(header);
+	}
+	catch (...)
+	{
+		m_words.resize(header.offset);
+		throw;
+	}
+
+	m_tail.clear();
+}
+
+template <class Int>
+template <class Iter, class>
+inline
+JPackedVector<Int>::JPackedVector(Iter first, Iter last)
+	: JPackedVector()
+{
+	for (; first != last; ++first)
+	{
+		push_back(*first);
+	}
+}
+
+template <class Int>
+inline
+JPackedVector<Int>::JPackedVector(_STD initializer_list<Int> init)
+	: JPackedVector(init.begin(), init.end())
+	{}
+
+template <class Int>
+inline
+JPackedVector<Int>::JPackedVector(const JVector<Int> &values)
+	: JPackedVector(values.begin(), values.end())
+	{}
+
+template <class Int>
+inline JVector<Int>
+JPackedVector<Int>::to_vector() const
+{
+	JVector<Int> result;
+	result.resize_default_init(size());
+
+	for (size_type block = 0, count = block_count(); block != count; ++block)
+	{
+		decode_block(block, result.data() + block * block_size);
+	}
+
+	return result;
+}
+
+template <class Int>
+inline typename JPackedVector<Int>::const_reference
+JPackedVector<Int>::operator[](const size_type pos) const noexcept
+{
+	const size_type block = pos / block_size;
+	const size_type j     = pos % block_size;
+
+	if (block == m_blocks.size())
+	{
+		return m_tail[j];
+	}
+
+	const block_header &header = m_blocks[block];
+	const _STD uint32_t *in    = m_words.data() + header.offset;
+
+	if (header.kind == encoding::raw)
+	{
+		Int value;
+		_STD memcpy(&value, in + j * (sizeof(Int) / sizeof(_STD uint32_t)), sizeof(Int));
+		return value;
+	}
+
+	if (header.kind == encoding::delta)
+	{
+		Int values[block_size];
+		decode_block(block, values);
+		return values[j];
+	}
+
+	// One value of the lane layout pack_block() writes.
+	_STD uint32_t residual = 0;
+
+	if (header.bits != 0)
+	{
+		const size_type bit   = (j / 4) * header.bits;
+		const size_type word  = 4 * (bit / 32) + j % 4;
+		const unsigned offset = static_cast<unsigned>(bit % 32);
+
+		residual = in[word] >> offset;
+
+		if (offset + header.bits > 32)
+		{
+			residual |= in[word + 4] << (32 - offset);
+		}
+
+		if (header.bits < 32)
+		{
+			residual &= (_STD uint32_t(1) << header.bits) - 1;
+		}
+	}
+
+	return static_cast<Int>(static_cast<unsigned_type>(header.base) + residual);
+}
+
+template <class Int>
+inline typename JPackedVector<Int>::const_reference
+JPackedVector<Int>::at(const size_type pos) const
+{
+	if (pos >= size())
+	{
+		throw _STD out_of_range("Index out of range.");
+	}
+
+	return (*this)[pos];
+}
+
+template <class Int>
+inline typename JPackedVector<Int>::const_reference
+JPackedVector<Int>::front() const noexcept
+{
+	return m_blocks.empty() ? m_tail.front() : m_blocks.front().first;
+}
+
+template <class Int>
+inline typename JPackedVector<Int>::const_reference
+JPackedVector<Int>::back() const noexcept
+{
+	return (*this)[size() - 1];
+}
+
+template <class Int>
+inline typename JPackedVector<Int>::const_iterator
+JPackedVector<Int>::begin() const noexcept
+{
+	return const_iterator(this, 0);
+}
+
+template <class Int>
+inline typename JPackedVector<Int>::const_iterator
+JPackedVector<Int>::end() const noexcept
+{
+	return const_iterator(this, size());
+}
+
+template <class Int>
+inline typename JPackedVector<Int>::const_iterator
+JPackedVector<Int>::cbegin() const noexcept
+{
+	return begin();
+}
+
+template <class Int>
+inline typename JPackedVector<Int>::const_iterator
+JPackedVector<Int>::cend() const noexcept
+{
+	return end();
+}
+
+template <class Int>
+inline bool
+JPackedVector<Int>::empty() const noexcept
+{
+	return m_blocks.empty() && m_tail.empty();
+}
+
+template <class Int>
+inline typename JPackedVector<Int>::size_type
+JPackedVector<Int>::size() const noexcept
+{
+	return m_blocks.size() * block_size + m_tail.size();
+}
+
+template <class Int>
+inline typename JPackedVector<Int>::size_type
+JPackedVector<Int>::block_count() const noexcept
+{
+	return m_blocks.size() + !m_tail.empty();
+}
+
+template <class Int>
+inline typename JPackedVector<Int>::encoding
+JPackedVector<Int>::block_encoding(const size_type block) const noexcept
+{
+	return block == m_blocks.size() ? encoding::raw : m_blocks[block].kind;
+}
+
+template <class Int>
+inline typename JPackedVector<Int>::size_type
+JPackedVector<Int>::compressed_bytes() const noexcept
+{
+	return m_blocks.size() * sizeof(block_header) + m_words.size() * sizeof(_STD uint32_t) + m_tail.size() * sizeof(Int);
+}
+
+template <class Int>
+inline typename JPackedVector<Int>::size_type
+JPackedVector<Int>::decode_block(const size_type block, Int *out) const noexcept
+{
+	if (block == m_blocks.size())
+	{
+		_STD memcpy(out, m_tail.data(), m_tail.size() * sizeof(Int));
+		return m_tail.size();
+	}
+
+	const block_header &header = m_blocks[block];
+	const _STD uint32_t *in    = m_words.data() + header.offset;
+
+	if (header.kind == encoding::raw)
+	{
+		_STD memcpy(out, in, block_size * sizeof(Int));
+		return block_size;
+	}
+
+	_STD uint32_t residuals[block_size];
+	JSTD::unpack_block(in, header.bits, residuals);
+
+	const unsigned_type base = static_cast<unsigned_type>(header.base);
+
+	if (header.kind == encoding::frame)
+	{
+		for (size_type j = 0; j != block_size; ++j)
+		{
+			out[j] = static_cast<Int>(base + residuals[j]);
+		}
+	}
+	else if constexpr (sizeof(Int) == sizeof(_STD uint32_t))
+	{
+		JSTD::prefix_sum_block(residuals, base);
+		_STD memcpy(out, residuals, sizeof(residuals));
+	}
+	else
+	{
+		unsigned_type sum = base;
+
+		for (size_type j = 0; j != block_size; ++j)
+		{
+			sum   += residuals[j];
+			out[j] = static_cast<Int>(sum);
+		}
+	}
+
+	return block_size;
+}
+
+template <class Int>
+inline typename JPackedVector<Int>::size_type
+JPackedVector<Int>::lower_bound(const Int value) const noexcept
+{
+	// The first block starting at or past value. The answer is in the block before it, or is its first value.
+	size_type low  = 0;
+	size_type high = block_count();
+
+	while (low != high)
+	{
+		const size_type mid = low + (high - low) / 2;
+		const Int first     = mid == m_blocks.size() ? m_tail.front() : m_blocks[mid].first;
+
+		if (first < value)
+		{
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid;
+		}
+	}
+
+	if (low == 0)
+	{
+		return 0;
+	}
+
+	Int values[block_size];
+	const size_type count = decode_block(low - 1, values);
+
+	return (low - 1) * block_size + static_cast<size_type>(_STD lower_bound(values, values + count, value) - values);
+}
+
+template <class Int>
+inline void
+JPackedVector<Int>::push_back(const Int value)
+{
+	if (m_tail.capacity() == 0)
+	{
+		m_tail.reserve(block_size);
+	}
+
+	m_tail.push_back(value);
+
+	if (m_tail.size() == block_size)
+	{
+		try
+		{
+			seal();
+		}
+		catch (...)
+		{
+			m_tail.pop_back();
+			throw;
+		}
+	}
+}
+
+template <class Int>
+inline void
+JPackedVector<Int>::clear() noexcept
+{
+	m_blocks.clear();
+	m_words.clear();
+	m_tail.clear();
+}
+
+template <class Int>
+inline void
+JPackedVector<Int>::shrink_to_fit()
+{
+	m_blocks.shrink_to_fit();
+	m_words.shrink_to_fit();
+}
+
+template <class Int>
+inline void
+JPackedVector<Int>::swap(JPackedVector &other) noexcept
+{
+	m_blocks.swap(other.m_blocks);
+	m_words.swap(other.m_words);
+	m_tail.swap(other.m_tail);
+}
+
+template <class Int>
+inline bool
+JPackedVector<Int>::operator==(const JPackedVector &other) const noexcept
+{
+	return size() == other.size() && _STD equal(begin(), end(), other.begin());
+}
+
+template <class Int>
+inline bool
+JPackedVector<Int>::operator!=(const JPackedVector &other) const noexcept
+{
+	return !(*this == other);
+}
+
+template <class Int>
+void
+swap(JPackedVector<Int> &left, JPackedVector<Int> &right) noexcept
+{
+	left.swap(right);
+}
+
+#endif // !_JPACKEDVECTOR_
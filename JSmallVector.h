@@ -0,0 +1,556 @@
+#pragma once
+#ifndef _JSMALLVECTOR_
+#define _JSMALLVECTOR_
+
+#include "JVector.h"
+
+// Allocator of JSmallVector. Requests of up to N elements are served from its inline buffer while that is unused,
+// larger ones from the heap storage JVector<T, Alloc> would use, so heap buffers can move between the two.
+// A copy never shares the inline buffer, so two instances never compare equal and never propagate.
+template <class T, _STD size_t N, class Alloc>
+class JSmallVector_Allocator
+{
+private:
+	using inner_alty        = typename _STD allocator_traits<Alloc>::template rebind_alloc<T>;
+	using inner_alty_traits = _STD allocator_traits<inner_alty>;
+
+	template <class, _STD size_t, class, class>
+	friend class JSmallVector;
+
+	template <class, _STD size_t, class>
+	friend class JSmallVector_Allocator;
+
+	// The inline buffer is aligned like the heap buffers, e.g. to Align with aligned_allocator<T, Align>.
+	static constexpr _STD size_t alignment = JSTD::storage_alignment_v<inner_alty>;
+
+	alignas(alignment) unsigned char m_buffer[N * sizeof(T)];
+	bool                     m_buffer_used;
+	inner_alty               m_alloc;
+
+public:
+	using value_type                             = T;
+	using size_type                              = typename inner_alty_traits::size_type;
+	using difference_type                        = typename inner_alty_traits::difference_type;
+	using propagate_on_container_copy_assignment = _STD false_type;
+	using propagate_on_container_move_assignment = _STD false_type;
+	using propagate_on_container_swap            = _STD false_type;
+	using is_always_equal                        = _STD false_type;
+
+	template <class U>
+	struct rebind
+	{
+		using other = JSmallVector_Allocator<U, N, Alloc>;
+	};
+
+	JSmallVector_Allocator() noexcept(_STD is_nothrow_default_constructible_v<inner_alty>)
+		: m_buffer_used(false),
+		  m_alloc()
+		{}
+
+	explicit JSmallVector_Allocator(const Alloc &al) noexcept
+		: m_buffer_used(false),
+		  m_alloc(al)
+		{}
+
+	JSmallVector_Allocator(const JSmallVector_Allocator &other) noexcept
+		: m_buffer_used(false),
+		  m_alloc(other.m_alloc)
+		{}
+
+	template <class U>
+	JSmallVector_Allocator(const JSmallVector_Allocator<U, N, Alloc> &other) noexcept
+		: m_buffer_used(false),
+		  m_alloc(other.m_alloc)
+		{}
+
+	JSmallVector_Allocator& operator=(const JSmallVector_Allocator&) = delete;
+
+	NODISCARD T* allocate(const size_type count)
+	{
+		if (count <= N && !m_buffer_used)
+		{
+			m_buffer_used = true;
+			return inline_data();
+		}
+
+		if constexpr (JSTD::uses_native_storage_v<T, Alloc>)
+		{
+			return static_cast<T*>(JSTD::native_allocate(count * sizeof(T), alignment));
+		}
+		else
+		{
+			return inner_alty_traits::allocate(m_alloc, count);
+		}
+	}
+
+	// The inline buffer always holds N elements, so a vector placed in it can use all of them.
+	NODISCARD JSTD::allocation_result<T*, size_type> allocate_at_least(const size_type count)
+	{
+		if (count <= N && !m_buffer_used)
+		{
+			m_buffer_used = true;
+			return { inline_data(), N };
+		}
+
+		if constexpr (JSTD::uses_native_storage_v<T, Alloc>)
+		{
+			const _STD size_t bytes = count * sizeof(T);
+			void *ptr               = JSTD::native_allocate(bytes, alignment);
+			return { static_cast<T*>(ptr), JSTD::native_usable_size(ptr, bytes, alignment) / sizeof(T) };
+		}
+		else
+		{
+			return JSTD::allocate_at_least(m_alloc, count);
+		}
+	}
+
+	void deallocate(T *ptr, const size_type count) noexcept
+	{
+		if (ptr == inline_data())
+		{
+			m_buffer_used = false;
+		}
+		else if constexpr (JSTD::uses_native_storage_v<T, Alloc>)
+		{
+			JSTD::native_deallocate(ptr, count * sizeof(T), alignment);
+		}
+		else
+		{
+			inner_alty_traits::deallocate(m_alloc, ptr, count);
+		}
+	}
+
+	NODISCARD JSmallVector_Allocator select_on_container_copy_construction() const
+	{
+		return JSmallVector_Allocator(inner_alty_traits::select_on_container_copy_construction(m_alloc));
+	}
+
+	NODISCARD T* inline_data() noexcept
+	{
+		return reinterpret_cast<T*>(m_buffer);
+	}
+
+	NODISCARD const T* inline_data() const noexcept
+	{
+		return reinterpret_cast<const T*>(m_buffer);
+	}
+
+	NODISCARD bool operator==(const JSmallVector_Allocator &other) const noexcept
+	{
+		return this == _STD addressof(other);
+	}
+
+	NODISCARD bool operator!=(const JSmallVector_Allocator &other) const noexcept
+	{
+		return !(*this == other);
+	}
+};
+
+// JSmallVector keeps up to N elements inline and moves them to the heap only when it outgrows them.
+// Growth, insert and erase are those of JVector, the inline buffer is provided by its allocator.
+// Heap buffers are exchanged with JVector<T, Alloc, Growth> without copying the elements.
+// The JVector base is private: swapping or assigning through it would hand the inline buffer to another vector.
+// For the same reason adopt() and release() are not offered, to_vector() hands the elements out instead.
+template <class T, _STD size_t N, class Alloc = _STD allocator<T>, class Growth = JSTD::default_growth>
+class JSmallVector : private JVector<T, JSmallVector_Allocator<T, N, Alloc>, Growth>
+{
+private:
+	static_assert(N != 0, "JSmallVector needs an inline capacity, use JVector otherwise.");
+
+	using my_base   = JVector<T, JSmallVector_Allocator<T, N, Alloc>, Growth>;
+	using my_vector = JVector<T, Alloc, Growth>;
+
+public:
+	using typename my_base::value_type;
+	using typename my_base::allocator_type;
+	using typename my_base::pointer;
+	using typename my_base::const_pointer;
+	using typename my_base::reference;
+	using typename my_base::const_reference;
+	using typename my_base::size_type;
+	using typename my_base::difference_type;
+	using typename my_base::iterator;
+	using typename my_base::const_iterator;
+	using typename my_base::reverse_iterator;
+	using typename my_base::const_reverse_iterator;
+
+	using my_base::assign;
+	using my_base::get_allocator;
+	using my_base::at;
+	using my_base::operator[];
+	using my_base::front;
+	using my_base::back;
+	using my_base::data;
+	using my_base::begin;
+	using my_base::end;
+	using my_base::rbegin;
+	using my_base::rend;
+	using my_base::cbegin;
+	using my_base::cend;
+	using my_base::crbegin;
+	using my_base::crend;
+	using my_base::empty;
+	using my_base::size;
+	using my_base::max_size;
+	using my_base::reserve;
+	using my_base::capacity;
+	using my_base::clear;
+	using my_base::insert;
+#ifdef __cpp_lib_ranges
+	using my_base::append_range;
+#endif // __cpp_lib_ranges
+	using my_base::emplace;
+	using my_base::emplace_back;
+	using my_base::erase;
+	using my_base::push_back;
+	using my_base::pop_back;
+	using my_base::resize;
+	using my_base::resize_default_init;
+	using my_base::resize_and_overwrite;
+
+	JSmallVector() noexcept;
+
+	explicit JSmallVector(const Alloc &al) noexcept;
+
+	explicit JSmallVector(size_type count);
+
+	JSmallVector(size_type count, const T &value);
+
+	template <class Iter, class = _STD enable_if_t<JSTD::is_iterator_v<Iter>>>
+	JSmallVector(Iter first, Iter last);
+
+	JSmallVector(_STD initializer_list<T> init);
+
+	JSmallVector(const JSmallVector &other);
+
+	JSmallVector(JSmallVector &&other) noexcept(_STD is_nothrow_move_constructible_v<T>);
+
+	explicit JSmallVector(const my_vector &other);
+
+	explicit JSmallVector(my_vector &&other);
+
+	JSmallVector& operator=(const JSmallVector &other);
+
+	JSmallVector& operator=(JSmallVector &&other)
+		noexcept(_STD is_nothrow_move_constructible_v<T> && _STD is_nothrow_move_assignable_v<T>);
+
+	JSmallVector& operator=(_STD initializer_list<T> ilist);
+
+	NODISCARD static constexpr size_type inline_capacity() noexcept;
+
+	NODISCARD bool is_inline() const noexcept;
+
+	void shrink_to_fit();
+
+	void swap(JSmallVector &other)
+		noexcept(_STD is_nothrow_move_constructible_v<T> && _STD is_nothrow_move_assignable_v<T>);
+
+	NODISCARD my_vector to_vector() const &;
+
+	NODISCARD my_vector to_vector() &&;
+
+	NODISCARD friend bool operator==(const JSmallVector &left, const JSmallVector &right)
+	{
+		return static_cast<const my_base&>(left) == static_cast<const my_base&>(right);
+	}
+
+	NODISCARD friend bool operator!=(const JSmallVector &left, const JSmallVector &right)
+	{
+		return !(left == right);
+	}
+
+	NODISCARD friend bool operator<(const JSmallVector &left, const JSmallVector &right)
+	{
+		return static_cast<const my_base&>(left) < static_cast<const my_base&>(right);
+	}
+
+	NODISCARD friend bool operator>(const JSmallVector &left, const JSmallVector &right)
+	{
+		return right < left;
+	}
+
+	NODISCARD friend bool operator<=(const JSmallVector &left, const JSmallVector &right)
+	{
+		return !(right < left);
+	}
+
+	NODISCARD friend bool operator>=(const JSmallVector &left, const JSmallVector &right)
+	{
+		return !(left < right);
+	}
+
+private:
+	void reset_to_inline() noexcept;
+
+	template <class Vector, class InnerAlloc>
+	void take_heap_buffer(Vector &other, InnerAlloc &other_al) noexcept;
+
+	template <class Vector>
+	void take_elements(Vector &other);
+};
+
+template <class T, _STD size_t N, class Alloc, class Growth>
+inline
+JSmallVector<T, N, Alloc, Growth>::JSmallVector() noexcept
+	: my_base()
+{
+	reset_to_inline();
+}
+
+template <class T, _STD size_t N, class Alloc, class Growth>
+inline
+JSmallVector<T, N, Alloc, Growth>::JSmallVector(const Alloc &al) noexcept
+	: my_base(JSmallVector_Allocator<T, N, Alloc>(al))
+{
+	reset_to_inline();
+}
+
+template <class T, _STD size_t N, class Alloc, class Growth>
+inline
+JSmallVector<T, N, Alloc, Growth>::JSmallVector(size_type count)
+	: JSmallVector()
+{
+	this->resize(count);
+}
+
+template <class T, _STD size_t N, class Alloc, class Growth>
+inline
+JSmallVector<T, N, Alloc, Growth>::JSmallVector(size_type count, const T &value)
+	: JSmallVector()
+{
+	this->resize(count, value);
+}
+
+template <class T, _STD size_t N, class Alloc, class Growth>
+template <class Iter, class>
+inline
+JSmallVector<T, N, Alloc, Growth>::JSmallVector(Iter first, Iter last)
+	: JSmallVector()
+{
+	this->assign(first, last);
+}
+
+template <class T, _STD size_t N, class Alloc, class Growth>
+inline
+JSmallVector<T, N, Alloc, Growth>::JSmallVector(_STD initializer_list<T> init)
+	: JSmallVector()
+{
+	my_base::operator=(init);
+}
+
+template <class T, _STD size_t N, class Alloc, class Growth>
+inline
+JSmallVector<T, N, Alloc, Growth>::JSmallVector(const JSmallVector &other)
+	: JSmallVector()
+{
+	my_base::operator=(other);
+}
+
+template <class T, _STD size_t N, class Alloc, class Growth>
+inline
+JSmallVector<T, N, Alloc, Growth>::JSmallVector(JSmallVector &&other) noexcept(_STD is_nothrow_move_constructible_v<T>)
+	: JSmallVector()
+{
+	take_elements(other);
+}
+
+template <class T, _STD size_t N, class Alloc, class Growth>
+inline
+JSmallVector<T, N, Alloc, Growth>::JSmallVector(const my_vector &other)
+	: JSmallVector()
+{
+	this->assign_range(other.m_data, other.m_data + other.m_size, other.m_size);
+}
+
+template <class T, _STD size_t N, class Alloc, class Growth>
+inline
+JSmallVector<T, N, Alloc, Growth>::JSmallVector(my_vector &&other)
+	: JSmallVector()
+{
+	take_elements(other);
+}
+
+template <class T, _STD size_t N, class Alloc, class Growth>
+inline JSmallVector<T, N, Alloc, Growth>&
+JSmallVector<T, N, Alloc, Growth>::operator=(const JSmallVector &other)
+{
+	my_base::operator=(other);
+	return *this;
+}
+
+template <class T, _STD size_t N, class Alloc, class Growth>
+inline JSmallVector<T, N, Alloc, Growth>&
+JSmallVector<T, N, Alloc, Growth>::operator=(JSmallVector &&other)
+	noexcept(_STD is_nothrow_move_constructible_v<T> && _STD is_nothrow_move_assignable_v<T>)
+{
+	if (this != _STD addressof(other))
+	{
+		take_elements(other);
+	}
+
+	return *this;
+}
+
+template <class T, _STD size_t N, class Alloc, class Growth>
+inline JSmallVector<T, N, Alloc, Growth>&
+JSmallVector<T, N, Alloc, Growth>::operator=(_STD initializer_list<T> ilist)
+{
+	my_base::operator=(ilist);
+	return *this;
+}
+
+template <class T, _STD size_t N, class Alloc, class Growth>
+inline constexpr typename JSmallVector<T, N, Alloc, Growth>::size_type
+JSmallVector<T, N, Alloc, Growth>::inline_capacity() noexcept
+{
+	return N;
+}
+
+template <class T, _STD size_t N, class Alloc, class Growth>
+inline bool
+JSmallVector<T, N, Alloc, Growth>::is_inline() const noexcept
+{
+	return this->m_data == this->get_al().inline_data();
+}
+
+template <class T, _STD size_t N, class Alloc, class Growth>
+inline void
+JSmallVector<T, N, Alloc, Growth>::shrink_to_fit()
+{
+	// Elements that fit are moved back into the inline buffer, which is free while they are on the heap.
+	if (!is_inline())
+	{
+		if (this->m_size <= N)
+		{
+			this->change_vector_capacity_to(N);
+		}
+		else
+		{
+			my_base::shrink_to_fit();
+		}
+	}
+}
+
+template <class T, _STD size_t N, class Alloc, class Growth>
+inline void
+JSmallVector<T, N, Alloc, Growth>::swap(JSmallVector &other)
+	noexcept(_STD is_nothrow_move_constructible_v<T> && _STD is_nothrow_move_assignable_v<T>)
+{
+	if (this != _STD addressof(other))
+	{
+		if (!is_inline() && !other.is_inline())
+		{
+			using _STD swap;
+			swap(this->m_data, other.m_data);
+			swap(this->m_size, other.m_size);
+			swap(this->m_capacity, other.m_capacity);
+			swap(this->get_al().m_alloc, other.get_al().m_alloc);
+		}
+		else
+		{
+			JSmallVector temp(_STD move(other));
+			other = _STD move(*this);
+			*this = _STD move(temp);
+		}
+	}
+}
+
+template <class T, _STD size_t N, class Alloc, class Growth>
+inline typename JSmallVector<T, N, Alloc, Growth>::my_vector
+JSmallVector<T, N, Alloc, Growth>::to_vector() const &
+{
+	my_vector result(this->get_al().m_alloc);
+	result.assign_range(this->m_data, this->m_data + this->m_size, this->m_size);
+	return result;
+}
+
+template <class T, _STD size_t N, class Alloc, class Growth>
+inline typename JSmallVector<T, N, Alloc, Growth>::my_vector
+JSmallVector<T, N, Alloc, Growth>::to_vector() &&
+{
+	// A heap buffer is handed over as is, inline elements have to be moved one by one.
+	my_vector result(this->get_al().m_alloc);
+
+	if (is_inline())
+	{
+		result.assign_range(
+			_STD make_move_iterator(this->m_data), _STD make_move_iterator(this->m_data + this->m_size), this->m_size);
+		this->clear();
+	}
+	else
+	{
+		result.m_data     = this->m_data;
+		result.m_size     = this->m_size;
+		result.m_capacity = this->m_capacity;
+		reset_to_inline();
+	}
+
+	return result;
+}
+
+template <class T, _STD size_t N, class Alloc, class Growth>
+inline void
+JSmallVector<T, N, Alloc, Growth>::reset_to_inline() noexcept
+{
+	// Precondition: this vector owns no heap buffer and holds no element.
+	this->get_al().m_buffer_used = true;
+	this->m_data     = this->get_al().inline_data();
+	this->m_size     = 0;
+	this->m_capacity = N;
+}
+
+template <class T, _STD size_t N, class Alloc, class Growth>
+template <class Vector, class InnerAlloc>
+inline void
+JSmallVector<T, N, Alloc, Growth>::take_heap_buffer(Vector &other, InnerAlloc &other_al) noexcept
+{
+	// other's buffer comes from the heap storage of JVector<T, Alloc>, so ours can free it.
+	this->clear();
+	this->deallocate_storage(this->m_data, this->m_capacity);
+
+	this->m_data               = other.m_data;
+	this->m_size               = other.m_size;
+	this->m_capacity           = other.m_capacity;
+	this->get_al().m_alloc     = _STD move(other_al);
+
+	other.m_data     = nullptr;
+	other.m_size     = 0;
+	other.m_capacity = 0;
+}
+
+template <class T, _STD size_t N, class Alloc, class Growth>
+template <class Vector>
+inline void
+JSmallVector<T, N, Alloc, Growth>::take_elements(Vector &other)
+{
+	// Steals a heap buffer from a JVector<T, Alloc> or JSmallVector, moves inline or small buffers element-wise.
+	if constexpr (_STD is_same_v<Vector, JSmallVector>)
+	{
+		if (!other.is_inline())
+		{
+			take_heap_buffer(other, other.get_al().m_alloc);
+			other.reset_to_inline();
+			return;
+		}
+	}
+	else
+	{
+		if (other.m_capacity > N && other.get_al() == this->get_al().m_alloc)
+		{
+			take_heap_buffer(other, other.get_al());
+			return;
+		}
+	}
+
+	this->assign_range(
+		_STD make_move_iterator(other.m_data), _STD make_move_iterator(other.m_data + other.m_size), other.m_size);
+	other.clear();
+}
+
+template <class T, _STD size_t N, class Alloc, class Growth>
+void
+swap(JSmallVector<T, N, Alloc, Growth> &left, JSmallVector<T, N, Alloc, Growth> &right) noexcept(noexcept(left.swap(right)))
+{
+	left.swap(right);
+}
+#endif // !_JSMALLVECTOR_
@@ -0,0 +1,1068 @@
+#pragma once
+#ifndef _JSOAVECTOR_
+#define _JSOAVECTOR_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "JVector.h"
+#include "JVector_View.h"
+
+_JSTD_BEGIN
+// The fields of an aggregate as a tuple of references, moved from when the aggregate is an rvalue.
+template <class Aggregate, class... Fields>
+NODISCARD auto forward_fields(Fields&... fields) noexcept
+{
+	if constexpr (_STD is_lvalue_reference_v<Aggregate>)
+	{
+		return _STD forward_as_tuple(fields...);
+	}
+	else
+	{
+		return _STD forward_as_tuple(_STD move(fields)...);
+	}
+}
+
+// Splits an aggregate of N fields, up to 8, with a structured binding.
+template <_STD size_t N, class Aggregate>
+NODISCARD auto aggregate_fields(Aggregate &&aggregate) noexcept
+{
+	static_assert(N >= 1 && N <= 8, "aggregate_fields supports aggregates of 1 to 8 fields.");
+
+	if constexpr (N == 1)
+	{
+		auto &[a] = aggregate;
+		return forward_fields<Aggregate>(a);
+	}
+	else if constexpr (N == 2)
+	{
+		auto &[a, b] = aggregate;
+		return forward_fields<Aggregate>(a, b);
+	}
+	else if constexpr (N == 3)
+	{
+		auto &[a, b, c] = aggregate;
+		return forward_fields<Aggregate>(a, b, c);
+	}
+	else if constexpr (N == 4)
+	{
+		auto &[a, b, c, d] = aggregate;
+		return forward_fields<Aggregate>(a, b, c, d);
+	}
+	else if constexpr (N == 5)
+	{
+		auto &[a, b, c, d, e] = aggregate;
+		return forward_fields<Aggregate>(a, b, c, d, e);
+	}
+	else if constexpr (N == 6)
+	{
+		auto &[a, b, c, d, e, f] = aggregate;
+		return forward_fields<Aggregate>(a, b, c, d, e, f);
+	}
+	else if constexpr (N == 7)
+	{
+		auto &[a, b, c, d, e, f, g] = aggregate;
+		return forward_fields<Aggregate>(a, b, c, d, e, f, g);
+	}
+	else
+	{
+		auto &[a, b, c, d, e, f, g, h] = aggregate;
+		return forward_fields<Aggregate>(a, b, c, d, e, f, g, h);
+	}
+}
+_JSTD_END
+
+// JSoAVector random access iterator. It refers to the vector and an index; dereferencing gives a tuple of
+// references to the fields, so it has no operator-> and algorithms that swap through references do not apply.
+template <class MyVector>
+class JSoAVector_Const_Iterator
+{
+public:
+	using iterator_category = _STD random_access_iterator_tag;
+	using value_type        = typename MyVector::value_type;
+	using difference_type   = typename MyVector::difference_type;
+	using pointer           = void;
+	using reference         = typename MyVector::const_reference;
+
+	MyVector    *vec;
+	_STD size_t index;
+
+	JSoAVector_Const_Iterator() noexcept
+		: vec(nullptr),
+		  index(0)
+		{}
+
+	JSoAVector_Const_Iterator(MyVector *vector, const _STD size_t pos) noexcept
+		: vec(vector),
+		  index(pos)
+		{}
+
+	reference operator*() const noexcept
+	{
+		return _STD as_const(*vec)[index];
+	}
+
+	reference operator[](const difference_type off) const noexcept
+	{
+		return _STD as_const(*vec)[index + off];
+	}
+
+	JSoAVector_Const_Iterator& operator++() noexcept
+	{
+		++index;
+		return *this;
+	}
+
+	JSoAVector_Const_Iterator operator++(int) noexcept
+	{
+		JSoAVector_Const_Iterator temp = *this;
+		++index;
+		return temp;
+	}
+
+	JSoAVector_Const_Iterator& operator--() noexcept
+	{
+		--index;
+		return *this;
+	}
+
+	JSoAVector_Const_Iterator operator--(int) noexcept
+	{
+		JSoAVector_Const_Iterator temp = *this;
+		--index;
+		return temp;
+	}
+
+	JSoAVector_Const_Iterator& operator+=(const difference_type off) noexcept
+	{
+		index += off;
+		return *this;
+	}
+
+	JSoAVector_Const_Iterator& operator-=(const difference_type off) noexcept
+	{
+		index -= off;
+		return *this;
+	}
+
+	NODISCARD JSoAVector_Const_Iterator operator+(const difference_type off) const noexcept
+	{
+		return JSoAVector_Const_Iterator(vec, index + off);
+	}
+
+	NODISCARD friend JSoAVector_Const_Iterator operator+(const difference_type off,
+		const JSoAVector_Const_Iterator &iter) noexcept
+	{
+		return iter + off;
+	}
+
+	NODISCARD JSoAVector_Const_Iterator operator-(const difference_type off) const noexcept
+	{
+		return JSoAVector_Const_Iterator(vec, index - off);
+	}
+
+	NODISCARD difference_type operator-(const JSoAVector_Const_Iterator &right) const noexcept
+	{
+		return static_cast<difference_type>(index) - static_cast<difference_type>(right.index);
+	}
+
+	NODISCARD bool operator==(const JSoAVector_Const_Iterator &right) const noexcept
+	{
+		return index == right.index;
+	}
+
+	NODISCARD bool operator!=(const JSoAVector_Const_Iterator &right) const noexcept
+	{
+		return index != right.index;
+	}
+
+	NODISCARD bool operator<(const JSoAVector_Const_Iterator &right) const noexcept
+	{
+		return index < right.index;
+	}
+
+	NODISCARD bool operator>(const JSoAVector_Const_Iterator &right) const noexcept
+	{
+		return index > right.index;
+	}
+
+	NODISCARD bool operator<=(const JSoAVector_Const_Iterator &right) const noexcept
+	{
+		return index <= right.index;
+	}
+
+	NODISCARD bool operator>=(const JSoAVector_Const_Iterator &right) const noexcept
+	{
+		return index >= right.index;
+	}
+};
+
+template <class MyVector>
+class JSoAVector_Iterator : public JSoAVector_Const_Iterator<MyVector>
+{
+public:
+	using my_base           = JSoAVector_Const_Iterator<MyVector>;
+
+	using iterator_category = _STD random_access_iterator_tag;
+	using value_type        = typename MyVector::value_type;
+	using difference_type   = typename MyVector::difference_type;
+	using pointer           = void;
+	using reference         = typename MyVector::reference;
+
+	using my_base::my_base;
+
+	reference operator*() const noexcept
+	{
+		return (*this->vec)[this->index];
+	}
+
+	reference operator[](const difference_type off) const noexcept
+	{
+		return (*this->vec)[this->index + off];
+	}
+
+	JSoAVector_Iterator& operator++() noexcept
+	{
+		my_base::operator++();
+		return *this;
+	}
+
+	JSoAVector_Iterator operator++(int) noexcept
+	{
+		JSoAVector_Iterator temp = *this;
+		my_base::operator++();
+		return temp;
+	}
+
+	JSoAVector_Iterator& operator--() noexcept
+	{
+		my_base::operator--();
+		return *this;
+	}
+
+	JSoAVector_Iterator operator--(int) noexcept
+	{
+		JSoAVector_Iterator temp = *this;
+		my_base::operator--();
+		return temp;
+	}
+
+	JSoAVector_Iterator& operator+=(const difference_type off) noexcept
+	{
+		my_base::operator+=(off);
+		return *this;
+	}
+
+	JSoAVector_Iterator& operator-=(const difference_type off) noexcept
+	{
+		my_base::operator-=(off);
+		return *this;
+	}
+
+	NODISCARD JSoAVector_Iterator operator+(const difference_type off) const noexcept
+	{
+		return JSoAVector_Iterator(this->vec, this->index + off);
+	}
+
+	NODISCARD friend JSoAVector_Iterator operator+(const difference_type off, const JSoAVector_Iterator &iter) noexcept
+	{
+		return iter + off;
+	}
+
+	NODISCARD JSoAVector_Iterator operator-(const difference_type off) const noexcept
+	{
+		return JSoAVector_Iterator(this->vec, this->index - off);
+	}
+
+	using my_base::operator-;
+};
+
+// Structure of arrays: element i is the i-th entry of every column, and each column is a contiguous array of one
+// field, so a loop over one field reads only that field. The columns live in one native allocation, each starting
+// on a 64 byte boundary, and grow together; they share the size and the capacity.
+// Elements are tuples: operator[] and the iterators give tuples of references, column<I>() a span of field I.
+template <class... Ts>
+class JSoAVector
+{
+private:
+	static_assert(sizeof...(Ts) != 0, "JSoAVector needs at least one column.");
+
+	using columns_type = _STD tuple<Ts*...>;
+	using indices      = _STD index_sequence_for<Ts...>;
+
+	static constexpr _STD size_t column_count = sizeof...(Ts);
+
+	// A cache line, and enough for aligned SIMD loads of any width up to AVX-512.
+	static constexpr _STD size_t column_alignment = (_STD max)({ _STD size_t(64), alignof(Ts)... });
+
+	static constexpr bool trivially_relocatable = (JSTD::is_trivially_relocatable_v<Ts> && ...);
+
+	static constexpr bool trivially_destructible = (_STD is_trivially_destructible_v<Ts> && ...);
+
+public:
+	using value_type             = _STD tuple<Ts...>;
+	using reference              = _STD tuple<Ts&...>;
+	using const_reference        = _STD tuple<const Ts&...>;
+	using size_type              = _STD size_t;
+	using difference_type        = _STD ptrdiff_t;
+	using iterator               = JSoAVector_Iterator<JSoAVector<Ts...>>;
+	using const_iterator         = JSoAVector_Const_Iterator<JSoAVector<Ts...>>;
+	using reverse_iterator       = _STD reverse_iterator<iterator>;
+	using const_reverse_iterator = _STD reverse_iterator<const_iterator>;
+
+	template <_STD size_t I>
+	using column_type = _STD tuple_element_t<I, value_type>;
+
+private:
+	size_type    m_size;
+	size_type    m_capacity;
+	void        *m_storage;
+	columns_type m_columns;
+
+	// Bytes of one allocation for capacity elements of every column.
+	NODISCARD static size_type storage_bytes(const size_type capacity) noexcept;
+
+	// Points every column into storage laid out for capacity elements.
+	NODISCARD static columns_type layout(void *storage, const size_type capacity) noexcept;
+
+	template <class Tuple, _STD size_t... I>
+	void emplace_tuple(Tuple &&tuple, _STD index_sequence<I...>);
+
+	// Constructs element pos of columns I and up from one argument each, none of them if one throws.
+	template <_STD size_t I, class Arg, class... Rest>
+	void construct_at(const size_type pos, Arg &&arg, Rest&&... rest);
+
+	template <_STD size_t I>
+	void destroy_columns_at(const size_type pos) noexcept;
+
+	void destroy_range(const size_type first, const size_type last) noexcept;
+
+	// Moves the elements into storage for new_capacity.
+	void reallocate(const size_type new_capacity);
+
+	// Relocates the columns that are copied when Moves is false, those moved without throwing when it is true.
+	template <_STD size_t I, bool Moves>
+	void relocate_columns(columns_type &to);
+
+	void tidy() noexcept;
+
+	template <_STD size_t... I>
+	NODISCARD reference make_reference(const size_type pos, _STD index_sequence<I...>) noexcept;
+
+	template <_STD size_t... I>
+	NODISCARD const_reference make_reference(const size_type pos, _STD index_sequence<I...>) const noexcept;
+
+public:
+	JSoAVector() noexcept;
+
+	explicit JSoAVector(const size_type count);
+
+	JSoAVector(const JSoAVector &other);
+
+	JSoAVector(JSoAVector &&other) noexcept;
+
+	~JSoAVector() noexcept;
+
+	JSoAVector& operator=(const JSoAVector &other);
+
+	JSoAVector& operator=(JSoAVector &&other) noexcept;
+
+	// Takes one argument per column.
+	template <class... Args>
+	reference emplace_back(Args&&... args);
+
+	void push_back(const value_type &value);
+
+	void push_back(value_type &&value);
+
+	// Takes an aggregate with one field per column, such as the struct the columns were split from.
+	template <class Aggregate, class = _STD enable_if_t<_STD is_aggregate_v<_STD remove_cv_t<_STD remove_reference_t<Aggregate>>>>>
+	void push_back(Aggregate &&aggregate);
+
+	void pop_back() noexcept;
+
+	NODISCARD reference operator[](const size_type pos) noexcept;
+
+	NODISCARD const_reference operator[](const size_type pos) const noexcept;
+
+	NODISCARD reference at(const size_type pos);
+
+	NODISCARD const_reference at(const size_type pos) const;
+
+	NODISCARD reference front() noexcept;
+
+	NODISCARD const_reference front() const noexcept;
+
+	NODISCARD reference back() noexcept;
+
+	NODISCARD const_reference back() const noexcept;
+
+	// Field I of every element, contiguous and 64 byte aligned.
+	template <_STD size_t I>
+	NODISCARD JVector_Span<column_type<I>> column() noexcept;
+
+	template <_STD size_t I>
+	NODISCARD JVector_View<column_type<I>> column() const noexcept;
+
+	template <_STD size_t I>
+	NODISCARD column_type<I>* data() noexcept;
+
+	template <_STD size_t I>
+	NODISCARD const column_type<I>* data() const noexcept;
+
+	NODISCARD iterator begin() noexcept;
+
+	NODISCARD const_iterator begin() const noexcept;
+
+	NODISCARD iterator end() noexcept;
+
+	NODISCARD const_iterator end() const noexcept;
+
+	NODISCARD reverse_iterator rbegin() noexcept;
+
+	NODISCARD const_reverse_iterator rbegin() const noexcept;
+
+	NODISCARD reverse_iterator rend() noexcept;
+
+	NODISCARD const_reverse_iterator rend() const noexcept;
+
+	NODISCARD const_iterator cbegin() const noexcept;
+
+	NODISCARD const_iterator cend() const noexcept;
+
+	NODISCARD bool empty() const noexcept;
+
+	NODISCARD size_type size() const noexcept;
+
+	NODISCARD size_type max_size() const noexcept;
+
+	NODISCARD size_type capacity() const noexcept;
+
+	void reserve(const size_type new_cap);
+
+	void shrink_to_fit();
+
+	// Value-initializes the new elements.
+	void resize(const size_type count);
+
+	void clear() noexcept;
+
+	void swap(JSoAVector &other) noexcept;
+};
+
+template <class... Ts>
+inline typename JSoAVector<Ts...>::size_type
+JSoAVector<Ts...>::storage_bytes(const size_type capacity) noexcept
+{
+	size_type bytes = 0;
+	((bytes = (bytes + column_alignment - 1) / column_alignment * column_alignment + capacity * sizeof(Ts)), ...);
+	return bytes;
+}
+
+template <class... Ts>
+inline typename JSoAVector<Ts...>::columns_type
+JSoAVector<Ts...>::layout(void *storage, const size_type capacity) noexcept
+{
+	char *base       = static_cast<char*>(storage);
+	size_type offset = 0;
+
+	// Each column starts at the next aligned offset after the one before it.
+	auto place = [&](auto *tag) {
+		using column_t = _STD remove_pointer_t<decltype(tag)>;
+		offset         = (offset + column_alignment - 1) / column_alignment * column_alignment;
+		column_t *ptr  = reinterpret_cast<column_t*>(base + offset);
+		offset        += capacity * sizeof(column_t);
+		return ptr;
+	};
+
+	return columns_type{ place(static_cast<Ts*>(nullptr))... };
+}
+
+template <class... Ts>
+template <class Tuple, _STD size_t... I>
+inline void
+JSoAVector<Ts...>::emplace_tuple(Tuple &&tuple, _STD index_sequence<I...>)
+{
+	emplace_back(_STD get<I>(_STD forward<Tuple>(tuple))...);
+}
+
+template <class... Ts>
+template <_STD size_t I, class Arg, class... Rest>
+inline void
+JSoAVector<Ts...>::construct_at(const size_type pos, Arg &&arg, Rest&&... rest)
+{
+	column_type<I> *element = _STD get<I>(m_columns) + pos;
+	::new (static_cast<void*>(element)) column_type<I>(_STD forward<Arg>(arg));
+
+	if constexpr (sizeof...(Rest) != 0)
+	{
+		try
+		{
+			construct_at<I + 1>(pos, _STD forward<Rest>(rest)...);
+		}
+		catch (...)
+		{
+			_STD destroy_at(element);
+			throw;
+		}
+	}
+}
+
+template <class... Ts>
+template <_STD size_t I>
+inline void
+JSoAVector<Ts...>::destroy_columns_at(const size_type pos) noexcept
+{
+	if constexpr (I < column_count)
+	{
+		_STD destroy_at(_STD get<I>(m_columns) + pos);
+		destroy_columns_at<I + 1>(pos);
+	}
+}
+
+template <class... Ts>
+inline void
+JSoAVector<Ts...>::destroy_range(const size_type first, const size_type last) noexcept
+{
+	if constexpr (!trivially_destructible)
+	{
+		_STD apply([&](auto*... columns) {
+			(_STD destroy(columns + first, columns + last), ...);
+		}, m_columns);
+	}
+}
+
+template <class... Ts>
+template <_STD size_t I, bool Moves>
+inline void
+JSoAVector<Ts...>::relocate_columns(columns_type &to)
+{
+	if constexpr (I < column_count)
+	{
+		using column_t = column_type<I>;
+
+		if constexpr (_STD is_nothrow_move_constructible_v<column_t> != Moves)
+		{
+			relocate_columns<I + 1, Moves>(to);
+		}
+		else
+		{
+			column_t *from = _STD get<I>(m_columns);
+			column_t *dest = _STD get<I>(to);
+			size_type pos  = 0;
+
+			// On a throw every column copied so far is destroyed, this one up to pos.
+			try
+			{
+				for (; pos < m_size; ++pos)
+				{
+					::new (static_cast<void*>(dest + pos)) column_t(_STD move_if_noexcept(from[pos]));
+				}
+
+				relocate_columns<I + 1, Moves>(to);
+			}
+			catch (...)
+			{
+				_STD destroy(dest, dest + pos);
+				throw;
+			}
+		}
+	}
+}
+
+template <class... Ts>
+inline void
+JSoAVector<Ts...>::reallocate(const size_type new_capacity)
+{
+	void *storage     = JSTD::native_allocate(storage_bytes(new_capacity), column_alignment);
+	columns_type to   = layout(storage, new_capacity);
+
+	if constexpr (trivially_relocatable)
+	{
+		_STD apply([&](auto*... dest) {
+			_STD apply([&](auto*... from) {
+				(static_cast<void>(m_size == 0 ? nullptr :
+					_STD memcpy(static_cast<void*>(dest), static_cast<const void*>(from), m_size * sizeof(*from))), ...);
+			}, m_columns);
+		}, to);
+	}
+	else
+	{
+		// Columns that may throw are copied first, so the old storage stays whole until nothing can fail.
+		try
+		{
+			relocate_columns<0, false>(to);
+		}
+		catch (...)
+		{
+			JSTD::native_deallocate(storage, storage_bytes(new_capacity), column_alignment);
+			throw;
+		}
+
+		relocate_columns<0, true>(to);
+		destroy_range(0, m_size);
+	}
+
+	JSTD::native_deallocate(m_storage, storage_bytes(m_capacity), column_alignment);
+	m_storage  = storage;
+	m_columns  = to;
+	m_capacity = new_capacity;
+}
+
+template <class... Ts>
+inline void
+JSoAVector<Ts...>::tidy() noexcept
+{
+	destroy_range(0, m_size);
+	JSTD::native_deallocate(m_storage, storage_bytes(m_capacity), column_alignment);
+	m_size     = 0;
+	m_capacity = 0;
+	m_storage  = nullptr;
+	m_columns  = columns_type{};
+}
+
+template <class... Ts>
+template <_STD size_t... I>
+inline typename JSoAVector<Ts...>::reference
+JSoAVector<Ts...>::make_reference(const size_type pos, _STD index_sequence<I...>) noexcept
+{
+	return reference(_STD get<I>(m_columns)[pos]...);
+}
+
+template <class... Ts>
+template <_STD size_t... I>
+inline typename JSoAVector<Ts...>::const_reference
+JSoAVector<Ts...>::make_reference(const size_type pos, _STD index_sequence<I...>) const noexcept
+{
+	return const_reference(_STD get<I>(m_columns)[pos]...);
+}
+
+template <class... Ts>
+inline
+JSoAVector<Ts...>::JSoAVector() noexcept
+	: m_size(0),
+	  m_capacity(0),
+	  m_storage(nullptr),
+	  m_columns()
+	{}
+
+template <class... Ts>
+inline
+JSoAVector<Ts...>::JSoAVector(const size_type count)
+	: JSoAVector()
+{
+	resize(count);
+}
+
+template <class... Ts>
+inline
+JSoAVector<Ts...>::JSoAVector(const JSoAVector &other)
+	: JSoAVector()
+{
+	try
+	{
+		reserve(other.m_size);
+
+		for (size_type pos = 0; pos < other.m_size; ++pos)
+		{
+			emplace_tuple(other[pos], indices{});
+		}
+	}
+	catch (...)
+	{
+		// Called from a constructor, where the destructor will not run.
+		tidy();
+		throw;
+	}
+}
+
+template <class... Ts>
+inline
+JSoAVector<Ts...>::JSoAVector(JSoAVector &&other) noexcept
+	: m_size(_STD exchange(other.m_size, 0)),
+	  m_capacity(_STD exchange(other.m_capacity, 0)),
+	  m_storage(_STD exchange(other.m_storage, nullptr)),
+	  m_columns(_STD exchange(other.m_columns, columns_type{}))
+	{}
+
+template <class... Ts>
+inline
+JSoAVector<Ts...>::~JSoAVector() noexcept
+{
+	tidy();
+}
+
+template <class... Ts>
+inline JSoAVector<Ts...>&
+JSoAVector<Ts...>::operator=(const JSoAVector &other)
+{
+	if (this != _STD addressof(other))
+	{
+		JSoAVector copy(other);
+		swap(copy);
+	}
+
+	return *this;
+}
+
+template <class... Ts>
+inline JSoAVector<Ts...>&
+JSoAVector<Ts...>::operator=(JSoAVector &&other) noexcept
+{
+	if (this != _STD addressof(other))
+	{
+		tidy();
+		m_size     = _STD exchange(other.m_size, 0);
+		m_capacity = _STD exchange(other.m_capacity, 0);
+		m_storage  = _STD exchange(other.m_storage, nullptr);
+		m_columns  = _STD exchange(other.m_columns, columns_type{});
+	}
+
+	return *this;
+}
+
+template <class... Ts>
+template <class... Args>
+inline typename JSoAVector<Ts...>::reference
+JSoAVector<Ts...>::emplace_back(Args&&... args)
+{
+	static_assert(sizeof...(Args) == column_count, "emplace_back takes one argument per column.");
+
+	if (m_size == m_capacity)
+	{
+		if (m_size == max_size())
+		{
+			throw _STD runtime_error("Vector too long.");
+		}
+
+		// args may refer to an element, so build the new one before the columns move.
+		value_type new_obj(_STD forward<Args>(args)...);
+		reallocate(static_cast<size_type>(
+			JSTD::default_growth::template next_capacity<value_type>(m_capacity, m_size + 1, max_size())));
+		_STD apply([&](auto&... fields) { construct_at<0>(m_size, _STD move(fields)...); }, new_obj);
+	}
+	else
+	{
+		construct_at<0>(m_size, _STD forward<Args>(args)...);
+	}
+
+	++m_size;
+	return back();
+}
+
+template <class... Ts>
+inline void
+JSoAVector<Ts...>::push_back(const value_type &value)
+{
+	emplace_tuple(value, indices{});
+}
+
+template <class... Ts>
+inline void
+JSoAVector<Ts...>::push_back(value_type &&value)
+{
+	emplace_tuple(_STD move(value), indices{});
+}
+
+template <class... Ts>
+template <class Aggregate, class>
+inline void
+JSoAVector<Ts...>::push_back(Aggregate &&aggregate)
+{
+	emplace_tuple(JSTD::aggregate_fields<column_count>(_STD forward<Aggregate>(aggregate)), indices{});
+}
+
+template <class... Ts>
+inline void
+JSoAVector<Ts...>::pop_back() noexcept
+{
+	--m_size;
+	destroy_columns_at<0>(m_size);
+}
+
+template <class... Ts>
+inline typename JSoAVector<Ts...>::reference
+JSoAVector<Ts...>::operator[](const size_type pos) noexcept
+{
+	return make_reference(pos, indices{});
+}
+
+template <class... Ts>
+inline typename JSoAVector<Ts...>::const_reference
+JSoAVector<Ts...>::operator[](const size_type pos) const noexcept
+{
+	return make_reference(pos, indices{});
+}
+
+template <class... Ts>
+inline typename JSoAVector<Ts...>::reference
+JSoAVector<Ts...>::at(const size_type pos)
+{
+	if (pos >= m_size)
+	{
+		throw _STD out_of_range("Index out of range.");
+	}
+
+	return (*this)[pos];
+}
+
+template <class... Ts>
+inline typename JSoAVector<Ts...>::const_reference
+JSoAVector<Ts...>::at(const size_type pos) const
+{
+	if (pos >= m_size)
+	{
+		throw _STD out_of_range("Index out of range.");
+	}
+
+	return (*this)[pos];
+}
+
+template <class... Ts>
+inline typename JSoAVector<Ts...>::reference
+JSoAVector<Ts...>::front() noexcept
+{
+	return (*this)[0];
+}
+
+template <class... Ts>
+inline typename JSoAVector<Ts...>::const_reference
+JSoAVector<Ts...>::front() const noexcept
+{
+	return (*this)[0];
+}
+
+template <class... Ts>
+inline typename JSoAVector<Ts...>::reference
+JSoAVector<Ts...>::back() noexcept
+{
+	return (*this)[m_size - 1];
+}
+
+template <class... Ts>
+inline typename JSoAVector<Ts...>::const_reference
+JSoAVector<Ts...>::back() const noexcept
+{
+	return (*this)[m_size - 1];
+}
+
+template <class... Ts>
+template <_STD size_t I>
+inline JVector_Span<typename JSoAVector<Ts...>::template column_type<I>>
+JSoAVector<Ts...>::column() noexcept
+{
+	return JVector_Span<column_type<I>>(_STD get<I>(m_columns), m_size);
+}
+
+template <class... Ts>
+template <_STD size_t I>
+inline JVector_View<typename JSoAVector<Ts...>::template column_type<I>>
+JSoAVector<Ts...>::column() const noexcept
+{
+	return JVector_View<column_type<I>>(_STD get<I>(m_columns), m_size);
+}
+
+template <class... Ts>
+template <_STD size_t I>
+inline typename JSoAVector<Ts...>::template column_type<I>*
+JSoAVector<Ts...>::data() noexcept
+{
+	return _STD get<I>(m_columns);
+}
+
+template <class... Ts>
+template <_STD size_t I>
+inline const typename JSoAVector<Ts...>::template column_type<I>*
+JSoAVector<Ts...>::data() const noexcept
+{
+	return _STD get<I>(m_columns);
+}
+
+template <class... Ts>
+inline typename JSoAVector<Ts...>::iterator
+JSoAVector<Ts...>::begin() noexcept
+{
+	return iterator(this, 0);
+}
+
+template <class... Ts>
+inline typename JSoAVector<Ts...>::const_iterator
+JSoAVector<Ts...>::begin() const noexcept
+{
+	// Const iterators only read through the pointer, so both iterators can share it and convert.
+	return const_iterator(const_cast<JSoAVector*>(this), 0);
+}
+
+template <class... Ts>
+inline typename JSoAVector<Ts...>::iterator
+JSoAVector<Ts...>::end() noexcept
+{
+	return iterator(this, m_size);
+}
+
+template <class... Ts>
+inline typename JSoAVector<Ts...>::const_iterator
+JSoAVector<Ts...>::end() const noexcept
+{
+	return const_iterator(const_cast<JSoAVector*>(this), m_size);
+}
+
+template <class... Ts>
+inline typename JSoAVector<Ts...>::reverse_iterator
+JSoAVector<Ts...>::rbegin() noexcept
+{
+	return reverse_iterator(end());
+}
+
+template <class... Ts>
+inline typename JSoAVector<Ts...>::const_reverse_iterator
+JSoAVector<Ts...>::rbegin() const noexcept
+{
+	return const_reverse_iterator(end());
+}
+
+template <class... Ts>
+inline typename JSoAVector<Ts...>::reverse_iterator
+JSoAVector<Ts...>::rend() noexcept
+{
+	return reverse_iterator(begin());
+}
+
+template <class... Ts>
+inline typename JSoAVector<Ts...>::const_reverse_iterator
+JSoAVector<Ts...>::rend() const noexcept
+{
+	return const_reverse_iterator(begin());
+}
+
+template <class... Ts>
+inline typename JSoAVector<Ts...>::const_iterator
+JSoAVector<Ts...>::cbegin() const noexcept
+{
+	return begin();
+}
+
+template <class... Ts>
+inline typename JSoAVector<Ts...>::const_iterator
+JSoAVector<Ts...>::cend() const noexcept
+{
+	return end();
+}
+
+template <class... Ts>
+inline bool
+JSoAVector<Ts...>::empty() const noexcept
+{
+	return m_size == 0;
+}
+
+template <class... Ts>
+inline typename JSoAVector<Ts...>::size_type
+JSoAVector<Ts...>::size() const noexcept
+{
+	return m_size;
+}
+
+template <class... Ts>
+inline typename JSoAVector<Ts...>::size_type
+JSoAVector<Ts...>::max_size() const noexcept
+{
+	// Every column and the padding between them must fit in one allocation.
+	return (static_cast<size_type>(PTRDIFF_MAX) - column_count * column_alignment) / (sizeof(Ts) + ...);
+}
+
+template <class... Ts>
+inline typename JSoAVector<Ts...>::size_type
+JSoAVector<Ts...>::capacity() const noexcept
+{
+	return m_capacity;
+}
+
+template <class... Ts>
+inline void
+JSoAVector<Ts...>::reserve(const size_type new_cap)
+{
+	if (new_cap > m_capacity)
+	{
+		if (new_cap > max_size())
+		{
+			throw _STD runtime_error("Vector too long.");
+		}
+
+		reallocate(new_cap);
+	}
+}
+
+template <class... Ts>
+inline void
+JSoAVector<Ts...>::shrink_to_fit()
+{
+	if (m_capacity != m_size)
+	{
+		if (m_size == 0)
+		{
+			tidy();
+		}
+		else
+		{
+			reallocate(m_size);
+		}
+	}
+}
+
+template <class... Ts>
+inline void
+JSoAVector<Ts...>::resize(const size_type count)
+{
+	if (count < m_size)
+	{
+		destroy_range(count, m_size);
+		m_size = count;
+		return;
+	}
+
+	reserve(count);
+
+	while (m_size < count)
+	{
+		construct_at<0>(m_size, Ts()...);
+		++m_size;
+	}
+}
+
+template <class... Ts>
+inline void
+JSoAVector<Ts...>::clear() noexcept
+{
+	destroy_range(0, m_size);
+	m_size = 0;
+}
+
+template <class... Ts>
+inline void
+JSoAVector<Ts...>::swap(JSoAVector &other) noexcept
+{
+	using _STD swap;
+
+	swap(m_size, other.m_size);
+	swap(m_capacity, other.m_capacity);
+	swap(m_storage, other.m_storage);
+	swap(m_columns, other.m_columns);
+}
+
+template <class... Ts>
+void
+swap(JSoAVector<Ts...> &left, JSoAVector<Ts...> &right) noexcept
+{
+	left.swap(right);
+}
+
+#endif // !_JSOAVECTOR_
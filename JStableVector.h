@@ -0,0 +1,1015 @@
+#pragma once
+#ifndef _JSTABLEVECTOR_
+#define _JSTABLEVECTOR_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "JVector.h"
+
+_JSTD_BEGIN
+// Elements per JStableVector chunk: the largest power of two whose chunk fits in 64 KiB, at least 16.
+template <class T>
+NODISCARD constexpr _STD size_t stable_chunk_size() noexcept
+{
+	_STD size_t size = 16;
+
+	while (size * 2 * sizeof(T) <= 65536)
+	{
+		size *= 2;
+	}
+
+	return size;
+}
+
+template <class T>
+inline constexpr _STD size_t stable_chunk_size_v = stable_chunk_size<T>();
+_JSTD_END
+
+// JStableVector random access iterator. Like a deque iterator it holds the element, the start of its chunk and the
+// chunk's slot in the directory, so stepping only looks at the directory when it crosses into another chunk.
+template <class MyVector>
+class JStableVector_Const_Iterator
+{
+public:
+	using iterator_category = _STD random_access_iterator_tag;
+	using value_type        = typename MyVector::value_type;
+	using difference_type   = typename MyVector::difference_type;
+	using pointer           = typename MyVector::const_pointer;
+	using reference         = const value_type&;
+
+	using ptr_t             = typename MyVector::pointer;
+	using node_t            = const ptr_t*;
+
+	static constexpr difference_type chunk_size = static_cast<difference_type>(MyVector::chunk_size);
+
+	ptr_t  ptr;
+	ptr_t  first;
+	node_t node;
+
+	JStableVector_Const_Iterator() noexcept
+		: ptr(nullptr),
+		  first(nullptr),
+		  node(nullptr)
+		{}
+
+	JStableVector_Const_Iterator(node_t chunk, const _STD size_t offset) noexcept
+		: ptr(*chunk + offset),
+		  first(*chunk),
+		  node(chunk)
+		{}
+
+	reference operator*() const noexcept
+	{
+		return *ptr;
+	}
+
+	pointer operator->() const noexcept
+	{
+		return ptr;
+	}
+
+	reference operator[](const difference_type off) const noexcept
+	{
+		return *(*this + off);
+	}
+
+	JStableVector_Const_Iterator& operator++() noexcept
+	{
+		if (++ptr == first + chunk_size)
+		{
+			set_node(node + 1);
+			ptr = first;
+		}
+
+		return *this;
+	}
+
+	JStableVector_Const_Iterator operator++(int) noexcept
+	{
+		JStableVector_Const_Iterator temp = *this;
+		++*this;
+		return temp;
+	}
+
+	JStableVector_Const_Iterator& operator--() noexcept
+	{
+		if (ptr == first)
+		{
+			set_node(node - 1);
+			ptr = first + chunk_size;
+		}
+
+		--ptr;
+		return *this;
+	}
+
+	JStableVector_Const_Iterator operator--(int) noexcept
+	{
+		JStableVector_Const_Iterator temp = *this;
+		--*this;
+		return temp;
+	}
+
+	JStableVector_Const_Iterator& operator+=(const difference_type off) noexcept
+	{
+		const difference_type offset = (ptr - first) + off;
+
+		if (offset >= 0 && offset < chunk_size)
+		{
+			ptr += off;
+		}
+		else
+		{
+			const difference_type chunks = offset >= 0 ? offset / chunk_size : -((-offset - 1) / chunk_size) - 1;
+			set_node(node + chunks);
+			ptr = first + (offset - chunks * chunk_size);
+		}
+
+		return *this;
+	}
+
+	JStableVector_Const_Iterator& operator-=(const difference_type off) noexcept
+	{
+		return *this += -off;
+	}
+
+	NODISCARD JStableVector_Const_Iterator operator+(const difference_type off) const noexcept
+	{
+		JStableVector_Const_Iterator temp = *this;
+		return temp += off;
+	}
+
+	NODISCARD friend JStableVector_Const_Iterator operator+(const difference_type off,
+		const JStableVector_Const_Iterator &iter) noexcept
+	{
+		return iter + off;
+	}
+
+	NODISCARD JStableVector_Const_Iterator operator-(const difference_type off) const noexcept
+	{
+		JStableVector_Const_Iterator temp = *this;
+		return temp += -off;
+	}
+
+	NODISCARD difference_type operator-(const JStableVector_Const_Iterator &right) const noexcept
+	{
+		return (node - right.node) * chunk_size + (ptr - first) - (right.ptr - right.first);
+	}
+
+	NODISCARD bool operator==(const JStableVector_Const_Iterator &right) const noexcept
+	{
+		return ptr == right.ptr;
+	}
+
+	NODISCARD bool operator!=(const JStableVector_Const_Iterator &right) const noexcept
+	{
+		return ptr != right.ptr;
+	}
+
+	NODISCARD bool operator<(const JStableVector_Const_Iterator &right) const noexcept
+	{
+		return node < right.node || (node == right.node && ptr < right.ptr);
+	}
+
+	NODISCARD bool operator>(const JStableVector_Const_Iterator &right) const noexcept
+	{
+		return right < *this;
+	}
+
+	NODISCARD bool operator<=(const JStableVector_Const_Iterator &right) const noexcept
+	{
+		return !(right < *this);
+	}
+
+	NODISCARD bool operator>=(const JStableVector_Const_Iterator &right) const noexcept
+	{
+		return !(*this < right);
+	}
+
+protected:
+	void set_node(const node_t chunk) noexcept
+	{
+		node  = chunk;
+		first = *chunk;
+	}
+};
+
+template <class MyVector>
+class JStableVector_Iterator : public JStableVector_Const_Iterator<MyVector>
+{
+public:
+	using my_base           = JStableVector_Const_Iterator<MyVector>;
+
+	using iterator_category = _STD random_access_iterator_tag;
+	using value_type        = typename MyVector::value_type;
+	using difference_type   = typename MyVector::difference_type;
+	using pointer           = typename MyVector::pointer;
+	using reference         = value_type&;
+
+	using my_base::my_base;
+
+	reference operator*() const noexcept
+	{
+		return *this->ptr;
+	}
+
+	pointer operator->() const noexcept
+	{
+		return this->ptr;
+	}
+
+	reference operator[](const difference_type off) const noexcept
+	{
+		return *(*this + off);
+	}
+
+	JStableVector_Iterator& operator++() noexcept
+	{
+		my_base::operator++();
+		return *this;
+	}
+
+	JStableVector_Iterator operator++(int) noexcept
+	{
+		JStableVector_Iterator temp = *this;
+		my_base::operator++();
+		return temp;
+	}
+
+	JStableVector_Iterator& operator--() noexcept
+	{
+		my_base::operator--();
+		return *this;
+	}
+
+	JStableVector_Iterator operator--(int) noexcept
+	{
+		JStableVector_Iterator temp = *this;
+		my_base::operator--();
+		return temp;
+	}
+
+	JStableVector_Iterator& operator+=(const difference_type off) noexcept
+	{
+		my_base::operator+=(off);
+		return *this;
+	}
+
+	JStableVector_Iterator& operator-=(const difference_type off) noexcept
+	{
+		my_base::operator-=(off);
+		return *this;
+	}
+
+	NODISCARD JStableVector_Iterator operator+(const difference_type off) const noexcept
+	{
+		JStableVector_Iterator temp = *this;
+		return temp += off;
+	}
+
+	NODISCARD friend JStableVector_Iterator operator+(const difference_type off,
+		const JStableVector_Iterator &iter) noexcept
+	{
+		return iter + off;
+	}
+
+	NODISCARD JStableVector_Iterator operator-(const difference_type off) const noexcept
+	{
+		JStableVector_Iterator temp = *this;
+		return temp -= off;
+	}
+
+	using my_base::operator-;
+};
+
+// A vector made of fixed-size chunks found through a small directory. Growing adds a chunk and never moves
+// an element, so push_back costs the same at any size and references stay valid until the element is erased.
+// Only the directory of chunk pointers is reallocated, so iterators are invalidated by growth, as with a deque.
+// ChunkSize must be a power of two.
+template <class T, class Alloc = _STD allocator<T>, _STD size_t ChunkSize = JSTD::stable_chunk_size_v<T>>
+class JStableVector
+	: private JVector_Alloc_Holder<typename _STD allocator_traits<Alloc>::template rebind_alloc<T>>
+{
+private:
+	using alty        = typename _STD allocator_traits<Alloc>::template rebind_alloc<T>;
+	using alty_traits = _STD allocator_traits<alty>;
+	using my_base     = JVector_Alloc_Holder<alty>;
+
+	static_assert(_STD is_same_v<typename alty_traits::pointer, T*>,
+		"JStableVector requires an allocator whose pointer type is T*.");
+
+	static_assert(ChunkSize != 0 && (ChunkSize & (ChunkSize - 1)) == 0, "ChunkSize must be a power of two.");
+
+public:
+	using value_type             = T;
+	using allocator_type         = Alloc;
+	using pointer                = T*;
+	using const_pointer          = const T*;
+	using reference              = value_type&;
+	using const_reference        = const value_type&;
+	using size_type              = _STD size_t;
+	using difference_type        = _STD ptrdiff_t;
+	using iterator               = JStableVector_Iterator<JStableVector<T, Alloc, ChunkSize>>;
+	using const_iterator         = JStableVector_Const_Iterator<JStableVector<T, Alloc, ChunkSize>>;
+	using reverse_iterator       = _STD reverse_iterator<iterator>;
+	using const_reverse_iterator = _STD reverse_iterator<const_iterator>;
+
+	static constexpr size_type chunk_size = ChunkSize;
+
+private:
+	using directory_type = JVector<pointer, typename _STD allocator_traits<Alloc>::template rebind_alloc<pointer>>;
+
+	// The chunk pointers followed by a null one, so end() of a full last chunk has a slot to point at.
+	// A vector that never had a chunk uses empty_directory instead.
+	directory_type m_directory;
+	size_type      m_size;
+
+	static constexpr pointer empty_directory[1] = {};
+
+	NODISCARD size_type chunk_count() const noexcept;
+
+	NODISCARD const pointer* nodes() const noexcept;
+
+	void add_chunk();
+
+	// Copies the elements of other into an empty vector, chunk by chunk.
+	void append_chunks(const JStableVector &other);
+
+	// Destroys the elements and frees the chunks.
+	void release_all() noexcept;
+
+	NODISCARD bool equal_allocator(const JStableVector &other) const noexcept;
+
+public:
+	JStableVector() noexcept(_STD is_nothrow_default_constructible_v<alty>);
+
+	explicit JStableVector(const Alloc &al) noexcept;
+
+	JStableVector(_STD initializer_list<T> init, const Alloc &al = Alloc());
+
+	JStableVector(const JStableVector &other);
+
+	JStableVector(JStableVector &&other) noexcept;
+
+	~JStableVector() noexcept;
+
+	JStableVector& operator=(const JStableVector &other);
+
+	JStableVector& operator=(JStableVector &&other)
+		noexcept(alty_traits::propagate_on_container_move_assignment::value || alty_traits::is_always_equal::value);
+
+	NODISCARD allocator_type get_allocator() const noexcept;
+
+	// Returns a reference to the new element, valid until it is erased.
+	template <class... Args>
+	reference emplace_back(Args&&... args);
+
+	void push_back(const T &value);
+
+	void push_back(T &&value);
+
+	void pop_back() noexcept;
+
+	NODISCARD reference operator[](const size_type pos) noexcept;
+
+	NODISCARD const_reference operator[](const size_type pos) const noexcept;
+
+	NODISCARD reference at(const size_type pos);
+
+	NODISCARD const_reference at(const size_type pos) const;
+
+	NODISCARD reference front() noexcept;
+
+	NODISCARD const_reference front() const noexcept;
+
+	NODISCARD reference back() noexcept;
+
+	NODISCARD const_reference back() const noexcept;
+
+	NODISCARD iterator begin() noexcept;
+
+	NODISCARD const_iterator begin() const noexcept;
+
+	NODISCARD iterator end() noexcept;
+
+	NODISCARD const_iterator end() const noexcept;
+
+	NODISCARD reverse_iterator rbegin() noexcept;
+
+	NODISCARD const_reverse_iterator rbegin() const noexcept;
+
+	NODISCARD reverse_iterator rend() noexcept;
+
+	NODISCARD const_reverse_iterator rend() const noexcept;
+
+	NODISCARD const_iterator cbegin() const noexcept;
+
+	NODISCARD const_iterator cend() const noexcept;
+
+	NODISCARD bool empty() const noexcept;
+
+	NODISCARD size_type size() const noexcept;
+
+	NODISCARD size_type max_size() const noexcept;
+
+	// Allocates the chunks for count elements ahead of the appends.
+	void reserve(const size_type count);
+
+	NODISCARD size_type capacity() const noexcept;
+
+	// Frees the chunks past the last element.
+	void shrink_to_fit();
+
+	// Destroys the elements and keeps the chunks.
+	void clear() noexcept;
+
+	void swap(JStableVector &other) noexcept;
+
+	// Copies the elements into one contiguous JVector.
+	NODISCARD JVector<T, Alloc> to_vector() const &;
+
+	// Moves the elements into one contiguous JVector, leaving this vector empty with its chunks.
+	NODISCARD JVector<T, Alloc> to_vector() &&;
+};
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline typename JStableVector<T, Alloc, ChunkSize>::size_type
+JStableVector<T, Alloc, ChunkSize>::chunk_count() const noexcept
+{
+	return m_directory.empty() ? 0 : m_directory.size() - 1;
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline const typename JStableVector<T, Alloc, ChunkSize>::pointer*
+JStableVector<T, Alloc, ChunkSize>::nodes() const noexcept
+{
+	return m_directory.empty() ? empty_directory : m_directory.data();
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline void
+JStableVector<T, Alloc, ChunkSize>::add_chunk()
+{
+	pointer chunk = alty_traits::allocate(this->get_al(), chunk_size);
+
+	try
+	{
+		// The new null slot goes in first, so a throw leaves the directory as it was.
+		if (m_directory.empty())
+		{
+			m_directory.push_back(nullptr);
+		}
+
+		m_directory.push_back(nullptr);
+	}
+	catch (...)
+	{
+		alty_traits::deallocate(this->get_al(), chunk, chunk_size);
+		throw;
+	}
+
+	m_directory[m_directory.size() - 2] = chunk;
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline void
+JStableVector<T, Alloc, ChunkSize>::append_chunks(const JStableVector &other)
+{
+	reserve(other.m_size);
+
+	for (size_type start = 0; start < other.m_size; start += chunk_size)
+	{
+		const size_type count = (_STD min)(chunk_size, other.m_size - start);
+		const_pointer from    = other.m_directory[start / chunk_size];
+		pointer to            = m_directory[start / chunk_size];
+
+		if constexpr (_STD is_trivially_copyable_v<T>)
+		{
+			_STD memcpy(to, from, count * sizeof(T));
+			m_size += count;
+		}
+		else
+		{
+			// m_size follows each element, so a throw leaves only constructed elements to destroy.
+			for (size_type i = 0; i < count; ++i)
+			{
+				alty_traits::construct(this->get_al(), to + i, from[i]);
+				++m_size;
+			}
+		}
+	}
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline void
+JStableVector<T, Alloc, ChunkSize>::release_all() noexcept
+{
+	clear();
+
+	for (size_type chunk = 0; chunk < chunk_count(); ++chunk)
+	{
+		alty_traits::deallocate(this->get_al(), m_directory[chunk], chunk_size);
+	}
+
+	m_directory.clear();
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline bool
+JStableVector<T, Alloc, ChunkSize>::equal_allocator(const JStableVector &other) const noexcept
+{
+	if constexpr (alty_traits::is_always_equal::value)
+	{
+		return true;
+	}
+	else
+	{
+		return this->get_al() == other.get_al();
+	}
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline
+JStableVector<T, Alloc, ChunkSize>::JStableVector() noexcept(_STD is_nothrow_default_constructible_v<alty>)
+	: my_base(),
+	  m_directory(),
+	  m_size(0)
+	{}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline
+JStableVector<T, Alloc, ChunkSize>::JStableVector(const Alloc &al) noexcept
+	: my_base(al),
+	  m_directory(typename directory_type::allocator_type(al)),
+	  m_size(0)
+	{}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline
+JStableVector<T, Alloc, ChunkSize>::JStableVector(_STD initializer_list<T> init, const Alloc &al)
+	: JStableVector(al)
+{
+	try
+	{
+		reserve(init.size());
+
+		for (const T &value : init)
+		{
+			emplace_back(value);
+		}
+	}
+	catch (...)
+	{
+		// Called from a constructor, where the destructor will not run.
+		release_all();
+		throw;
+	}
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline
+JStableVector<T, Alloc, ChunkSize>::JStableVector(const JStableVector &other)
+	: JStableVector(static_cast<Alloc>(alty_traits::select_on_container_copy_construction(other.get_al())))
+{
+	try
+	{
+		append_chunks(other);
+	}
+	catch (...)
+	{
+		release_all();
+		throw;
+	}
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline
+JStableVector<T, Alloc, ChunkSize>::JStableVector(JStableVector &&other) noexcept
+	: my_base(_STD move(other.get_al())),
+	  m_directory(_STD move(other.m_directory)),
+	  m_size(other.m_size)
+{
+	other.m_size = 0;
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline
+JStableVector<T, Alloc, ChunkSize>::~JStableVector() noexcept
+{
+	release_all();
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline JStableVector<T, Alloc, ChunkSize>&
+JStableVector<T, Alloc, ChunkSize>::operator=(const JStableVector &other)
+{
+	if (this != _STD addressof(other))
+	{
+		if constexpr (alty_traits::propagate_on_container_copy_assignment::value)
+		{
+			if (!equal_allocator(other))
+			{
+				// The chunks go back to the allocator they came from before it is replaced.
+				release_all();
+				m_directory = directory_type(typename directory_type::allocator_type(other.get_al()));
+			}
+
+			this->get_al() = other.get_al();
+		}
+
+		clear();
+		append_chunks(other);
+	}
+
+	return *this;
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline JStableVector<T, Alloc, ChunkSize>&
+JStableVector<T, Alloc, ChunkSize>::operator=(JStableVector &&other)
+	noexcept(alty_traits::propagate_on_container_move_assignment::value || alty_traits::is_always_equal::value)
+{
+	if (this != _STD addressof(other))
+	{
+		if (alty_traits::propagate_on_container_move_assignment::value || equal_allocator(other))
+		{
+			release_all();
+
+			if constexpr (alty_traits::propagate_on_container_move_assignment::value)
+			{
+				this->get_al() = _STD move(other.get_al());
+			}
+
+			m_directory  = _STD move(other.m_directory);
+			m_size       = other.m_size;
+			other.m_size = 0;
+		}
+		else
+		{
+			// Chunks from another allocator cannot be taken over, the elements are moved one by one.
+			clear();
+			reserve(other.m_size);
+
+			for (T &value : other)
+			{
+				emplace_back(_STD move(value));
+			}
+		}
+	}
+
+	return *this;
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline typename JStableVector<T, Alloc, ChunkSize>::allocator_type
+JStableVector<T, Alloc, ChunkSize>::get_allocator() const noexcept
+{
+	return static_cast<allocator_type>(this->get_al());
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+template <class... Args>
+inline typename JStableVector<T, Alloc, ChunkSize>::reference
+JStableVector<T, Alloc, ChunkSize>::emplace_back(Args&&... args)
+{
+	const size_type chunk = m_size / chunk_size;
+
+	if (chunk == chunk_count())
+	{
+		if (m_size == max_size())
+		{
+			throw _STD runtime_error("Vector too long.");
+		}
+
+		add_chunk();
+	}
+
+	pointer element = m_directory.data()[chunk] + m_size % chunk_size;
+	alty_traits::construct(this->get_al(), element, _STD forward<Args>(args)...);
+	++m_size;
+	return *element;
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline void
+JStableVector<T, Alloc, ChunkSize>::push_back(const T &value)
+{
+	emplace_back(value);
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline void
+JStableVector<T, Alloc, ChunkSize>::push_back(T &&value)
+{
+	emplace_back(_STD move(value));
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline void
+JStableVector<T, Alloc, ChunkSize>::pop_back() noexcept
+{
+	--m_size;
+	alty_traits::destroy(this->get_al(), _STD addressof((*this)[m_size]));
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline typename JStableVector<T, Alloc, ChunkSize>::reference
+JStableVector<T, Alloc, ChunkSize>::operator[](const size_type pos) noexcept
+{
+	return m_directory.data()[pos / chunk_size][pos % chunk_size];
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline typename JStableVector<T, Alloc, ChunkSize>::const_reference
+JStableVector<T, Alloc, ChunkSize>::operator[](const size_type pos) const noexcept
+{
+	return m_directory.data()[pos / chunk_size][pos % chunk_size];
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline typename JStableVector<T, Alloc, ChunkSize>::reference
+JStableVector<T, Alloc, ChunkSize>::at(const size_type pos)
+{
+	if (pos >= m_size)
+	{
+		throw _STD out_of_range("Index out of range.");
+	}
+
+	return (*this)[pos];
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline typename JStableVector<T, Alloc, ChunkSize>::const_reference
+JStableVector<T, Alloc, ChunkSize>::at(const size_type pos) const
+{
+	if (pos >= m_size)
+	{
+		throw _STD out_of_range("Index out of range.");
+	}
+
+	return (*this)[pos];
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline typename JStableVector<T, Alloc, ChunkSize>::reference
+JStableVector<T, Alloc, ChunkSize>::front() noexcept
+{
+	return (*this)[0];
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline typename JStableVector<T, Alloc, ChunkSize>::const_reference
+JStableVector<T, Alloc, ChunkSize>::front() const noexcept
+{
+	return (*this)[0];
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline typename JStableVector<T, Alloc, ChunkSize>::reference
+JStableVector<T, Alloc, ChunkSize>::back() noexcept
+{
+	return (*this)[m_size - 1];
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline typename JStableVector<T, Alloc, ChunkSize>::const_reference
+JStableVector<T, Alloc, ChunkSize>::back() const noexcept
+{
+	return (*this)[m_size - 1];
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline typename JStableVector<T, Alloc, ChunkSize>::iterator
+JStableVector<T, Alloc, ChunkSize>::begin() noexcept
+{
+	return iterator(nodes(), 0);
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline typename JStableVector<T, Alloc, ChunkSize>::const_iterator
+JStableVector<T, Alloc, ChunkSize>::begin() const noexcept
+{
+	return const_iterator(nodes(), 0);
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline typename JStableVector<T, Alloc, ChunkSize>::iterator
+JStableVector<T, Alloc, ChunkSize>::end() noexcept
+{
+	// When the last chunk is full, end() lands on the null slot after it.
+	return iterator(nodes() + m_size / chunk_size, m_size % chunk_size);
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline typename JStableVector<T, Alloc, ChunkSize>::const_iterator
+JStableVector<T, Alloc, ChunkSize>::end() const noexcept
+{
+	return const_iterator(nodes() + m_size / chunk_size, m_size % chunk_size);
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline typename JStableVector<T, Alloc, ChunkSize>::reverse_iterator
+JStableVector<T, Alloc, ChunkSize>::rbegin() noexcept
+{
+	return reverse_iterator(end());
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline typename JStableVector<T, Alloc, ChunkSize>::const_reverse_iterator
+JStableVector<T, Alloc, ChunkSize>::rbegin() const noexcept
+{
+	return const_reverse_iterator(end());
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline typename JStableVector<T, Alloc, ChunkSize>::reverse_iterator
+JStableVector<T, Alloc, ChunkSize>::rend() noexcept
+{
+	return reverse_iterator(begin());
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline typename JStableVector<T, Alloc, ChunkSize>::const_reverse_iterator
+JStableVector<T, Alloc, ChunkSize>::rend() const noexcept
+{
+	return const_reverse_iterator(begin());
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline typename JStableVector<T, Alloc, ChunkSize>::const_iterator
+JStableVector<T, Alloc, ChunkSize>::cbegin() const noexcept
+{
+	return begin();
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline typename JStableVector<T, Alloc, ChunkSize>::const_iterator
+JStableVector<T, Alloc, ChunkSize>::cend() const noexcept
+{
+	return end();
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline bool
+JStableVector<T, Alloc, ChunkSize>::empty() const noexcept
+{
+	return m_size == 0;
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline typename JStableVector<T, Alloc, ChunkSize>::size_type
+JStableVector<T, Alloc, ChunkSize>::size() const noexcept
+{
+	return m_size;
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline typename JStableVector<T, Alloc, ChunkSize>::size_type
+JStableVector<T, Alloc, ChunkSize>::max_size() const noexcept
+{
+	// Iterator distances must fit in difference_type.
+	return (_STD min)(static_cast<size_type>(alty_traits::max_size(this->get_al())) / chunk_size,
+		static_cast<size_type>(PTRDIFF_MAX) / chunk_size) * chunk_size;
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline void
+JStableVector<T, Alloc, ChunkSize>::reserve(const size_type count)
+{
+	if (count > max_size())
+	{
+		throw _STD runtime_error("Vector too long.");
+	}
+
+	while (capacity() < count)
+	{
+		add_chunk();
+	}
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline typename JStableVector<T, Alloc, ChunkSize>::size_type
+JStableVector<T, Alloc, ChunkSize>::capacity() const noexcept
+{
+	return chunk_count() * chunk_size;
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline void
+JStableVector<T, Alloc, ChunkSize>::shrink_to_fit()
+{
+	const size_type needed = (m_size + chunk_size - 1) / chunk_size;
+
+	if (needed == chunk_count())
+	{
+		return;
+	}
+
+	for (size_type chunk = needed; chunk < chunk_count(); ++chunk)
+	{
+		alty_traits::deallocate(this->get_al(), m_directory[chunk], chunk_size);
+	}
+
+	if (needed == 0)
+	{
+		m_directory.clear();
+	}
+	else
+	{
+		m_directory.resize(needed + 1);
+		m_directory[needed] = nullptr;
+	}
+
+	m_directory.shrink_to_fit();
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline void
+JStableVector<T, Alloc, ChunkSize>::clear() noexcept
+{
+	if constexpr (!_STD is_trivially_destructible_v<value_type>)
+	{
+		for (size_type pos = 0; pos < m_size; ++pos)
+		{
+			alty_traits::destroy(this->get_al(), _STD addressof((*this)[pos]));
+		}
+	}
+
+	m_size = 0;
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline void
+JStableVector<T, Alloc, ChunkSize>::swap(JStableVector &other) noexcept
+{
+	if (this != _STD addressof(other))
+	{
+		using _STD swap;
+
+		if constexpr (alty_traits::propagate_on_container_swap::value)
+		{
+			swap(this->get_al(), other.get_al());
+		}
+		else
+		{
+			// Swapping vectors with unequal allocators which do not propagate is undefined behaviour.
+			assert(equal_allocator(other));
+		}
+
+		m_directory.swap(other.m_directory);
+		swap(m_size, other.m_size);
+	}
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline JVector<T, Alloc>
+JStableVector<T, Alloc, ChunkSize>::to_vector() const &
+{
+	JVector<T, Alloc> result(get_allocator());
+	result.reserve(m_size);
+
+	// One range per chunk, so trivially copyable elements are copied chunk by chunk.
+	for (size_type start = 0; start < m_size; start += chunk_size)
+	{
+		const_pointer data = m_directory[start / chunk_size];
+		result.insert(result.end(), data, data + (_STD min)(chunk_size, m_size - start));
+	}
+
+	return result;
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+inline JVector<T, Alloc>
+JStableVector<T, Alloc, ChunkSize>::to_vector() &&
+{
+	JVector<T, Alloc> result(get_allocator());
+	result.reserve(m_size);
+
+	for (size_type start = 0; start < m_size; start += chunk_size)
+	{
+		pointer data = m_directory[start / chunk_size];
+		result.insert(result.end(), _STD make_move_iterator(data),
+			_STD make_move_iterator(data + (_STD min)(chunk_size, m_size - start)));
+	}
+
+	clear();
+	return result;
+}
+
+template <class T, class Alloc, _STD size_t ChunkSize>
+void
+swap(JStableVector<T, Alloc, ChunkSize> &left, JStableVector<T, Alloc, ChunkSize> &right) noexcept
+{
+	left.swap(right);
+}
+
+#endif // !_JSTABLEVECTOR_
@@ -2,6 +2,7 @@
 #ifndef _JVECTOR_
 #define _JVECTOR_
 
+#include <algorithm>
 #include <iterator>
 #include <memory>
 #include <initializer_list>
@@ -9,14 +10,55 @@
 #include <exception>
 #include <stdexcept>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
 
-// NAMESPACE
-#define _JSTD_BEGIN namespace JSTD {
-#define _JSTD_END   }
-#define _STD       ::std::
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif // __has_include(<memory_resource>)
 
-// Useful Macro
-#define NODISCARD [[nodiscard]]
+#include "jstd_core.h"
+#include "jstd_growth.h"
+#include "jstd_memory.h"
+#include "jstd_simd.h"
+#include "jstd_stats.h"
+
+_JSTD_BEGIN
+// Types whose objects can be moved to new storage with memcpy, without running the move constructor
+// on the destination or the destructor on the source. Users may specialize it for their own types.
+template <class T>
+struct is_trivially_relocatable : _STD is_trivially_copyable<T> {};
+
+template <class T>
+struct is_trivially_relocatable<_STD unique_ptr<T, _STD default_delete<T>>> : _STD true_type {};
+
+template <class T>
+struct is_trivially_relocatable<_STD shared_ptr<T>> : _STD true_type {};
+
+template <class T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+template <class Iter, class = void>
+inline constexpr bool is_iterator_v = false;
+
+template <class Iter>
+inline constexpr bool is_iterator_v<Iter, _STD void_t<typename _STD iterator_traits<Iter>::iterator_category>> = true;
+
+template <class Iter>
+inline constexpr bool is_forward_iterator_v =
+	_STD is_convertible_v<typename _STD iterator_traits<Iter>::iterator_category, _STD forward_iterator_tag>;
+
+// With the default allocator or aligned_allocator, trivially relocatable elements are kept in native storage
+// (see jstd_memory.h), which can grow with realloc or mremap instead of allocate, copy and free.
+template <class T, class Alloc>
+inline constexpr bool uses_native_storage_v =
+	is_trivially_relocatable_v<T> && is_native_allocator_v<typename _STD allocator_traits<Alloc>::template rebind_alloc<T>>;
+_JSTD_END
+
+template <class T, _STD size_t N, class Alloc, class Growth>
+class JSmallVector;
 
 // JVector const iterator.
 template <class MyVector>
@@ -234,14 +276,315 @@ NODISCARD JVector_Iterator<MyVector> operator+(
 	return next += off;
 }
 
-// JVector is a class that provides mutable arrays. The allocator is not used.
+_JSTD_BEGIN
+// Maps iterators over contiguous memory to the raw pointer they wrap, void for any other iterator.
+template <class Iter>
+struct unwrapped_pointer
+{
+	using type = void;
+};
+
+template <class T>
+struct unwrapped_pointer<T*>
+{
+	using type = T*;
+};
+
+template <class MyVector>
+struct unwrapped_pointer<JVector_Const_Iterator<MyVector>>
+{
+	using type = typename MyVector::pointer;
+};
+
+template <class MyVector>
+struct unwrapped_pointer<JVector_Iterator<MyVector>>
+{
+	using type = typename MyVector::pointer;
+};
+
+template <class Iter>
+struct unwrapped_pointer<_STD move_iterator<Iter>> : unwrapped_pointer<Iter> {};
+
+template <class T>
+NODISCARD T* unwrap_pointer(T *ptr) noexcept
+{
+	return ptr;
+}
+
+template <class MyVector>
+NODISCARD typename MyVector::pointer unwrap_pointer(const JVector_Const_Iterator<MyVector> &iter) noexcept
+{
+	return iter.ptr;
+}
+
+template <class Iter>
+NODISCARD auto unwrap_pointer(const _STD move_iterator<Iter> &iter) noexcept
+{
+	return unwrap_pointer(iter.base());
+}
+_JSTD_END
+
+
+// Stores the allocator of a JVector. Empty allocators are kept as a base class so they take no space.
+template <class Alloc, bool = _STD is_empty_v<Alloc> && !_STD is_final_v<Alloc>>
+class JVector_Alloc_Holder : private Alloc
+{
+protected:
+	JVector_Alloc_Holder() noexcept(_STD is_nothrow_default_constructible_v<Alloc>)
+		: Alloc()
+		{}
+
+	explicit JVector_Alloc_Holder(const Alloc &al) noexcept
+		: Alloc(al)
+		{}
+
+	explicit JVector_Alloc_Holder(Alloc &&al) noexcept
+		: Alloc(_STD move(al))
+		{}
+
+	NODISCARD Alloc& get_al() noexcept
+	{
+		return *this;
+	}
+
+	NODISCARD const Alloc& get_al() const noexcept
+	{
+		return *this;
+	}
+};
+
+template <class Alloc>
+class JVector_Alloc_Holder<Alloc, false>
+{
+private:
+	Alloc m_alloc;
+
+protected:
+	JVector_Alloc_Holder() noexcept(_STD is_nothrow_default_constructible_v<Alloc>)
+		: m_alloc()
+		{}
+
+	explicit JVector_Alloc_Holder(const Alloc &al) noexcept
+		: m_alloc(al)
+		{}
+
+	explicit JVector_Alloc_Holder(Alloc &&al) noexcept
+		: m_alloc(_STD move(al))
+		{}
+
+	NODISCARD Alloc& get_al() noexcept
+	{
+		return m_alloc;
+	}
+
+	NODISCARD const Alloc& get_al() const noexcept
+	{
+		return m_alloc;
+	}
+};
+
+// Buffer handed out by JVector::release(): the elements and the storage holding them, destroyed and freed
+// the way the vector would have. A JVector with the same allocator takes it back with adopt().
+// A buffer from elsewhere, e.g. malloc or new[], carries the deleter that frees it instead.
 template <class T, class Alloc = _STD allocator<T>>
+class JVector_Buffer
+{
+private:
+	using alty        = typename _STD allocator_traits<Alloc>::template rebind_alloc<T>;
+	using alty_traits = _STD allocator_traits<alty>;
+
+public:
+	using value_type     = T;
+	using allocator_type = Alloc;
+	using pointer        = T*;
+	using size_type      = typename alty_traits::size_type;
+
+	// Frees the storage of a buffer from elsewhere, after its elements were destroyed.
+	using deleter_type   = void (*)(pointer data, size_type capacity);
+
+	JVector_Buffer() noexcept(_STD is_nothrow_default_constructible_v<alty>)
+		: m_data(nullptr),
+		  m_size(0),
+		  m_capacity(0),
+		  m_deleter(nullptr),
+		  m_alloc()
+		{}
+
+	JVector_Buffer(pointer data, const size_type size, const size_type capacity, const Alloc &al) noexcept
+		: m_data(data),
+		  m_size(size),
+		  m_capacity(capacity),
+		  m_deleter(nullptr),
+		  m_alloc(al)
+		{}
+
+	JVector_Buffer(pointer data, const size_type size, const size_type capacity, const deleter_type deleter,
+		const Alloc &al = Alloc()) noexcept
+		: m_data(data),
+		  m_size(size),
+		  m_capacity(capacity),
+		  m_deleter(deleter),
+		  m_alloc(al)
+		{}
+
+	JVector_Buffer(JVector_Buffer &&other) noexcept
+		: m_data(_STD exchange(other.m_data, nullptr)),
+		  m_size(_STD exchange(other.m_size, 0)),
+		  m_capacity(_STD exchange(other.m_capacity, 0)),
+		  m_deleter(_STD exchange(other.m_deleter, nullptr)),
+		  m_alloc(other.m_alloc)
+		{}
+
+	JVector_Buffer& operator=(JVector_Buffer &&other) noexcept
+	{
+		if (this != &other)
+		{
+			reset();
+			m_data     = _STD exchange(other.m_data, nullptr);
+			m_size     = _STD exchange(other.m_size, 0);
+			m_capacity = _STD exchange(other.m_capacity, 0);
+			m_deleter  = _STD exchange(other.m_deleter, nullptr);
+			m_alloc    = other.m_alloc;
+		}
+
+		return *this;
+	}
+
+	JVector_Buffer(const JVector_Buffer&) = delete;
+	JVector_Buffer& operator=(const JVector_Buffer&) = delete;
+
+	~JVector_Buffer()
+	{
+		reset();
+	}
+
+	NODISCARD pointer data() const noexcept
+	{
+		return m_data;
+	}
+
+	NODISCARD size_type size() const noexcept
+	{
+		return m_size;
+	}
+
+	NODISCARD size_type capacity() const noexcept
+	{
+		return m_capacity;
+	}
+
+	NODISCARD bool empty() const noexcept
+	{
+		return m_size == 0;
+	}
+
+	NODISCARD allocator_type get_allocator() const noexcept
+	{
+		return static_cast<allocator_type>(m_alloc);
+	}
+
+	// Null for storage of a JVector<T, Alloc>.
+	NODISCARD deleter_type get_deleter() const noexcept
+	{
+		return m_deleter;
+	}
+
+	// Gives up ownership. The caller destroys the elements and frees the storage,
+	// with get_deleter() if it has one and with deallocate() otherwise.
+	NODISCARD pointer release() noexcept
+	{
+		m_size     = 0;
+		m_capacity = 0;
+		m_deleter  = nullptr;
+		return _STD exchange(m_data, nullptr);
+	}
+
+	// Frees storage for capacity elements obtained by a JVector<T, Alloc>.
+	static void deallocate(alty &al, pointer data, const size_type capacity) noexcept
+	{
+		if constexpr (JSTD::uses_native_storage_v<T, Alloc>)
+		{
+			JSTD::native_deallocate(data, capacity * sizeof(T), JSTD::storage_alignment_v<alty>);
+		}
+		else if (data != nullptr)
+		{
+			alty_traits::deallocate(al, data, capacity);
+		}
+	}
+
+private:
+	void reset() noexcept
+	{
+		if constexpr (!_STD is_trivially_destructible_v<T>)
+		{
+			for (size_type i = 0; i < m_size; ++i)
+			{
+				alty_traits::destroy(m_alloc, m_data + i);
+			}
+		}
+
+		if (m_deleter != nullptr)
+		{
+			m_deleter(m_data, m_capacity);
+		}
+		else
+		{
+			deallocate(m_alloc, m_data, m_capacity);
+		}
+
+		m_data     = nullptr;
+		m_size     = 0;
+		m_capacity = 0;
+		m_deleter  = nullptr;
+	}
+
+	pointer      m_data;
+	size_type    m_size;
+	size_type    m_capacity;
+	deleter_type m_deleter;
+	alty         m_alloc;
+};
+
+// JVector is a class that provides mutable arrays.
+// Storage is obtained from the allocator and only the elements in [0, size()) are constructed.
+template <class T, class Alloc = _STD allocator<T>, class Growth = JSTD::default_growth>
 class JVector
+	: private JVector_Alloc_Holder<typename _STD allocator_traits<Alloc>::template rebind_alloc<T>>
 {
 private:
 	using alty                   = typename _STD allocator_traits<Alloc>::template rebind_alloc<T>;
 	using alty_traits            = _STD allocator_traits<alty>;
-	
+	using my_base                = JVector_Alloc_Holder<alty>;
+
+	static_assert(_STD is_same_v<typename alty_traits::pointer, T*>,
+		"JVector requires an allocator whose pointer type is T*.");
+
+	// Relocation bypasses the allocator's construct() and destroy().
+	static constexpr bool trivially_relocatable = JSTD::is_trivially_relocatable_v<T>;
+
+	static constexpr bool use_native_storage = JSTD::uses_native_storage_v<T, Alloc>;
+
+	// Arena buffers are never freed one by one, they go back with the arena's reset().
+	static constexpr bool use_arena_storage = JSTD::is_arena_allocator_v<alty>;
+
+	// Alignment of every buffer, larger than alignof(T) with aligned_allocator.
+	static constexpr _STD size_t storage_alignment = JSTD::storage_alignment_v<alty>;
+
+	// Ranges of T over contiguous memory are copied with memcpy when T is trivially copyable.
+	template <class Iter>
+	static constexpr bool memcpy_from =
+		_STD is_trivially_copyable_v<T>
+		&& _STD is_same_v<_STD remove_cv_t<_STD remove_pointer_t<typename JSTD::unwrapped_pointer<Iter>::type>>, T>;
+
+	// Selects default-initialization instead of value-initialization in construct_one().
+	struct default_init_t {};
+
+	// Value-initialization and copies of one value of a trivially copyable T are written by JSTD::simd_fill.
+	template <class... Args>
+	static constexpr bool fill_with_simd =
+		_STD is_trivially_copyable_v<T>
+		&& (sizeof...(Args) == 0 || (sizeof...(Args) == 1 && (_STD is_same_v<Args, T> && ...)));
+
 public:
 	using value_type             = T;
 	using allocator_type         = Alloc;
@@ -251,12 +594,16 @@ public:
 	using const_reference        = const value_type&;
 	using size_type              = typename alty_traits::size_type;
 	using difference_type        = typename alty_traits::difference_type;
-	using iterator               = JVector_Iterator<JVector<T, Alloc>>;
-	using const_iterator         = JVector_Const_Iterator<JVector<T, Alloc>>;
+	using iterator               = JVector_Iterator<JVector<T, Alloc, Growth>>;
+	using const_iterator         = JVector_Const_Iterator<JVector<T, Alloc, Growth>>;
 	using reverse_iterator       = _STD reverse_iterator<iterator>;
 	using const_reverse_iterator = _STD reverse_iterator<const_iterator>;
 
 private:
+	// JSmallVector reuses the algorithms of JVector and takes over heap buffers from it.
+	template <class, _STD size_t, class, class>
+	friend class JSmallVector;
+
 	size_type m_size;
 	size_type m_capacity;
 	pointer   m_data;
@@ -264,48 +611,104 @@ private:
 public:
 	JVector() noexcept(_STD is_nothrow_default_constructible_v<alty>);
 
+	explicit JVector(const Alloc &al) noexcept;
+
 private:
-	template <class Iter, class DestT>
-	void copy_range(Iter from, Iter to, DestT destination);
+	// JVECTOR_STATS counters of this instantiation, empty without it.
+	static void record(const JSTD::vector_counter counter, const _STD uint64_t amount) noexcept;
+
+	void record_capacity() const noexcept;
+
+	NODISCARD JSTD::allocation_result<pointer, size_type> allocate_storage(const size_type count);
+
+	void deallocate_storage(pointer ptr, const size_type count) noexcept;
+
+	void reallocate_native(const size_type new_capacity);
+
+	template <class... Args>
+	void construct_one(pointer ptr, Args&&... args);
+
+	void construct_one(pointer ptr, default_init_t);
+
+	template <class... Args>
+	pointer construct_n(pointer dest, size_type count, const Args&... args);
+
+	template <class Iter, class Sent>
+	pointer uninitialized_copy_range(Iter from, Sent to, pointer dest);
+
+	pointer uninitialized_move_range(pointer first, pointer last, pointer dest);
+
+	pointer relocate_range(pointer first, pointer last, pointer dest);
+
+	void destroy_relocated_range(pointer first, pointer last) noexcept;
+
+	void relocate_within(pointer first, pointer last, pointer dest) noexcept;
+
+	template <class Iter, class Sent>
+	void copy_range(Iter from, Sent to, pointer dest);
 
 	template <class Iter>
 	void assign_copy_range(Iter from, Iter to, const value_type &value);
 
 public:
-	explicit JVector(size_type count);
+	explicit JVector(size_type count, const Alloc &al = Alloc());
 
-	JVector(size_type count, const T &value);
+	JVector(size_type count, const T &value, const Alloc &al = Alloc());
 
 private:
 	template <class Iter>
 	void range_construct(Iter from, Iter to);
 
 public:
-	JVector(_STD initializer_list<T> init);
+	template <class Iter, class = _STD enable_if_t<JSTD::is_iterator_v<Iter>>>
+	JVector(Iter first, Iter last, const Alloc &al = Alloc());
+
+	JVector(_STD initializer_list<T> init, const Alloc &al = Alloc());
 
 	JVector(const JVector &other);
 
+	JVector(const JVector &other, const Alloc &al);
+
 	JVector(JVector &&other) noexcept;
 
+	JVector(JVector &&other, const Alloc &al);
+
 	~JVector() noexcept;
 
 private:
+	void destroy_range(pointer first, pointer last) noexcept;
+
 	template <class Iter>
-	void destroy_range(Iter first, Iter last);
-	
+	void assign_range(Iter first, Iter last, const size_type count);
+
+	NODISCARD bool equal_allocator(const JVector &other) const noexcept;
+
+	template <class Iter>
+	void assign_input_range(Iter first, Iter last);
+
 public:
 	void assign(size_type count, const T &value);
 
+	template <class Iter, class = _STD enable_if_t<JSTD::is_iterator_v<Iter>>>
+	void assign(Iter first, Iter last);
+
+	void assign(_STD initializer_list<T> ilist);
+
 	JVector& operator=(const JVector &other);
 
 private:
 	void destroy_all_members() noexcept;
 
+	void steal_members(JVector &other) noexcept;
+
 public:
-	JVector& operator=(JVector &&other) noexcept;
+	JVector& operator=(JVector &&other)
+		noexcept(alty_traits::propagate_on_container_move_assignment::value || alty_traits::is_always_equal::value);
 
 	JVector& operator=(_STD initializer_list<T> ilist);
 
+	NODISCARD allocator_type get_allocator() const noexcept;
+
 protected:
 	void check_range(size_type n) const;
 
@@ -319,7 +722,7 @@ public:
 	NODISCARD const_reference operator[](const size_type pos) const;
 
 	NODISCARD reference front() noexcept;
-	
+
 	NODISCARD reference front() const noexcept;
 
 	NODISCARD reference back() noexcept;
@@ -329,7 +732,7 @@ public:
 	NODISCARD pointer data() noexcept;
 
 	NODISCARD const pointer data() const noexcept;
-	
+
 	NODISCARD iterator begin() noexcept;
 
 	NODISCARD const_iterator begin() const noexcept;
@@ -361,9 +764,11 @@ public:
 	NODISCARD size_type max_size() const noexcept;
 
 private:
-	void change_vector_capacity_to(const size_type new_capacity);
+	void change_vector_capacity_to(const size_type capacity);
+
+	void change_vector(pointer new_vector, size_type new_size, size_type new_capacity) noexcept;
 
-	void change_vector(pointer new_vector, size_type new_size, size_type new_capacity);
+	void change_vector_relocated(pointer new_vector, size_type new_size, size_type new_capacity) noexcept;
 
 public:
 	void reserve(const size_type new_cap);
@@ -383,15 +788,32 @@ private:
 
 	pointer move_range(pointer first, pointer last, pointer dest);
 
-	template <class Iter>
-	void rmove(Iter first, Iter last, pointer dest);
+	void rmove(pointer first, pointer last, pointer dest_last);
 
 public:
 	iterator insert(const_iterator pos, size_type count, const T &value);
 
+private:
+	template <class Iter, class Sent>
+	pointer insert_counted_range(const pointer pos, Iter first, Sent last, const size_type count);
+
+	template <class Iter>
+	pointer insert_input_range(const pointer pos, Iter first, Iter last);
+
+public:
+	template <class Iter, class = _STD enable_if_t<JSTD::is_iterator_v<Iter>>>
+	iterator insert(const_iterator pos, Iter first, Iter last);
+
+	iterator insert(const_iterator pos, _STD initializer_list<T> ilist);
+
+#ifdef __cpp_lib_ranges
+	template <_RANGES input_range Range>
+	void append_range(Range &&range);
+#endif // __cpp_lib_ranges
+
 private:
 	template <class... Args>
-	decltype(auto) emplace_rellocate(const pointer pos, Args&&... args);
+	pointer emplace_rellocate(const pointer pos, Args&&... args);
 
 	template <class... Args>
 	decltype(auto) emplace_back_with_unused_capacity(Args&&... args);
@@ -412,330 +834,778 @@ public:
 	void push_back(T &&value);
 
 	void pop_back() noexcept;
-	
+
+private:
+	template <class... Val>
+	void resize_impl(size_type count, const Val&... value);
+
+public:
 	void resize(size_type count);
 
 	void resize(size_type count, const value_type &value);
 
+	void resize_default_init(size_type count);
+
+	template <class Operation>
+	void resize_and_overwrite(size_type count, Operation op);
+
 	void swap(JVector &other) noexcept;
+
+	// Takes over data, storage for capacity elements whose first size are constructed, and frees it like its own.
+	// The storage must come from allocate() of the vector's allocator. Trivially relocatable elements with
+	// std::allocator or aligned_allocator live in native storage instead, freed with free or munmap, so their
+	// storage must come from JSTD::native_allocate(capacity * sizeof(T), alignment of the allocator);
+	// debug builds check what they can of it. Buffers from malloc or new go to the overload with a deleter.
+	void adopt(pointer data, const size_type size, const size_type capacity);
+
+	// As above, with the allocator that obtained data.
+	void adopt(pointer data, const size_type size, const size_type capacity, const Alloc &al);
+
+	// Takes over the elements of a buffer that deleter frees, e.g. one from malloc or new[]. The vector can
+	// neither grow nor free such storage, so the elements are relocated into its own and deleter frees data.
+	// The buffer is freed even if relocating throws.
+	void adopt(pointer data, const size_type size, const size_type capacity,
+		const typename JVector_Buffer<T, Alloc>::deleter_type deleter);
+
+	// Without copying, unless the buffer carries a deleter.
+	void adopt(JVector_Buffer<T, Alloc> &&buffer);
+
+	// Hands the buffer out and leaves the vector empty, without copying or freeing anything.
+	NODISCARD JVector_Buffer<T, Alloc> release() noexcept;
 };
 
-template <class T, class Alloc>
-inline 
-JVector<T, Alloc>::JVector() noexcept(_STD is_nothrow_default_constructible_v<alty>) 
-	: m_size(), 
-	  m_capacity(), 
+template <class T, class Alloc, class Growth>
+inline
+JVector<T, Alloc, Growth>::JVector() noexcept(_STD is_nothrow_default_constructible_v<alty>)
+	: my_base(),
+	  m_size(),
+	  m_capacity(),
 	  m_data()
 	{}
 
-template <class T, class Alloc>
-template <class Iter, class DestT>
-inline 
-void JVector<T, Alloc>::copy_range(Iter from, Iter to, DestT dest)
+template <class T, class Alloc, class Growth>
+inline
+JVector<T, Alloc, Growth>::JVector(const Alloc &al) noexcept
+	: my_base(alty(al)),
+	  m_size(),
+	  m_capacity(),
+	  m_data()
+	{}
+
+template <class T, class Alloc, class Growth>
+inline void
+JVector<T, Alloc, Growth>::record(const JSTD::vector_counter counter, const _STD uint64_t amount) noexcept
 {
-	for (; from != to; ++from, ++dest)
-	{
-		*dest = *from;
-	}
+	JSTD::stats_add<JVector>(counter, amount);
 }
 
-template <class T, class Alloc>
-template <class Iter>
-inline void 
-JVector<T, Alloc>::assign_copy_range(Iter from, Iter to, const value_type &value)
+template <class T, class Alloc, class Growth>
+inline void
+JVector<T, Alloc, Growth>::record_capacity() const noexcept
+{
+	JSTD::stats_raise<JVector>(JSTD::vector_counter::peak_capacity_bytes, m_capacity * sizeof(value_type));
+}
+
+template <class T, class Alloc, class Growth>
+inline JSTD::allocation_result<typename JVector<T, Alloc, Growth>::pointer, typename JVector<T, Alloc, Growth>::size_type>
+JVector<T, Alloc, Growth>::allocate_storage(const size_type count)
 {
-	for (; from != to; ++from)
+	// Only obtains raw memory, no element is constructed here.
+	// The result holds at least count elements, the slack of the allocator is reported rather than wasted.
+	if constexpr (use_native_storage)
+	{
+		const _STD size_t bytes = count * sizeof(value_type);
+		void *ptr               = JSTD::native_allocate(bytes, storage_alignment);
+		return { static_cast<pointer>(ptr), JSTD::native_usable_size(ptr, bytes, storage_alignment) / sizeof(value_type) };
+	}
+	else
 	{
-		*from = value;
+		return JSTD::allocate_at_least(this->get_al(), count);
 	}
 }
 
-template <class T, class Alloc>
-inline 
-JVector<T, Alloc>::JVector(size_type count)
-	: m_size(count),
-	m_capacity(count),
-	m_data()
+template <class T, class Alloc, class Growth>
+inline void
+JVector<T, Alloc, Growth>::deallocate_storage(pointer ptr, const size_type count) noexcept
 {
-	// Constructs a vector with n default-inserted elements using the specified allocator.
-	if (count != 0)
+	if constexpr (use_native_storage)
 	{
-		m_data = new value_type[count]{};
+		JSTD::native_deallocate(ptr, count * sizeof(value_type), storage_alignment);
+	}
+	else if constexpr (use_arena_storage)
+	{
+		static_cast<void>(ptr);
+		static_cast<void>(count);
+	}
+	else if (ptr != nullptr)
+	{
+		alty_traits::deallocate(this->get_al(), ptr, count);
 	}
 }
 
-template <class T, class Alloc>
-inline 
-JVector<T, Alloc>::JVector(size_type count, const T &value)
-	: m_size(count),
-	m_capacity(count),
-	m_data()
+template <class T, class Alloc, class Growth>
+inline void
+JVector<T, Alloc, Growth>::reallocate_native(const size_type new_capacity)
 {
-	if (count != 0)
-	{
-		if (count > max_size())
-		{
-			throw _STD runtime_error("Vector too long.");
-		}
+	// Resizes the buffer in place if possible. The elements are relocated by the platform.
+	static_assert(use_native_storage, "reallocate_native requires native storage.");
 
-		auto vector = new value_type[count]{};
+	const _STD size_t old_bytes = m_capacity * sizeof(value_type);
+	const _STD size_t new_bytes = new_capacity * sizeof(value_type);
+	m_data     = static_cast<pointer>(JSTD::native_reallocate(m_data, old_bytes, new_bytes, storage_alignment));
+	m_capacity = JSTD::native_usable_size(m_data, new_bytes, storage_alignment) / sizeof(value_type);
 
-		try
-		{
-			assign_copy_range(vector, vector + count, value);
-		}
-		catch (...)
-		{
-			delete[] vector;
-			throw;
-		}
+	record(JSTD::vector_counter::allocations, 1);
 
-		m_data = vector;
+	if (old_bytes != 0)
+	{
+		record(JSTD::vector_counter::reallocations, 1);
+		record(JSTD::vector_counter::relocated_bytes, m_size * sizeof(value_type));
 	}
+
+	record_capacity();
 }
 
-template <class T, class Alloc>
-template <class Iter>
-inline void JVector<T, Alloc>::range_construct(Iter from, Iter to)
+template <class T, class Alloc, class Growth>
+template <class ...Args>
+inline void
+JVector<T, Alloc, Growth>::construct_one(pointer ptr, Args&&... args)
 {
-	const auto size = static_cast<size_type>(_STD distance(from, to));
-	if (size > max_size())
+	if constexpr (sizeof...(Args) == 0)
 	{
-		throw _STD runtime_error("Vector too long");
+		record(JSTD::vector_counter::value_initialized, 1);
 	}
 
-	if (size != 0)
-	{
-		auto new_vector = new value_type[size]{};
-		
-		try
-		{
-			for (auto vector_start = new_vector; from != to; ++from, ++vector_start)
-			{
-				*vector_start = *from;
-			}
-		}
-		catch (...)
-		{
-			delete[] new_vector;
-			throw;
-		}
-
-		change_vector(new_vector, size, size);
-	}
+	alty_traits::construct(this->get_al(), ptr, _STD forward<Args>(args)...);
 }
 
-template <class T, class Alloc>
-inline JVector<T, Alloc>::JVector(::std::initializer_list<T> init)
-	: m_size(),
+template <class T, class Alloc, class Growth>
+inline void
+JVector<T, Alloc, Growth>::construct_one(pointer ptr, default_init_t)
+{
+	// Trivial types are left indeterminate, so no memory is written.
+	if constexpr (_STD is_trivially_default_constructible_v<value_type>)
+	{
+		::new (static_cast<void*>(ptr)) value_type;
+	}
+	else
+	{
+		alty_traits::construct(this->get_al(), ptr);
+	}
+}
+
+template <class T, class Alloc, class Growth>
+template <class ...Args>
+inline typename JVector<T, Alloc, Growth>::pointer
+JVector<T, Alloc, Growth>::construct_n(pointer dest, size_type count, const Args&... args)
+{
+	// Constructs count elements at raw memory dest: value-initialized if args is empty,
+	// default-initialized if args is default_init_t, copies of args otherwise.
+	// If an exception is thrown, the constructed elements are destroyed.
+	if constexpr (fill_with_simd<Args...>)
+	{
+		if constexpr (sizeof...(Args) == 0)
+		{
+			JSTD::simd_fill(dest, count, value_type());
+			record(JSTD::vector_counter::value_initialized, count);
+		}
+		else
+		{
+			JSTD::simd_fill(dest, count, args...);
+		}
+
+		return dest + count;
+	}
+
+	const pointer start = dest;
+
+	try
+	{
+		for (; count != 0; --count, ++dest)
+		{
+			construct_one(dest, args...);
+		}
+	}
+	catch (...)
+	{
+		destroy_range(start, dest);
+		throw;
+	}
+
+	return dest;
+}
+
+template <class T, class Alloc, class Growth>
+template <class Iter, class Sent>
+inline typename JVector<T, Alloc, Growth>::pointer
+JVector<T, Alloc, Growth>::uninitialized_copy_range(Iter from, Sent to, pointer dest)
+{
+	if constexpr (memcpy_from<Iter> && _STD is_same_v<Iter, Sent>)
+	{
+		const auto first = JSTD::unwrap_pointer(from);
+		const auto count = static_cast<size_type>(JSTD::unwrap_pointer(to) - first);
+
+		if (count != 0)
+		{
+			JSTD::large_copy(static_cast<void*>(dest), static_cast<const void*>(first), count * sizeof(value_type));
+		}
+
+		return dest + count;
+	}
+
+	const pointer start = dest;
+
+	try
+	{
+		for (; from != to; ++from, ++dest)
+		{
+			construct_one(dest, *from);
+		}
+	}
+	catch (...)
+	{
+		destroy_range(start, dest);
+		throw;
+	}
+
+	return dest;
+}
+
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::pointer
+JVector<T, Alloc, Growth>::uninitialized_move_range(pointer first, pointer last, pointer dest)
+{
+	// Falls back to copy if the move constructor may throw, so the source is intact on failure.
+	const pointer start = dest;
+
+	try
+	{
+		for (; first != last; ++first, ++dest)
+		{
+			construct_one(dest, _STD move_if_noexcept(*first));
+		}
+	}
+	catch (...)
+	{
+		destroy_range(start, dest);
+		throw;
+	}
+
+	return dest;
+}
+
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::pointer
+JVector<T, Alloc, Growth>::relocate_range(pointer first, pointer last, pointer dest)
+{
+	// Trivially relocatable elements are copied bitwise and their sources are dead afterwards.
+	// Otherwise the sources are moved from and have to be destroyed by destroy_relocated_range().
+	if constexpr (trivially_relocatable)
+	{
+		const auto count = static_cast<size_type>(last - first);
+
+		if (count != 0)
+		{
+			JSTD::large_copy(static_cast<void*>(dest), static_cast<const void*>(first), count * sizeof(value_type));
+		}
+
+		return dest + count;
+	}
+	else
+	{
+		return uninitialized_move_range(first, last, dest);
+	}
+}
+
+template <class T, class Alloc, class Growth>
+inline void
+JVector<T, Alloc, Growth>::destroy_relocated_range(pointer first, pointer last) noexcept
+{
+	if constexpr (!trivially_relocatable)
+	{
+		destroy_range(first, last);
+	}
+}
+
+template <class T, class Alloc, class Growth>
+inline void
+JVector<T, Alloc, Growth>::relocate_within(pointer first, pointer last, pointer dest) noexcept
+{
+	// Shifts trivially relocatable elements inside the buffer. The ranges may overlap.
+	static_assert(trivially_relocatable, "relocate_within requires a trivially relocatable type.");
+
+	if (first != last)
+	{
+		_STD memmove(static_cast<void*>(dest), static_cast<const void*>(first), (last - first) * sizeof(value_type));
+		record(JSTD::vector_counter::moved_bytes, (last - first) * sizeof(value_type));
+	}
+}
+
+template <class T, class Alloc, class Growth>
+template <class Iter, class Sent>
+inline
+void JVector<T, Alloc, Growth>::copy_range(Iter from, Sent to, pointer dest)
+{
+	if constexpr (memcpy_from<Iter> && _STD is_same_v<Iter, Sent>)
+	{
+		const auto first = JSTD::unwrap_pointer(from);
+		const auto count = static_cast<size_type>(JSTD::unwrap_pointer(to) - first);
+
+		const _STD size_t bytes = count * sizeof(value_type);
+		const auto source       = reinterpret_cast<_STD uintptr_t>(first);
+		const auto target       = reinterpret_cast<_STD uintptr_t>(dest);
+
+		// A range of this vector may overlap dest. Otherwise dest holds live elements, so a large copy may stream.
+		if (source < target + bytes && target < source + bytes)
+		{
+			_STD memmove(static_cast<void*>(dest), static_cast<const void*>(first), bytes);
+		}
+		else if (count != 0)
+		{
+			JSTD::large_copy(static_cast<void*>(dest), static_cast<const void*>(first), bytes, true);
+		}
+	}
+	else
+	{
+		for (; from != to; ++from, ++dest)
+		{
+			*dest = *from;
+		}
+	}
+}
+
+template <class T, class Alloc, class Growth>
+template <class Iter>
+inline void
+JVector<T, Alloc, Growth>::assign_copy_range(Iter from, Iter to, const value_type &value)
+{
+	if constexpr (fill_with_simd<value_type> && _STD is_same_v<Iter, pointer>)
+	{
+		// Live elements are resident, so a large fill can stream past the caches.
+		JSTD::simd_fill(from, static_cast<size_type>(to - from), value, true);
+	}
+	else
+	{
+		for (; from != to; ++from)
+		{
+			*from = value;
+		}
+	}
+}
+
+template <class T, class Alloc, class Growth>
+inline
+JVector<T, Alloc, Growth>::JVector(size_type count, const Alloc &al)
+	: my_base(alty(al)),
+	m_size(),
 	m_capacity(),
 	m_data()
 {
-	range_construct(init.begin(), init.end());
+	// Constructs a vector with n default-inserted elements using the specified allocator.
+	try
+	{
+		resize_impl(count);
+	}
+	catch (...)
+	{
+		// The destructor will not run, and native storage is installed before the elements are constructed.
+		destroy_all_members();
+		throw;
+	}
 }
 
-template <class T, class Alloc>
-inline 
-JVector<T, Alloc>::JVector(const JVector &other)
-	: m_size(other.m_size),
-	m_capacity(other.m_size),
+template <class T, class Alloc, class Growth>
+inline
+JVector<T, Alloc, Growth>::JVector(size_type count, const T &value, const Alloc &al)
+	: my_base(alty(al)),
+	m_size(),
+	m_capacity(),
 	m_data()
 {
-	if (other.m_size != 0)
+	try
+	{
+		resize_impl(count, value);
+	}
+	catch (...)
+	{
+		destroy_all_members();
+		throw;
+	}
+}
+
+template <class T, class Alloc, class Growth>
+template <class Iter>
+inline void JVector<T, Alloc, Growth>::range_construct(Iter from, Iter to)
+{
+	// Input iterators can only be walked once, so they grow the vector as they go.
+	if constexpr (!JSTD::is_forward_iterator_v<Iter>)
 	{
-		auto vector = new value_type[other.m_size]{};
-		
 		try
 		{
-			copy_range(other.m_data, other.data + other.m_size, vector);
+			for (; from != to; ++from)
+			{
+				emplace_back(*from);
+			}
 		}
 		catch (...)
 		{
-			delete[] vector;
+			// Called from constructors, where the destructor will not run.
+			destroy_all_members();
 			throw;
 		}
 
-		m_data = vector;
+		return;
+	}
+
+	const auto size = static_cast<size_type>(_STD distance(from, to));
+	if (size > max_size())
+	{
+		throw _STD runtime_error("Vector too long");
+	}
+
+	if (size != 0)
+	{
+		const auto [new_vector, new_capacity] = allocate_storage(size);
+
+		try
+		{
+			uninitialized_copy_range(from, to, new_vector);
+		}
+		catch (...)
+		{
+			deallocate_storage(new_vector, new_capacity);
+			throw;
+		}
+
+		change_vector(new_vector, size, new_capacity);
 	}
 }
 
-template <class T, class Alloc>
-inline 
-JVector<T, Alloc>::JVector(JVector &&other) noexcept
-	: m_size(),
+template <class T, class Alloc, class Growth>
+template <class Iter, class>
+inline JVector<T, Alloc, Growth>::JVector(Iter first, Iter last, const Alloc &al)
+	: my_base(alty(al)),
+	m_size(),
 	m_capacity(),
 	m_data()
 {
-	swap(other);
+	range_construct(first, last);
 }
 
-template <class T, class Alloc>
-inline 
-JVector<T, Alloc>::~JVector() noexcept
+template <class T, class Alloc, class Growth>
+inline JVector<T, Alloc, Growth>::JVector(::std::initializer_list<T> init, const Alloc &al)
+	: my_base(alty(al)),
+	m_size(),
+	m_capacity(),
+	m_data()
 {
-	delete[] m_data;
+	range_construct(init.begin(), init.end());
 }
 
-template <class T, class Alloc>
-template <class Iter>
-inline void 
-JVector<T, Alloc>::destroy_range(Iter first, Iter last)
+template <class T, class Alloc, class Growth>
+inline
+JVector<T, Alloc, Growth>::JVector(const JVector &other)
+	: my_base(alty_traits::select_on_container_copy_construction(other.get_al())),
+	m_size(),
+	m_capacity(),
+	m_data()
+{
+	range_construct(other.m_data, other.m_data + other.m_size);
+}
+
+template <class T, class Alloc, class Growth>
+inline
+JVector<T, Alloc, Growth>::JVector(const JVector &other, const Alloc &al)
+	: my_base(alty(al)),
+	m_size(),
+	m_capacity(),
+	m_data()
+{
+	range_construct(other.m_data, other.m_data + other.m_size);
+}
+
+template <class T, class Alloc, class Growth>
+inline
+JVector<T, Alloc, Growth>::JVector(JVector &&other) noexcept
+	: my_base(_STD move(other.get_al())),
+	m_size(),
+	m_capacity(),
+	m_data()
+{
+	steal_members(other);
+}
+
+template <class T, class Alloc, class Growth>
+inline
+JVector<T, Alloc, Growth>::JVector(JVector &&other, const Alloc &al)
+	: my_base(alty(al)),
+	m_size(),
+	m_capacity(),
+	m_data()
+{
+	// The buffer can only be taken if our allocator is able to free it.
+	if (equal_allocator(other))
+	{
+		steal_members(other);
+	}
+	else
+	{
+		range_construct(_STD make_move_iterator(other.m_data), _STD make_move_iterator(other.m_data + other.m_size));
+	}
+}
+
+template <class T, class Alloc, class Growth>
+inline
+JVector<T, Alloc, Growth>::~JVector() noexcept
+{
+	record(JSTD::vector_counter::wasted_bytes, (m_capacity - m_size) * sizeof(value_type));
+	record(JSTD::vector_counter::destroyed, 1);
+	destroy_all_members();
+}
+
+template <class T, class Alloc, class Growth>
+inline void
+JVector<T, Alloc, Growth>::destroy_range(pointer first, pointer last) noexcept
 {
-	if constexpr (
-		!_STD is_trivially_destructible_v<typename std::iterator_traits<Iter>::value_type>)
+	if constexpr (!_STD is_trivially_destructible_v<value_type>)
 	{
 		for (; first != last; ++first)
 		{
-			first->~value_type();
+			alty_traits::destroy(this->get_al(), first);
 		}
 	}
 }
 
-template <class T, class Alloc>
-inline void 
-JVector<T, Alloc>::assign(size_type count, const T &value)
+template <class T, class Alloc, class Growth>
+template <class Iter>
+inline void
+JVector<T, Alloc, Growth>::assign_range(Iter first, Iter last, const size_type count)
 {
-	// Greater than size
-	if (count > m_size)
+	// Assigns over the live elements, constructs the rest and destroys the surplus.
+	if (count > m_capacity)
 	{
-		// If we have enough memory.
-		if (count <= m_capacity)
+		if (count > max_size())
 		{
-			const auto end_of_count = m_data + count;
+			throw _STD runtime_error("Vector too long");
+		}
 
-			// If throw an exception in assign_copy_range(), size will not be changed.
-			assign_copy_range(m_data, end_of_count, value);
-			destroy_range(end_of_count, m_data + m_size);
-			m_size = count;
+		const auto [new_vector, new_capacity] = allocate_storage(count);
+
+		try
+		{
+			uninitialized_copy_range(first, last, new_vector);
 		}
-		// Reallocate
-		else
+		catch (...)
 		{
-			auto new_vector = new value_type[count]{};
-			try
-			{
-				assign_copy_range(new_vector, new_vector + count, value);
-			}
-			catch (...)
-			{
-				delete[] new_vector;
-				throw;
-			}
-			
-			change_vector(new_vector, count, count);
+			deallocate_storage(new_vector, new_capacity);
+			throw;
 		}
+
+		change_vector(new_vector, count, new_capacity);
+	}
+	else if (count > m_size)
+	{
+		Iter mid = first;
+		_STD advance(mid, m_size);
+		copy_range(first, mid, m_data);
+		uninitialized_copy_range(mid, last, m_data + m_size);
+		m_size = count;
 	}
-	// No capacity modification, only trim.
 	else
 	{
-		assign_copy_range(m_data, m_data + count, value);
+		copy_range(first, last, m_data);
 		destroy_range(m_data + count, m_data + m_size);
 		m_size = count;
 	}
 }
 
-template <class T, class Alloc>
-inline JVector<T, Alloc>&
-JVector<T, Alloc>::operator=(const JVector &other)
+template <class T, class Alloc, class Growth>
+inline bool
+JVector<T, Alloc, Growth>::equal_allocator(const JVector &other) const noexcept
 {
-	if (this != _STD addressof(other))
+	if constexpr (alty_traits::is_always_equal::value)
 	{
-		pointer start           = m_data;
-		const pointer end       = m_data + m_size;
-		pointer other_start     = other.m_data;
-		const pointer other_end = other.m_data + other.m_size;
+		return true;
+	}
+	else
+	{
+		return this->get_al() == other.get_al();
+	}
+}
 
-		for (; start != end && other_start != other_end; ++start, ++other_start)
+template <class T, class Alloc, class Growth>
+inline void
+JVector<T, Alloc, Growth>::assign(size_type count, const T &value)
+{
+	if (count > m_capacity)
+	{
+		if (count > max_size())
 		{
-			*start = *other_start;
+			throw _STD runtime_error("Vector too long.");
 		}
 
-		destroy_range(start, end);
-		m_size = start - m_data;
+		const auto [new_vector, new_capacity] = allocate_storage(count);
 
-		for (; other_start != other_end; ++other_start)
+		try
 		{
-			emplace_back(*other_start);
+			construct_n(new_vector, count, value);
 		}
+		catch (...)
+		{
+			deallocate_storage(new_vector, new_capacity);
+			throw;
+		}
+
+		change_vector(new_vector, count, new_capacity);
+	}
+	// Greater than size, but we have enough memory.
+	else if (count > m_size)
+	{
+		// If throw an exception in assign_copy_range(), size will not be changed.
+		assign_copy_range(m_data, m_data + m_size, value);
+		construct_n(m_data + m_size, count - m_size, value);
+		m_size = count;
 	}
+	// No capacity modification, only trim.
+	else
+	{
+		assign_copy_range(m_data, m_data + count, value);
+		destroy_range(m_data + count, m_data + m_size);
+		m_size = count;
+	}
+}
 
-	return *this;
+template <class T, class Alloc, class Growth>
+template <class Iter>
+inline void
+JVector<T, Alloc, Growth>::assign_input_range(Iter first, Iter last)
+{
+	// The length is unknown: overwrite what we have, then append or trim.
+	pointer start     = m_data;
+	const pointer end = m_data + m_size;
+
+	for (; first != last && start != end; ++first, ++start)
+	{
+		*start = *first;
+	}
+
+	destroy_range(start, end);
+	m_size = start - m_data;
+
+	for (; first != last; ++first)
+	{
+		emplace_back(*first);
+	}
 }
 
-template <class T, class Alloc>
-inline void 
-JVector<T, Alloc>::destroy_all_members() noexcept
+template <class T, class Alloc, class Growth>
+template <class Iter, class>
+inline void
+JVector<T, Alloc, Growth>::assign(Iter first, Iter last)
 {
-	delete[] m_data;
-	m_data     = nullptr;
-	m_capacity = 0;
-	m_size     = 0;
+	if constexpr (JSTD::is_forward_iterator_v<Iter>)
+	{
+		assign_range(first, last, static_cast<size_type>(_STD distance(first, last)));
+	}
+	else
+	{
+		assign_input_range(first, last);
+	}
 }
 
-template <class T, class Alloc>
-inline JVector<T, Alloc>&
-JVector<T, Alloc>::operator=(JVector &&other) noexcept
+template <class T, class Alloc, class Growth>
+inline void
+JVector<T, Alloc, Growth>::assign(_STD initializer_list<T> ilist)
+{
+	assign_range(ilist.begin(), ilist.end(), static_cast<size_type>(ilist.size()));
+}
+
+template <class T, class Alloc, class Growth>
+inline JVector<T, Alloc, Growth>&
+JVector<T, Alloc, Growth>::operator=(const JVector &other)
 {
 	if (this != _STD addressof(other))
 	{
-		destroy_all_members();
-		swap(other);
+		if constexpr (alty_traits::propagate_on_container_copy_assignment::value)
+		{
+			// Memory from our allocator cannot be kept if the new allocator is unable to free it.
+			if (!equal_allocator(other))
+			{
+				destroy_all_members();
+			}
+
+			this->get_al() = other.get_al();
+		}
+
+		assign_range(other.m_data, other.m_data + other.m_size, other.m_size);
 	}
 
 	return *this;
 }
 
-template <class T, class Alloc>
-inline JVector<T, Alloc>&
-JVector<T, Alloc>::operator=(_STD initializer_list<T> ilist)
-{	
-	if (ilist.size() != 0)
+template <class T, class Alloc, class Growth>
+inline void
+JVector<T, Alloc, Growth>::destroy_all_members() noexcept
+{
+	if constexpr (use_arena_storage)
 	{
-		if (ilist.size() > m_capacity)
+		// The arena was reset and the buffer may hold someone else's objects by now, leave it alone. Destructors of
+		// the elements cannot run any more, so elements that own resources must be cleared before the reset.
+		if (this->get_al().stale())
 		{
-			if (ilist.size() > max_size())
-			{
-				throw _STD runtime_error("Vector too long");
-			}
+			assert(_STD is_trivially_destructible_v<value_type> || m_size == 0);
+			m_data     = nullptr;
+			m_capacity = 0;
+			m_size     = 0;
+			return;
+		}
+	}
+
+	destroy_range(m_data, m_data + m_size);
+	deallocate_storage(m_data, m_capacity);
+	m_data     = nullptr;
+	m_capacity = 0;
+	m_size     = 0;
+}
+
+template <class T, class Alloc, class Growth>
+inline void
+JVector<T, Alloc, Growth>::steal_members(JVector &other) noexcept
+{
+	// Precondition: this vector owns no memory.
+	m_data           = other.m_data;
+	m_size           = other.m_size;
+	m_capacity       = other.m_capacity;
+	other.m_data     = nullptr;
+	other.m_size     = 0;
+	other.m_capacity = 0;
+}
 
+template <class T, class Alloc, class Growth>
+inline JVector<T, Alloc, Growth>&
+JVector<T, Alloc, Growth>::operator=(JVector &&other)
+	noexcept(alty_traits::propagate_on_container_move_assignment::value || alty_traits::is_always_equal::value)
+{
+	if (this != _STD addressof(other))
+	{
+		if constexpr (alty_traits::propagate_on_container_move_assignment::value)
+		{
 			destroy_all_members();
-			range_construct(ilist.begin(), ilist.end());
+			this->get_al() = _STD move(other.get_al());
+			steal_members(other);
 		}
 		else
 		{
-			if (ilist.size() > m_size)
+			if (equal_allocator(other))
 			{
-				pointer start          = m_data;
-				pointer end            = m_data + m_size;
-
-				auto ilist_start       = ilist.begin();
-
-				for (; start != end; ++start)
-				{
-					*start = *ilist_start;
-				}
-
-				for (const pointer list_length_end = m_data + ilist.size(); 
-					start != list_length_end; 
-					++start, ++ilist_start)
-				{
-					::new (static_cast<void*>(start)) value_type(*ilist_start);
-					++m_size;
-				}
+				destroy_all_members();
+				steal_members(other);
 			}
+			// Different allocators, move element by element.
 			else
 			{
-				pointer start = m_data;
-				pointer end   = m_data + m_size;
-
-				for (auto &obj : ilist)
-				{
-					*start = obj;
-					++start;
-				}
-
-				destroy_range(start, end);
-				m_size = ilist.size();
+				assign_range(
+					_STD make_move_iterator(other.m_data), _STD make_move_iterator(other.m_data + other.m_size), other.m_size);
 			}
 		}
 	}
@@ -743,9 +1613,24 @@ JVector<T, Alloc>::operator=(_STD initializer_list<T> ilist)
 	return *this;
 }
 
-template <class T, class Alloc>
-inline void 
-JVector<T, Alloc>::check_range(size_type n) const
+template <class T, class Alloc, class Growth>
+inline JVector<T, Alloc, Growth>&
+JVector<T, Alloc, Growth>::operator=(_STD initializer_list<T> ilist)
+{
+	assign_range(ilist.begin(), ilist.end(), static_cast<size_type>(ilist.size()));
+	return *this;
+}
+
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::allocator_type
+JVector<T, Alloc, Growth>::get_allocator() const noexcept
+{
+	return static_cast<allocator_type>(this->get_al());
+}
+
+template <class T, class Alloc, class Growth>
+inline void
+JVector<T, Alloc, Growth>::check_range(size_type n) const
 {
 	if (n >= m_size)
 	{
@@ -753,212 +1638,252 @@ JVector<T, Alloc>::check_range(size_type n) const
 	}
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::reference 
-JVector<T, Alloc>::at(const size_type pos)
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::reference 
+JVector<T, Alloc, Growth>::at(const size_type pos)
 {
 	check_range(pos);
 	return m_data[pos];
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::const_reference
-JVector<T, Alloc>::at(const size_type pos) const
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::const_reference
+JVector<T, Alloc, Growth>::at(const size_type pos) const
 {
 	check_range(pos);
 	return m_data[pos];
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::reference 
-JVector<T, Alloc>::operator[](const size_type pos)
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::reference 
+JVector<T, Alloc, Growth>::operator[](const size_type pos)
 {
 	assert(pos < m_size);
 	return m_data[pos];
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::const_reference 
-JVector<T, Alloc>::operator[](const size_type pos) const
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::const_reference 
+JVector<T, Alloc, Growth>::operator[](const size_type pos) const
 {
 	assert(pos < m_size);
 	return m_data[pos];
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::reference 
-JVector<T, Alloc>::front() noexcept
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::reference 
+JVector<T, Alloc, Growth>::front() noexcept
 {
 	assert(m_size != 0);
 	return *m_data;
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::reference 
-JVector<T, Alloc>::front() const noexcept
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::reference 
+JVector<T, Alloc, Growth>::front() const noexcept
 {
 	assert(m_size != 0);
 	return *m_data;
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::reference 
-JVector<T, Alloc>::back() noexcept
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::reference 
+JVector<T, Alloc, Growth>::back() noexcept
 {
 	assert(m_size != 0);
 	return m_data[m_size - 1];
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::const_reference 
-JVector<T, Alloc>::back() const noexcept
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::const_reference 
+JVector<T, Alloc, Growth>::back() const noexcept
 {
 	assert(m_size != 0);
 	return m_data[m_size - 1];
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::pointer
-JVector<T, Alloc>::data() noexcept
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::pointer
+JVector<T, Alloc, Growth>::data() noexcept
 {
 	return m_data;
 }
 
-template <class T, class Alloc>
-inline const typename JVector<T, Alloc>::pointer
-JVector<T, Alloc>::data() const noexcept
+template <class T, class Alloc, class Growth>
+inline const typename JVector<T, Alloc, Growth>::pointer
+JVector<T, Alloc, Growth>::data() const noexcept
 {
 	return m_data;
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::iterator 
-JVector<T, Alloc>::begin() noexcept
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::iterator 
+JVector<T, Alloc, Growth>::begin() noexcept
 {
 	return iterator(m_data);
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::const_iterator 
-JVector<T, Alloc>::begin() const noexcept
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::const_iterator 
+JVector<T, Alloc, Growth>::begin() const noexcept
 {
 	return const_iterator(m_data);
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::iterator 
-JVector<T, Alloc>::end() noexcept
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::iterator 
+JVector<T, Alloc, Growth>::end() noexcept
 {
 	return iterator(m_data + m_size);
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::const_iterator 
-JVector<T, Alloc>::end() const noexcept
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::const_iterator 
+JVector<T, Alloc, Growth>::end() const noexcept
 {
 	return const_iterator(m_data + m_size);
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::reverse_iterator 
-JVector<T, Alloc>::rbegin() noexcept
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::reverse_iterator 
+JVector<T, Alloc, Growth>::rbegin() noexcept
 {
 	return reverse_iterator(end());
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::const_reverse_iterator 
-JVector<T, Alloc>::rbegin() const noexcept
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::const_reverse_iterator 
+JVector<T, Alloc, Growth>::rbegin() const noexcept
 {
 	return const_reverse_iterator(end());
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::reverse_iterator 
-JVector<T, Alloc>::rend() noexcept
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::reverse_iterator 
+JVector<T, Alloc, Growth>::rend() noexcept
 {
 	return reverse_iterator(begin());
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::reverse_iterator 
-JVector<T, Alloc>::rend() const noexcept
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::reverse_iterator 
+JVector<T, Alloc, Growth>::rend() const noexcept
 {
 	return const_reverse_iterator(begin());
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::const_iterator 
-JVector<T, Alloc>::cbegin() const noexcept
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::const_iterator 
+JVector<T, Alloc, Growth>::cbegin() const noexcept
 {
 	return begin();
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::const_iterator 
-JVector<T, Alloc>::cend() const noexcept
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::const_iterator 
+JVector<T, Alloc, Growth>::cend() const noexcept
 {
 	return end();
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::const_reverse_iterator 
-JVector<T, Alloc>::crbegin() const noexcept
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::const_reverse_iterator 
+JVector<T, Alloc, Growth>::crbegin() const noexcept
 {
 	return rbegin();
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::const_reverse_iterator 
-JVector<T, Alloc>::crend() const noexcept
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::const_reverse_iterator 
+JVector<T, Alloc, Growth>::crend() const noexcept
 {
 	return rend();
 }
 
-template <class T, class Alloc>
-inline bool JVector<T, Alloc>::empty() const noexcept
+template <class T, class Alloc, class Growth>
+inline bool JVector<T, Alloc, Growth>::empty() const noexcept
 {
 	return m_size == 0;
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::size_type 
-JVector<T, Alloc>::size() const noexcept
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::size_type 
+JVector<T, Alloc, Growth>::size() const noexcept
 {
 	return m_size;
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::size_type 
-JVector<T, Alloc>::max_size() const noexcept
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::size_type 
+JVector<T, Alloc, Growth>::max_size() const noexcept
 {
 	// Copy from MSVC STL.
 	return (_STD min)(
-		static_cast<size_type>((_STD numeric_limits<difference_type>::max)()), static_cast<size_type>(-1) / sizeof(value_type));
+		static_cast<size_type>((_STD numeric_limits<difference_type>::max)()), alty_traits::max_size(this->get_al()));
 }
 
-template <class T, class Alloc>
+template <class T, class Alloc, class Growth>
 inline void 
-JVector<T, Alloc>::change_vector_capacity_to(const size_type new_capacity)
+JVector<T, Alloc, Growth>::change_vector_capacity_to(const size_type capacity)
 {
-	auto new_vector = new value_type[new_capacity]{};
-	move_range(m_data, m_data + m_size, new_vector);
-	change_vector(new_vector, m_size, new_capacity);
+	if constexpr (use_native_storage)
+	{
+		reallocate_native(capacity);
+		return;
+	}
+
+	const auto [new_vector, new_capacity] = allocate_storage(capacity);
+
+	try
+	{
+		relocate_range(m_data, m_data + m_size, new_vector);
+	}
+	catch (...)
+	{
+		deallocate_storage(new_vector, new_capacity);
+		throw;
+	}
+
+	change_vector_relocated(new_vector, m_size, new_capacity);
 }
 
-template <class T, class Alloc>
+template <class T, class Alloc, class Growth>
 inline void 
-JVector<T, Alloc>::change_vector(pointer new_vector, size_type new_size, size_type new_capacity)
+JVector<T, Alloc, Growth>::change_vector(pointer new_vector, size_type new_size, size_type new_capacity) noexcept
 {
-	delete[] m_data;
+	// Destroys the old (moved-from) elements and releases the old buffer.
+	destroy_range(m_data, m_data + m_size);
+	deallocate_storage(m_data, m_capacity);
 	m_data     = new_vector;
 	m_size     = new_size;
 	m_capacity = new_capacity;
+	record(JSTD::vector_counter::allocations, 1);
+	record_capacity();
 }
 
-template <class T, class Alloc>
+template <class T, class Alloc, class Growth>
+inline void 
+JVector<T, Alloc, Growth>::change_vector_relocated(pointer new_vector, size_type new_size, size_type new_capacity) noexcept
+{
+	// Same as change_vector(), but the old elements were handed over by relocate_range().
+	if (m_capacity != 0)
+	{
+		record(JSTD::vector_counter::reallocations, 1);
+		record(JSTD::vector_counter::relocated_bytes, m_size * sizeof(value_type));
+	}
+
+	destroy_relocated_range(m_data, m_data + m_size);
+	deallocate_storage(m_data, m_capacity);
+	m_data     = new_vector;
+	m_size     = new_size;
+	m_capacity = new_capacity;
+	record(JSTD::vector_counter::allocations, 1);
+	record_capacity();
+}
+
+template <class T, class Alloc, class Growth>
 inline void 
-JVector<T, Alloc>::reserve(const size_type new_cap)
+JVector<T, Alloc, Growth>::reserve(const size_type new_cap)
 {
 	// Throws: length_error if n > max_size().
 	// After reserve(), capacity() is greater or equal to the argument of reserve if reallocation happens.
@@ -973,21 +1898,23 @@ JVector<T, Alloc>::reserve(const size_type new_cap)
 	}
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::size_type 
-JVector<T, Alloc>::capacity() const noexcept
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::size_type 
+JVector<T, Alloc, Growth>::capacity() const noexcept
 {
 	return m_capacity;
 }
 
-template <class T, class Alloc>
+template <class T, class Alloc, class Growth>
 inline void 
-JVector<T, Alloc>::shrink_to_fit()
+JVector<T, Alloc, Growth>::shrink_to_fit()
 {
 	// shrink_to_fit is a non-binding request to reduce capacity() to size().
 	// It does not increase capacity(), but may reduce capacity() by causing reallocation.
 	if (m_capacity != m_size)
 	{
+		const size_type old_capacity = m_capacity;
+
 		if (m_size == 0)
 		{
 			destroy_all_members();
@@ -996,57 +1923,53 @@ JVector<T, Alloc>::shrink_to_fit()
 		{
 			change_vector_capacity_to(m_size);
 		}
+
+		if (m_capacity < old_capacity)
+		{
+			record(JSTD::vector_counter::shrink_saved_bytes, (old_capacity - m_capacity) * sizeof(value_type));
+		}
 	}
 }
 
-template <class T, class Alloc>
+template <class T, class Alloc, class Growth>
 inline void 
-JVector<T, Alloc>::clear() noexcept
+JVector<T, Alloc, Growth>::clear() noexcept
 {
 	destroy_range(m_data, m_data + m_size);
 	m_size = 0;
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::iterator 
-JVector<T, Alloc>::insert(const_iterator pos, const T &value)
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::iterator 
+JVector<T, Alloc, Growth>::insert(const_iterator pos, const T &value)
 {
 	return emplace(pos, value);
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::iterator 
-JVector<T, Alloc>::insert(const_iterator pos, T &&value)
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::iterator 
+JVector<T, Alloc, Growth>::insert(const_iterator pos, T &&value)
 {
 	return emplace(pos, _STD move(value));
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::size_type 
-JVector<T, Alloc>::calculate_growth(size_type new_size)
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::size_type 
+JVector<T, Alloc, Growth>::calculate_growth(size_type new_size)
 {
-	// Copy from MSVC STL.
-	const auto max = max_size();
+	// The policy picks the new capacity, see jstd_growth.h. Never less than new_size.
+	const auto capacity = static_cast<size_type>(
+		Growth::template next_capacity<value_type>(m_capacity, new_size, max_size()));
 
-	if (m_capacity > max - m_capacity / 2) 
-	{
-		return max;
-	}
-
-	const size_type geometric = m_capacity + m_capacity / 2;
-
-	if (geometric < new_size)
-	{
-		return new_size;
-	}
-
-	return geometric;
+	return capacity < new_size ? new_size : capacity;
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::pointer
-JVector<T, Alloc>::move_range(pointer first, pointer last, pointer dest)
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::pointer
+JVector<T, Alloc, Growth>::move_range(pointer first, pointer last, pointer dest)
 {
+	record(JSTD::vector_counter::moved_bytes, (last - first) * sizeof(value_type));
+
 	for (; first != last; ++first, ++dest)
 	{
 		*dest = _STD move(*first);
@@ -1054,21 +1977,23 @@ JVector<T, Alloc>::move_range(pointer first, pointer last, pointer dest)
 
 	return dest;
 }
-
-template <class T, class Alloc>
-template <class Iter>
-inline void 
-JVector<T, Alloc>::rmove(Iter first, Iter last, pointer dest)
+
+template <class T, class Alloc, class Growth>
+inline void
+JVector<T, Alloc, Growth>::rmove(pointer first, pointer last, pointer dest_last)
 {
-	for (; first != last; --last, --dest)
+	// Moves [first, last) backward so that the last element lands just before dest_last.
+	record(JSTD::vector_counter::moved_bytes, (last - first) * sizeof(value_type));
+
+	while (first != last)
 	{
-		*dest = _STD move(*last);
+		*--dest_last = _STD move(*--last);
 	}
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::iterator 
-JVector<T, Alloc>::insert(const_iterator pos, size_type count, const T &value)
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::iterator
+JVector<T, Alloc, Growth>::insert(const_iterator pos, size_type count, const T &value)
 {
 	pointer add_pos_ptr = pos.ptr;
 
@@ -1077,11 +2002,12 @@ JVector<T, Alloc>::insert(const_iterator pos, size_type count, const T &value)
 	{
 		return iterator(pos.ptr);
 	}
-	// If just add one to back, using emplace_back_with_unused_capacity.
+	// If just add one to back, using emplace_back.
 	else if (pos.ptr == m_data + m_size && count == 1)
 	{
-		emplace_back_with_unused_capacity(value);
-		return iterator(add_pos_ptr);
+		const size_type insert_pos_index = pos.ptr - m_data;
+		emplace_back(value);
+		return iterator(m_data + insert_pos_index);
 	}
 	// If no enough space to store the value.
 	else if (count > m_capacity - m_size)
@@ -1091,30 +2017,44 @@ JVector<T, Alloc>::insert(const_iterator pos, size_type count, const T &value)
 			throw _STD runtime_error("Vector too long.");
 		}
 
-		// Provide store guarantee.
+		// Provide strong guarantee.
 		const pointer start                = m_data;
 		const size_type insert_pos_index   = pos.ptr - start;
 		const size_type new_size           = m_size + count;
-		const size_type new_capacity       = calculate_growth(new_size);
-		auto new_vector                    = new value_type[new_capacity]{};
+		const auto [new_vector, new_capacity] = allocate_storage(calculate_growth(new_size));
+		const pointer new_pos              = new_vector + insert_pos_index;
+		pointer constructed_first          = new_pos;
+		pointer constructed_last           = new_pos;
 
 		try
 		{
-			assign_copy_range(new_vector + insert_pos_index, new_vector + insert_pos_index + count, value);
+			construct_n(new_pos, count, value);
+			constructed_last = new_pos + count;
+			relocate_range(m_data, add_pos_ptr, new_vector);
+			constructed_first = new_vector;
+			relocate_range(add_pos_ptr, m_data + m_size, constructed_last);
 		}
 		catch (...)
 		{
-			delete[] new_vector;
+			destroy_range(constructed_first, constructed_last);
+			deallocate_storage(new_vector, new_capacity);
 			throw;
 		}
 
-		move_range(m_data, add_pos_ptr, new_vector);
-		move_range(add_pos_ptr, m_data + m_size, new_vector + insert_pos_index + count);
-		change_vector(new_vector, new_size, new_capacity);
+		change_vector_relocated(new_vector, new_size, new_capacity);
 
-		return iterator(new_vector + insert_pos_index);
+		return iterator(new_pos);
 	}
 	// If we have enough space to store the elementes.
+	else if constexpr (trivially_relocatable && _STD is_nothrow_copy_constructible_v<value_type>)
+	{
+		// Open a gap with one memmove and fill it. value may live in the moved part, so copy it first.
+		const value_type copy(value);
+		relocate_within(add_pos_ptr, m_data + m_size, add_pos_ptr + count);
+		construct_n(add_pos_ptr, count, copy);
+		m_size += count;
+		return iterator(add_pos_ptr);
+	}
 	else
 	{
 		const auto old_size = m_size;
@@ -1129,52 +2069,237 @@ JVector<T, Alloc>::insert(const_iterator pos, size_type count, const T &value)
 	}
 }
 
-template <class T, class Alloc>
+template <class T, class Alloc, class Growth>
+template <class Iter, class Sent>
+inline typename JVector<T, Alloc, Growth>::pointer
+JVector<T, Alloc, Growth>::insert_counted_range(const pointer pos, Iter first, Sent last, const size_type count)
+{
+	// Inserts the count elements of [first, last) with at most one allocation.
+	if (count == 0)
+	{
+		return pos;
+	}
+
+	if (count > m_capacity - m_size)
+	{
+		if (count > max_size() - m_size)
+		{
+			throw _STD runtime_error("Vector too long.");
+		}
+
+		const size_type insert_pos_index = pos - m_data;
+		const size_type new_size         = m_size + count;
+		const auto [new_vector, new_capacity] = allocate_storage(calculate_growth(new_size));
+		const pointer new_pos            = new_vector + insert_pos_index;
+		pointer constructed_first        = new_pos;
+		pointer constructed_last         = new_pos;
+
+		try
+		{
+			uninitialized_copy_range(first, last, new_pos);
+			constructed_last = new_pos + count;
+			relocate_range(m_data, pos, new_vector);
+			constructed_first = new_vector;
+			relocate_range(pos, m_data + m_size, constructed_last);
+		}
+		catch (...)
+		{
+			destroy_range(constructed_first, constructed_last);
+			deallocate_storage(new_vector, new_capacity);
+			throw;
+		}
+
+		change_vector_relocated(new_vector, new_size, new_capacity);
+
+		return new_pos;
+	}
+
+	const pointer old_end = m_data + m_size;
+
+	if (pos == old_end)
+	{
+		uninitialized_copy_range(first, last, old_end);
+		m_size += count;
+	}
+	else if constexpr (trivially_relocatable)
+	{
+		// Open the gap with one memmove, and close it again if copying the range throws.
+		relocate_within(pos, old_end, pos + count);
+
+		try
+		{
+			uninitialized_copy_range(first, last, pos);
+		}
+		catch (...)
+		{
+			relocate_within(pos + count, old_end + count, pos);
+			throw;
+		}
+
+		m_size += count;
+	}
+	else
+	{
+		const size_type elements_after = old_end - pos;
+
+		if (elements_after > count)
+		{
+			uninitialized_move_range(old_end - count, old_end, old_end);
+			m_size += count;
+			rmove(pos, old_end - count, old_end);
+			copy_range(first, last, pos);
+		}
+		else
+		{
+			Iter mid = first;
+			_STD advance(mid, elements_after);
+			uninitialized_copy_range(mid, last, old_end);
+			m_size += count - elements_after;
+			uninitialized_move_range(pos, old_end, pos + count);
+			m_size += elements_after;
+			copy_range(first, mid, pos);
+		}
+	}
+
+	return pos;
+}
+
+template <class T, class Alloc, class Growth>
+template <class Iter>
+inline typename JVector<T, Alloc, Growth>::pointer
+JVector<T, Alloc, Growth>::insert_input_range(const pointer pos, Iter first, Iter last)
+{
+	// The length is unknown: append with geometric growth, then rotate the new elements into place.
+	const size_type insert_pos_index = pos - m_data;
+	const size_type old_size         = m_size;
+
+	for (; first != last; ++first)
+	{
+		emplace_back(*first);
+	}
+
+	_STD rotate(m_data + insert_pos_index, m_data + old_size, m_data + m_size);
+	return m_data + insert_pos_index;
+}
+
+template <class T, class Alloc, class Growth>
+template <class Iter, class>
+inline typename JVector<T, Alloc, Growth>::iterator
+JVector<T, Alloc, Growth>::insert(const_iterator pos, Iter first, Iter last)
+{
+	if constexpr (JSTD::is_forward_iterator_v<Iter>)
+	{
+		return iterator(insert_counted_range(pos.ptr, first, last, static_cast<size_type>(_STD distance(first, last))));
+	}
+	else
+	{
+		return iterator(insert_input_range(pos.ptr, first, last));
+	}
+}
+
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::iterator
+JVector<T, Alloc, Growth>::insert(const_iterator pos, _STD initializer_list<T> ilist)
+{
+	return iterator(insert_counted_range(pos.ptr, ilist.begin(), ilist.end(), static_cast<size_type>(ilist.size())));
+}
+
+#ifdef __cpp_lib_ranges
+template <class T, class Alloc, class Growth>
+template <_RANGES input_range Range>
+inline void
+JVector<T, Alloc, Growth>::append_range(Range &&range)
+{
+	if constexpr (_RANGES forward_range<Range>)
+	{
+		const auto count = static_cast<size_type>(_RANGES distance(range));
+		insert_counted_range(m_data + m_size, _RANGES begin(range), _RANGES end(range), count);
+	}
+	else
+	{
+		if constexpr (_RANGES sized_range<Range>)
+		{
+			reserve(m_size + static_cast<size_type>(_RANGES size(range)));
+		}
+
+		auto first      = _RANGES begin(range);
+		const auto last = _RANGES end(range);
+
+		for (; first != last; ++first)
+		{
+			emplace_back(*first);
+		}
+	}
+}
+#endif // __cpp_lib_ranges
+
+template <class T, class Alloc, class Growth>
 template <class ...Args>
-inline decltype(auto)
-JVector<T, Alloc>::emplace_rellocate(const pointer pos, Args&&... args)
+inline typename JVector<T, Alloc, Growth>::pointer
+JVector<T, Alloc, Growth>::emplace_rellocate(const pointer pos, Args&&... args)
 {
 	if (m_size == max_size())
 	{
 		throw _STD runtime_error("Vector too long.");
 	}
 
-	const auto new_size      = m_size + 1;
-	const auto new_capacity  = calculate_growth(new_size);
-	const auto add_pos_index = pos - m_data;
+	const auto new_size       = m_size + 1;
+	const auto grown_capacity = calculate_growth(new_size);
+	const auto add_pos_index  = pos - m_data;
+
+	if constexpr (use_native_storage)
+	{
+		// Appending grows the buffer in place. args may refer to an element, so build the new one first.
+		if (pos == m_data + m_size)
+		{
+			value_type new_obj(_STD forward<Args>(args)...);
+			reallocate_native(grown_capacity);
+			construct_one(m_data + m_size, _STD move(new_obj));
+			++m_size;
+			return m_data + m_size - 1;
+		}
+	}
+
+	const auto [new_vector, new_capacity] = allocate_storage(grown_capacity);
+	const pointer new_pos     = new_vector + add_pos_index;
+	pointer constructed_first = new_pos;
+	pointer constructed_last  = new_pos;
 
-	auto new_vector = new value_type[new_capacity]{};
 	try
 	{
-		::new (static_cast<void*>(&new_vector[add_pos_index])) value_type(_STD forward<Args>(args)...);
+		// Construct the new element first, args may refer to an element of this vector.
+		construct_one(new_pos, _STD forward<Args>(args)...);
+		constructed_last = new_pos + 1;
+		relocate_range(m_data, pos, new_vector);
+		constructed_first = new_vector;
+		relocate_range(pos, m_data + m_size, constructed_last);
 	}
 	catch (...)
 	{
-		delete[] new_vector;
+		destroy_range(constructed_first, constructed_last);
+		deallocate_storage(new_vector, new_capacity);
 		throw;
 	}
 
-	move_range(m_data, pos, new_vector);
-	move_range(pos, m_data + m_size, new_vector + add_pos_index);
-	change_vector(new_vector, new_size, new_capacity);
+	change_vector_relocated(new_vector, new_size, new_capacity);
 
-	return new_vector + add_pos_index;
+	return new_pos;
 }
 
-template <class T, class Alloc>
+template <class T, class Alloc, class Growth>
 template <class ...Args>
-inline decltype(auto) 
-JVector<T, Alloc>::emplace_back_with_unused_capacity(Args&&... args)
+inline decltype(auto)
+JVector<T, Alloc, Growth>::emplace_back_with_unused_capacity(Args&&... args)
 {
-	::new (static_cast<void*>(&m_data[m_size])) value_type(_STD forward<Args>(args)...);
+	construct_one(m_data + m_size, _STD forward<Args>(args)...);
 	++m_size;
 	return m_data[m_size - 1];
 }
 
-template <class T, class Alloc>
+template <class T, class Alloc, class Growth>
 template <class ...Args>
-inline typename JVector<T, Alloc>::iterator 
-JVector<T, Alloc>::emplace(const_iterator pos, Args&&... args)
+inline typename JVector<T, Alloc, Growth>::iterator
+JVector<T, Alloc, Growth>::emplace(const_iterator pos, Args&&... args)
 {
 	const pointer pos_ptr = pos.ptr;
 
@@ -1185,16 +2310,25 @@ JVector<T, Alloc>::emplace(const_iterator pos, Args&&... args)
 			emplace_back_with_unused_capacity(_STD forward<Args>(args)...);
 			return iterator(pos_ptr);
 		}
+		else if constexpr (trivially_relocatable && _STD is_nothrow_move_constructible_v<value_type>)
+		{
+			value_type new_obj = value_type(_STD forward<Args>(args)...);
+			relocate_within(pos_ptr, m_data + m_size, pos_ptr + 1);
+			construct_one(pos_ptr, _STD move(new_obj));
+			++m_size;
+
+			return iterator(pos_ptr);
+		}
 		else
 		{
-			value_type new_obj        = value_type(_STD forward<Args>(args)...);
-			const pointer rmove_start = pos_ptr - 1;
-			const pointer rmove_end   = m_data + m_size - 1;
-			const pointer rmove_dest  = m_data + m_size;
+			value_type new_obj    = value_type(_STD forward<Args>(args)...);
+			const pointer old_end = m_data + m_size;
 
-			rmove(rmove_start, rmove_end, rmove_dest);
-			*pos_ptr = _STD move(new_obj);
+			// The slot past the end is raw memory, so it must be constructed rather than assigned.
+			construct_one(old_end, _STD move(old_end[-1]));
 			++m_size;
+			rmove(pos_ptr, old_end - 1, old_end);
+			*pos_ptr = _STD move(new_obj);
 
 			return iterator(pos_ptr);
 		}
@@ -1203,81 +2337,96 @@ JVector<T, Alloc>::emplace(const_iterator pos, Args&&... args)
 	return iterator(emplace_rellocate(pos_ptr, _STD forward<Args>(args)...));
 }
 
-template <class T, class Alloc>
+template <class T, class Alloc, class Growth>
 template <class ...Args>
-inline typename JVector<T, Alloc>::reference 
-JVector<T, Alloc>::emplace_back(Args&& ...args)
+inline typename JVector<T, Alloc, Growth>::reference
+JVector<T, Alloc, Growth>::emplace_back(Args&& ...args)
 {
 	if (m_size != m_capacity)
 	{
 		return emplace_back_with_unused_capacity(_STD forward<Args>(args)...);
 	}
-	
+
 	return *emplace_rellocate(m_data + m_size, _STD forward<Args>(args)...);
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::iterator 
-JVector<T, Alloc>::erase(const_iterator pos) noexcept(_STD is_nothrow_move_assignable_v<value_type>)
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::iterator
+JVector<T, Alloc, Growth>::erase(const_iterator pos) noexcept(_STD is_nothrow_move_assignable_v<value_type>)
 {
 	const pointer where_ptr = pos.ptr;
-	move_range(where_ptr + 1, m_data + m_size, where_ptr);
-	destroy_range(m_data + m_size - 1, m_data + m_size);
+
+	if constexpr (trivially_relocatable)
+	{
+		destroy_range(where_ptr, where_ptr + 1);
+		relocate_within(where_ptr + 1, m_data + m_size, where_ptr);
+	}
+	else
+	{
+		move_range(where_ptr + 1, m_data + m_size, where_ptr);
+		destroy_range(m_data + m_size - 1, m_data + m_size);
+	}
+
+	--m_size;
 
 	return iterator(where_ptr);
 }
 
-template <class T, class Alloc>
-inline typename JVector<T, Alloc>::iterator 
-JVector<T, Alloc>::erase(const_iterator first, const_iterator last) noexcept(_STD is_nothrow_move_assignable_v<value_type>)
+template <class T, class Alloc, class Growth>
+inline typename JVector<T, Alloc, Growth>::iterator
+JVector<T, Alloc, Growth>::erase(const_iterator first, const_iterator last) noexcept(_STD is_nothrow_move_assignable_v<value_type>)
 {
 	if (first != last)
 	{
 		const pointer first_ptr      = first.ptr;
 		const pointer last_ptr       = last.ptr;
 		const size_type num_of_earse = last_ptr - first_ptr;
-		const auto need_to_destroy = move_range(last_ptr, m_data + m_size, first_ptr);
-		
-		destroy_range(need_to_destroy, m_data + m_size);
+
+		if constexpr (trivially_relocatable)
+		{
+			destroy_range(first_ptr, last_ptr);
+			relocate_within(last_ptr, m_data + m_size, first_ptr);
+		}
+		else
+		{
+			const auto need_to_destroy = move_range(last_ptr, m_data + m_size, first_ptr);
+			destroy_range(need_to_destroy, m_data + m_size);
+		}
+
 		m_size -= num_of_earse;
 	}
 
 	return iterator(first.ptr);
 }
 
-template <class T, class Alloc>
-inline void 
-JVector<T, Alloc>::push_back(const T &value)
+template <class T, class Alloc, class Growth>
+inline void
+JVector<T, Alloc, Growth>::push_back(const T &value)
 {
 	emplace_back(value);
 }
 
-template <class T, class Alloc>
-inline void 
-JVector<T, Alloc>::push_back(T &&value)
+template <class T, class Alloc, class Growth>
+inline void
+JVector<T, Alloc, Growth>::push_back(T &&value)
 {
 	emplace_back(_STD move(value));
 }
 
-template <class T, class Alloc>
-inline void 
-JVector<T, Alloc>::pop_back() noexcept
+template <class T, class Alloc, class Growth>
+inline void
+JVector<T, Alloc, Growth>::pop_back() noexcept
 {
 	destroy_range(m_data + m_size - 1, m_data + m_size);
 	--m_size;
 }
 
-template <class T, class Alloc>
-inline void 
-JVector<T, Alloc>::resize(size_type count)
-{
-	resize(count, value_type());
-}
-
-template <class T, class Alloc>
-inline void 
-JVector<T, Alloc>::resize(size_type count, const value_type &value)
+template <class T, class Alloc, class Growth>
+template <class ...Val>
+inline void
+JVector<T, Alloc, Growth>::resize_impl(size_type count, const Val&... value)
 {
+	// New elements are constructed by construct_n() from value.
 	if (count < m_size)
 	{
 		destroy_range(m_data + count, m_data + m_size);
@@ -1293,91 +2442,313 @@ JVector<T, Alloc>::resize(size_type count, const value_type &value)
 				throw _STD runtime_error("Vector too long");
 			}
 
-			pointer new_vector = new value_type[count]{};
+			const size_type grown_capacity = calculate_growth(count);
+
+			if constexpr (use_native_storage)
+			{
+				// value may refer to an element, keep a copy across the reallocation.
+				if constexpr (sizeof...(Val) == 0 || (_STD is_same_v<Val, default_init_t> && ...))
+				{
+					reallocate_native(grown_capacity);
+					construct_n(m_data + m_size, count - m_size, value...);
+				}
+				else
+				{
+					const value_type copy(value...);
+					reallocate_native(grown_capacity);
+					construct_n(m_data + m_size, count - m_size, copy);
+				}
+
+				m_size = count;
+				return;
+			}
+
+			const auto [new_vector, new_capacity] = allocate_storage(grown_capacity);
+			const pointer appended_first = new_vector + m_size;
 
 			try
 			{
-				assign_copy_range(new_vector + m_size, new_vector + count, value);
+				construct_n(appended_first, count - m_size, value...);
+
+				try
+				{
+					relocate_range(m_data, m_data + m_size, new_vector);
+				}
+				catch (...)
+				{
+					destroy_range(appended_first, new_vector + count);
+					throw;
+				}
 			}
 			catch (...)
 			{
-				delete[] new_vector;
+				deallocate_storage(new_vector, new_capacity);
 				throw;
 			}
 
-			move_range(m_data, m_data + m_size, new_vector);
-			change_vector(new_vector, count, count);
+			change_vector_relocated(new_vector, count, new_capacity);
 		}
 		else
 		{
-			for (size_type i = 0, need_to_append = count - m_size; i < need_to_append; ++i)
-			{
-				emplace_back_with_unused_capacity(value);
-			}
+			construct_n(m_data + m_size, count - m_size, value...);
+			m_size = count;
 		}
 	}
 }
 
-template <class T, class Alloc>
-inline void 
-JVector<T, Alloc>::swap(JVector &other) noexcept
+template <class T, class Alloc, class Growth>
+inline void
+JVector<T, Alloc, Growth>::resize(size_type count)
+{
+	resize_impl(count);
+}
+
+template <class T, class Alloc, class Growth>
+inline void
+JVector<T, Alloc, Growth>::resize(size_type count, const value_type &value)
+{
+	resize_impl(count, value);
+}
+
+template <class T, class Alloc, class Growth>
+inline void
+JVector<T, Alloc, Growth>::resize_default_init(size_type count)
+{
+	// New elements are default-initialized, trivial types are not zeroed.
+	resize_impl(count, default_init_t{});
+}
+
+template <class T, class Alloc, class Growth>
+template <class Operation>
+inline void
+JVector<T, Alloc, Growth>::resize_and_overwrite(size_type count, Operation op)
+{
+	// Like std::string::resize_and_overwrite. op(data(), count) writes into [0, count), where the elements
+	// past min(size(), count) are uninitialized, and returns the new size, which must not exceed count.
+	static_assert(_STD is_trivially_default_constructible_v<value_type> && _STD is_trivially_destructible_v<value_type>,
+		"resize_and_overwrite requires a trivial element type.");
+
+	if (count > m_capacity)
+	{
+		if (count > max_size())
+		{
+			throw _STD runtime_error("Vector too long");
+		}
+
+		change_vector_capacity_to(calculate_growth(count));
+	}
+
+	const auto new_size = static_cast<size_type>(_STD move(op)(m_data, count));
+	assert(new_size <= count);
+	m_size = new_size;
+}
+
+template <class T, class Alloc, class Growth>
+inline void
+JVector<T, Alloc, Growth>::swap(JVector &other) noexcept
 {
 	if (this != _STD addressof(other))
 	{
 		using _STD swap;
+
+		if constexpr (alty_traits::propagate_on_container_swap::value)
+		{
+			swap(this->get_al(), other.get_al());
+		}
+		else
+		{
+			// Swapping vectors with unequal allocators which do not propagate is undefined behaviour.
+			assert(equal_allocator(other));
+		}
+
 		swap(m_data, other.m_data);
 		swap(m_capacity, other.m_capacity);
 		swap(m_size, other.m_size);
 	}
 }
 
+template <class T, class Alloc, class Growth>
+inline void
+JVector<T, Alloc, Growth>::adopt(pointer data, const size_type size, const size_type capacity)
+{
+	assert(size <= capacity && (data != nullptr || capacity == 0));
+
+	if constexpr (use_native_storage)
+	{
+		assert(JSTD::may_be_native_storage(data, capacity * sizeof(value_type), storage_alignment));
+	}
+
+	destroy_all_members();
+	m_data     = data;
+	m_size     = size;
+	m_capacity = capacity;
+}
+
+template <class T, class Alloc, class Growth>
+inline void
+JVector<T, Alloc, Growth>::adopt(pointer data, const size_type size, const size_type capacity, const Alloc &al)
+{
+	// The current buffer goes back to the allocator that obtained it.
+	destroy_all_members();
+	this->get_al() = static_cast<alty>(al);
+	adopt(data, size, capacity);
+}
+
+template <class T, class Alloc, class Growth>
+inline void
+JVector<T, Alloc, Growth>::adopt(pointer data, const size_type size, const size_type capacity,
+	const typename JVector_Buffer<T, Alloc>::deleter_type deleter)
+{
+	JVector_Buffer<T, Alloc> buffer(data, size, capacity, deleter, static_cast<Alloc>(this->get_al()));
+	adopt(_STD move(buffer));
+}
+
+template <class T, class Alloc, class Growth>
+inline void
+JVector<T, Alloc, Growth>::adopt(JVector_Buffer<T, Alloc> &&buffer)
+{
+	if (const auto deleter = buffer.get_deleter())
+	{
+		const size_type size   = buffer.size();
+		pointer new_vector     = nullptr;
+		size_type new_capacity = 0;
+
+		if (size != 0)
+		{
+			const auto storage = allocate_storage(size);
+			new_vector         = storage.ptr;
+			new_capacity       = storage.count;
+
+			try
+			{
+				relocate_range(buffer.data(), buffer.data() + size, new_vector);
+			}
+			catch (...)
+			{
+				deallocate_storage(new_vector, new_capacity);
+				throw;
+			}
+		}
+
+		if constexpr (trivially_relocatable)
+		{
+			// The relocated sources are dead, only the storage is left to free.
+			const size_type capacity = buffer.capacity();
+			deleter(buffer.release(), capacity);
+		}
+		else
+		{
+			// Destroys the moved-from sources and frees the storage.
+			JVector_Buffer<T, Alloc> sources(_STD move(buffer));
+		}
+
+		change_vector(new_vector, size, new_capacity);
+		return;
+	}
+
+	const Alloc al           = buffer.get_allocator();
+	const size_type size     = buffer.size();
+	const size_type capacity = buffer.capacity();
+	adopt(buffer.release(), size, capacity, al);
+}
+
+template <class T, class Alloc, class Growth>
+inline JVector_Buffer<T, Alloc>
+JVector<T, Alloc, Growth>::release() noexcept
+{
+	JVector_Buffer<T, Alloc> buffer(m_data, m_size, m_capacity, static_cast<Alloc>(this->get_al()));
+	m_data     = nullptr;
+	m_size     = 0;
+	m_capacity = 0;
+	return buffer;
+}
+
 // Operator overloading functions. Outside the class scope
-template <class T, class Alloc>
+template <class T, class Alloc, class Growth>
 NODISCARD bool
-operator==(const JVector<T, Alloc> &lhs, const JVector<T, Alloc> &rhs)
+operator==(const JVector<T, Alloc, Growth> &lhs, const JVector<T, Alloc, Growth> &rhs)
 {
-	return lhs.size() == rhs.size() && _STD equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+	if (lhs.size() != rhs.size())
+	{
+		return false;
+	}
+
+	// Arithmetic elements are compared by the SIMD kernels of jstd_simd.h.
+	if constexpr (JSTD::is_simd_comparable_v<T>)
+	{
+		return JSTD::simd_mismatch(lhs.data(), rhs.data(), lhs.size()) == lhs.size();
+	}
+	else
+	{
+		return _STD equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+	}
 }
 
-template <class T, class Alloc>
+template <class T, class Alloc, class Growth>
 NODISCARD bool
-operator!=(const JVector<T, Alloc> &left, const JVector<T, Alloc> &right)
+operator!=(const JVector<T, Alloc, Growth> &left, const JVector<T, Alloc, Growth> &right)
 {
 	return !(left == right);
 }
 
-template <class T, class Alloc>
+template <class T, class Alloc, class Growth>
 NODISCARD bool
-operator<(const JVector<T, Alloc> &left, const JVector<T, Alloc> &right)
+operator<(const JVector<T, Alloc, Growth> &left, const JVector<T, Alloc, Growth> &right)
 {
-	return _STD lexicographical_compare(left.cbegin(), left.cend(), right.cbegin(), right.cend());
+	if constexpr (JSTD::is_simd_comparable_v<T>)
+	{
+		// Only the first pair that orders the vectors is compared as elements.
+		const auto common = (_STD min)(left.size(), right.size());
+		const auto index  = JSTD::simd_ordered_mismatch(left.data(), right.data(), common);
+
+		return index == common ? left.size() < right.size() : left[index] < right[index];
+	}
+	else
+	{
+		return _STD lexicographical_compare(left.cbegin(), left.cend(), right.cbegin(), right.cend());
+	}
 }
 
-template <class T, class Alloc>
+template <class T, class Alloc, class Growth>
 NODISCARD bool
-operator>(const JVector<T, Alloc> &left, const JVector<T, Alloc> &right)
+operator>(const JVector<T, Alloc, Growth> &left, const JVector<T, Alloc, Growth> &right)
 {
 	return right < left;
 }
 
-template <class T, class Alloc>
+template <class T, class Alloc, class Growth>
 NODISCARD bool
-operator<=(const JVector<T, Alloc> &left, const JVector<T, Alloc> &right)
+operator<=(const JVector<T, Alloc, Growth> &left, const JVector<T, Alloc, Growth> &right)
 {
 	return !(right < left);
 }
 
-template <class T, class Alloc>
+template <class T, class Alloc, class Growth>
 NODISCARD bool
-operator>=(const JVector<T, Alloc> &left, const JVector<T, Alloc> &right)
+operator>=(const JVector<T, Alloc, Growth> &left, const JVector<T, Alloc, Growth> &right)
 {
 	return !(left < right);
 }
 
-template <class T, class Alloc>
+template <class T, class Alloc, class Growth>
 void
-swap(const JVector<T, Alloc> &left, const JVector<T, Alloc> &right) noexcept
+swap(JVector<T, Alloc, Growth> &left, JVector<T, Alloc, Growth> &right) noexcept
 {
 	left.swap(right);
 }
+
+_JSTD_BEGIN
+// JVector only holds pointers into its buffer, so with the stateless default allocator it relocates bitwise.
+template <class T, class Growth>
+struct is_trivially_relocatable<JVector<T, _STD allocator<T>, Growth>> : _STD true_type {};
+
+#ifdef __cpp_lib_memory_resource
+namespace pmr
+{
+	// JVector drawing its memory from a std::pmr::memory_resource, e.g. JSTD::pmr::JVector<int> v(&resource).
+	template <class T, class Growth = JSTD::default_growth>
+	using JVector = ::JVector<T, _STD pmr::polymorphic_allocator<T>, Growth>;
+} // namespace pmr
+#endif // __cpp_lib_memory_resource
+_JSTD_END
 #endif // !_JVECTOR_
\ No newline at end of file
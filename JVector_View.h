@@ -0,0 +1,328 @@
+#pragma once
+#ifndef _JVECTOR_VIEW_
+#define _JVECTOR_VIEW_
+
+#include "JVector.h"
+
+_JSTD_BEGIN
+// Contiguous containers: a data() pointer convertible to Pointer and a size().
+template <class Container, class Pointer, class = void>
+inline constexpr bool is_contiguous_source_v = false;
+
+template <class Container, class Pointer>
+inline constexpr bool is_contiguous_source_v<Container, Pointer, _STD void_t<
+	decltype(_STD declval<Container&>().data()), decltype(_STD declval<Container&>().size())>> =
+	_STD is_convertible_v<decltype(_STD declval<Container&>().data()), Pointer>;
+_JSTD_END
+
+// Non-owning read-only view of contiguous elements, e.g. of a JVector, a JMappedVector or a decoder's output.
+// It stays valid as long as the elements do not move.
+template <class T>
+class JVector_View
+{
+public:
+	using value_type             = T;
+	using pointer                = const T*;
+	using const_pointer          = const T*;
+	using reference              = const T&;
+	using const_reference        = const T&;
+	using size_type              = _STD size_t;
+	using difference_type        = _STD ptrdiff_t;
+	using iterator               = JVector_Const_Iterator<JVector_View<T>>;
+	using const_iterator         = iterator;
+	using reverse_iterator       = _STD reverse_iterator<iterator>;
+	using const_reverse_iterator = reverse_iterator;
+
+	static constexpr size_type npos = static_cast<size_type>(-1);
+
+	constexpr JVector_View() noexcept
+		: m_data(nullptr),
+		  m_size(0)
+		{}
+
+	constexpr JVector_View(const_pointer data, const size_type size) noexcept
+		: m_data(data),
+		  m_size(size)
+		{}
+
+	constexpr JVector_View(const_pointer first, const_pointer last) noexcept
+		: m_data(first),
+		  m_size(static_cast<size_type>(last - first))
+		{}
+
+	template <class Container, class = _STD enable_if_t<
+		JSTD::is_contiguous_source_v<const Container, const_pointer> && !_STD is_same_v<Container, JVector_View>>>
+	JVector_View(const Container &container) noexcept
+		: m_data(container.data()),
+		  m_size(static_cast<size_type>(container.size()))
+		{}
+
+	NODISCARD const_reference at(const size_type pos) const
+	{
+		if (pos >= m_size)
+		{
+			throw _STD out_of_range("Index out of range.");
+		}
+
+		return m_data[pos];
+	}
+
+	NODISCARD const_reference operator[](const size_type pos) const noexcept
+	{
+		return m_data[pos];
+	}
+
+	NODISCARD const_reference front() const noexcept
+	{
+		return m_data[0];
+	}
+
+	NODISCARD const_reference back() const noexcept
+	{
+		return m_data[m_size - 1];
+	}
+
+	NODISCARD constexpr const_pointer data() const noexcept
+	{
+		return m_data;
+	}
+
+	NODISCARD constexpr size_type size() const noexcept
+	{
+		return m_size;
+	}
+
+	NODISCARD constexpr bool empty() const noexcept
+	{
+		return m_size == 0;
+	}
+
+	NODISCARD const_iterator begin() const noexcept
+	{
+		return const_iterator(m_data);
+	}
+
+	NODISCARD const_iterator end() const noexcept
+	{
+		return const_iterator(m_data + m_size);
+	}
+
+	NODISCARD const_iterator cbegin() const noexcept
+	{
+		return begin();
+	}
+
+	NODISCARD const_iterator cend() const noexcept
+	{
+		return end();
+	}
+
+	NODISCARD const_reverse_iterator rbegin() const noexcept
+	{
+		return const_reverse_iterator(end());
+	}
+
+	NODISCARD const_reverse_iterator rend() const noexcept
+	{
+		return const_reverse_iterator(begin());
+	}
+
+	// The first count elements. Like last, throws out_of_range if there are fewer.
+	NODISCARD JVector_View first(const size_type count) const
+	{
+		if (count > m_size)
+		{
+			throw _STD out_of_range("Index out of range.");
+		}
+
+		return JVector_View(m_data, count);
+	}
+
+	// The last count elements.
+	NODISCARD JVector_View last(const size_type count) const
+	{
+		if (count > m_size)
+		{
+			throw _STD out_of_range("Index out of range.");
+		}
+
+		return JVector_View(m_data + (m_size - count), count);
+	}
+
+	// count elements from offset, or those up to the end if fewer.
+	NODISCARD JVector_View subview(const size_type offset, const size_type count = npos) const
+	{
+		if (offset > m_size)
+		{
+			throw _STD out_of_range("Index out of range.");
+		}
+
+		return JVector_View(m_data + offset, (_STD min)(count, m_size - offset));
+	}
+
+private:
+	const_pointer m_data;
+	size_type     m_size;
+};
+
+// Non-owning view of contiguous elements that may be modified but not added or removed.
+template <class T>
+class JVector_Span
+{
+public:
+	using value_type             = T;
+	using pointer                = T*;
+	using const_pointer          = const T*;
+	using reference              = T&;
+	using const_reference        = const T&;
+	using size_type              = _STD size_t;
+	using difference_type        = _STD ptrdiff_t;
+	using iterator               = JVector_Iterator<JVector_Span<T>>;
+	using const_iterator         = JVector_Const_Iterator<JVector_Span<T>>;
+	using reverse_iterator       = _STD reverse_iterator<iterator>;
+	using const_reverse_iterator = _STD reverse_iterator<const_iterator>;
+
+	static constexpr size_type npos = static_cast<size_type>(-1);
+
+	constexpr JVector_Span() noexcept
+		: m_data(nullptr),
+		  m_size(0)
+		{}
+
+	constexpr JVector_Span(pointer data, const size_type size) noexcept
+		: m_data(data),
+		  m_size(size)
+		{}
+
+	constexpr JVector_Span(pointer first, pointer last) noexcept
+		: m_data(first),
+		  m_size(static_cast<size_type>(last - first))
+		{}
+
+	template <class Container, class = _STD enable_if_t<
+		JSTD::is_contiguous_source_v<Container, pointer> && !_STD is_same_v<_STD remove_const_t<Container>, JVector_Span>>>
+	JVector_Span(Container &container) noexcept
+		: m_data(container.data()),
+		  m_size(static_cast<size_type>(container.size()))
+		{}
+
+	NODISCARD reference at(const size_type pos) const
+	{
+		if (pos >= m_size)
+		{
+			throw _STD out_of_range("Index out of range.");
+		}
+
+		return m_data[pos];
+	}
+
+	NODISCARD reference operator[](const size_type pos) const noexcept
+	{
+		return m_data[pos];
+	}
+
+	NODISCARD reference front() const noexcept
+	{
+		return m_data[0];
+	}
+
+	NODISCARD reference back() const noexcept
+	{
+		return m_data[m_size - 1];
+	}
+
+	NODISCARD constexpr pointer data() const noexcept
+	{
+		return m_data;
+	}
+
+	NODISCARD constexpr size_type size() const noexcept
+	{
+		return m_size;
+	}
+
+	NODISCARD constexpr bool empty() const noexcept
+	{
+		return m_size == 0;
+	}
+
+	NODISCARD iterator begin() const noexcept
+	{
+		return iterator(m_data);
+	}
+
+	NODISCARD iterator end() const noexcept
+	{
+		return iterator(m_data + m_size);
+	}
+
+	NODISCARD const_iterator cbegin() const noexcept
+	{
+		return const_iterator(m_data);
+	}
+
+	NODISCARD const_iterator cend() const noexcept
+	{
+		return const_iterator(m_data + m_size);
+	}
+
+	NODISCARD reverse_iterator rbegin() const noexcept
+	{
+		return reverse_iterator(end());
+	}
+
+	NODISCARD reverse_iterator rend() const noexcept
+	{
+		return reverse_iterator(begin());
+	}
+
+	NODISCARD JVector_Span first(const size_type count) const
+	{
+		if (count > m_size)
+		{
+			throw _STD out_of_range("Index out of range.");
+		}
+
+		return JVector_Span(m_data, count);
+	}
+
+	NODISCARD JVector_Span last(const size_type count) const
+	{
+		if (count > m_size)
+		{
+			throw _STD out_of_range("Index out of range.");
+		}
+
+		return JVector_Span(m_data + (m_size - count), count);
+	}
+
+	NODISCARD JVector_Span subspan(const size_type offset, const size_type count = npos) const
+	{
+		if (offset > m_size)
+		{
+			throw _STD out_of_range("Index out of range.");
+		}
+
+		return JVector_Span(m_data + offset, (_STD min)(count, m_size - offset));
+	}
+
+private:
+	pointer   m_data;
+	size_type m_size;
+};
+
+template <class T>
+NODISCARD bool
+operator==(const JVector_View<T> &left, const JVector_View<T> &right)
+{
+	return left.size() == right.size() && _STD equal(left.begin(), left.end(), right.begin());
+}
+
+template <class T>
+NODISCARD bool
+operator!=(const JVector_View<T> &left, const JVector_View<T> &right)
+{
+	return !(left == right);
+}
+
+#endif // !_JVECTOR_VIEW_
@@ -8,6 +8,7 @@
 #define _JSTD_BEGIN namespace JSTD {
 #define _JSTD_END   }
 #define _STD       ::std::
+#define _RANGES    ::std::ranges::
 
 // Useful Macro
 #define NODISCARD [[nodiscard]]
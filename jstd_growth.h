@@ -0,0 +1,131 @@
+#pragma once
+#ifndef _JSTD_GROWTH_
+#define _JSTD_GROWTH_
+
+#include <cstddef>
+
+#include "jstd_core.h"
+
+_JSTD_BEGIN
+// Growth policies decide the capacity of a vector that has to reallocate.
+// next_capacity<T>(capacity, new_size, max_size) returns a value in [new_size, max_size],
+// where capacity is the current one and new_size the number of elements needed.
+
+// Grows the capacity by a factor of Num / Den, or straight to new_size if that is larger.
+template <_STD size_t Num, _STD size_t Den>
+struct geometric_growth
+{
+	static_assert(Den != 0 && Num > Den, "geometric_growth needs a factor greater than 1.");
+
+	template <class T>
+	NODISCARD static _STD size_t next_capacity(
+		const _STD size_t capacity, const _STD size_t new_size, const _STD size_t max_size) noexcept
+	{
+		// capacity * (Num - Den) / Den without overflowing.
+		const _STD size_t increment = capacity / Den * (Num - Den) + capacity % Den * (Num - Den) / Den;
+
+		if (increment > max_size || capacity > max_size - increment)
+		{
+			return max_size;
+		}
+
+		const _STD size_t geometric = capacity + increment;
+
+		if (geometric < new_size)
+		{
+			return new_size;
+		}
+
+		return geometric;
+	}
+};
+
+// 1.5x, the growth of MSVC STL and of JVector so far.
+using default_growth = geometric_growth<3, 2>;
+
+// 2x, fewer reallocations and copies at the cost of more unused capacity.
+using double_growth = geometric_growth<2, 1>;
+
+// Grows by a fixed number of elements. Every reallocation copies the whole vector, so appending is quadratic.
+template <_STD size_t Increment>
+struct fixed_growth
+{
+	static_assert(Increment != 0, "fixed_growth needs a non-zero increment.");
+
+	template <class T>
+	NODISCARD static _STD size_t next_capacity(
+		const _STD size_t capacity, const _STD size_t new_size, const _STD size_t max_size) noexcept
+	{
+		if (Increment > max_size || capacity > max_size - Increment)
+		{
+			return max_size < new_size ? new_size : max_size;
+		}
+
+		const _STD size_t grown = capacity + Increment;
+		return grown < new_size ? new_size : grown;
+	}
+};
+
+// Rounds the byte size chosen by Base up to whole pages, so the tail of the last page is not wasted.
+template <class Base = default_growth, _STD size_t PageSize = 4096>
+struct page_growth
+{
+	template <class T>
+	NODISCARD static _STD size_t next_capacity(
+		const _STD size_t capacity, const _STD size_t new_size, const _STD size_t max_size) noexcept
+	{
+		const _STD size_t base = Base::template next_capacity<T>(capacity, new_size, max_size);
+
+		if (base > (max_size - PageSize / sizeof(T)))
+		{
+			return base;
+		}
+
+		const _STD size_t bytes = (base * sizeof(T) + PageSize - 1) / PageSize * PageSize;
+		return bytes / sizeof(T);
+	}
+};
+
+// Rounds a byte count up to the size class malloc would serve it from.
+// Classes follow jemalloc: multiples of 16 up to 64 bytes, then four classes per power of two.
+NODISCARD constexpr _STD size_t round_to_size_class(const _STD size_t bytes) noexcept
+{
+	if (bytes <= 64)
+	{
+		return (bytes + 15) / 16 * 16;
+	}
+
+	_STD size_t power = 64;
+
+	while (power < bytes && power <= (static_cast<_STD size_t>(-1) >> 1))
+	{
+		power <<= 1;
+	}
+
+	// bytes is in (power / 2, power], split into four classes of power / 8.
+	const _STD size_t step = power / 8;
+	return (bytes + step - 1) / step * step;
+}
+
+// Rounds the byte size chosen by Base up to the allocator's size class, so the slack malloc adds anyway is used.
+template <class Base = default_growth>
+struct size_class_growth
+{
+	template <class T>
+	NODISCARD static _STD size_t next_capacity(
+		const _STD size_t capacity, const _STD size_t new_size, const _STD size_t max_size) noexcept
+	{
+		const _STD size_t base = Base::template next_capacity<T>(capacity, new_size, max_size);
+
+		if (base > max_size / 2)
+		{
+			return base;
+		}
+
+		const _STD size_t rounded = round_to_size_class(base * sizeof(T)) / sizeof(T);
+		return rounded > max_size ? max_size : rounded;
+	}
+};
+_JSTD_END
+
+#endif // !_JSTD_GROWTH_
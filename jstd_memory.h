@@ -0,0 +1,640 @@
+#pragma once
+#ifndef _JSTD_MEMORY_
+#define _JSTD_MEMORY_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "jstd_core.h"
+
+#if defined(__linux__)
+#include <malloc.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#endif // __linux__
+
+// Buffers of at least this many bytes are mapped directly, so they can be grown with mremap.
+#ifndef JSTD_MREMAP_THRESHOLD
+#define JSTD_MREMAP_THRESHOLD (static_cast<_STD size_t>(1) << 20)
+#endif // !JSTD_MREMAP_THRESHOLD
+
+// Mapped buffers of at least this many bytes are aligned to JSTD_HUGEPAGE_SIZE and advised to use huge pages.
+// Must be a multiple of JSTD_HUGEPAGE_SIZE.
+#ifndef JSTD_HUGEPAGE_THRESHOLD
+#define JSTD_HUGEPAGE_THRESHOLD (static_cast<_STD size_t>(8) << 20)
+#endif // !JSTD_HUGEPAGE_THRESHOLD
+
+#ifndef JSTD_HUGEPAGE_SIZE
+#define JSTD_HUGEPAGE_SIZE (static_cast<_STD size_t>(2) << 20)
+#endif // !JSTD_HUGEPAGE_SIZE
+
+static_assert(JSTD_HUGEPAGE_THRESHOLD >= JSTD_MREMAP_THRESHOLD && JSTD_HUGEPAGE_THRESHOLD % JSTD_HUGEPAGE_SIZE == 0,
+	"JSTD_HUGEPAGE_THRESHOLD must be a multiple of JSTD_HUGEPAGE_SIZE, at least JSTD_MREMAP_THRESHOLD.");
+
+_JSTD_BEGIN
+// Memory obtained from an allocator together with the number of elements it can really hold.
+#if defined(__cpp_lib_allocate_at_least)
+template <class Pointer, class SizeType = _STD size_t>
+using allocation_result = _STD allocation_result<Pointer, SizeType>;
+#else
+template <class Pointer, class SizeType = _STD size_t>
+struct allocation_result
+{
+	Pointer  ptr;
+	SizeType count;
+};
+#endif // __cpp_lib_allocate_at_least
+
+template <class Alloc, class = void>
+inline constexpr bool has_allocate_at_least_v = false;
+
+template <class Alloc>
+inline constexpr bool has_allocate_at_least_v<Alloc,
+	_STD void_t<decltype(_STD declval<Alloc&>().allocate_at_least(_STD declval<_STD size_t>()))>> = true;
+
+// Allocates memory for at least count elements and reports how many actually fit, so the caller can use the slack.
+// Uses allocator_traits::allocate_at_least where the library has it, the allocator's own allocate_at_least()
+// otherwise, and falls back to allocate(), which reports exactly count. Free the memory with the reported count.
+template <class Alloc>
+NODISCARD allocation_result<typename _STD allocator_traits<Alloc>::pointer, typename _STD allocator_traits<Alloc>::size_type>
+	allocate_at_least(Alloc &al, const typename _STD allocator_traits<Alloc>::size_type count)
+{
+#if defined(__cpp_lib_allocate_at_least)
+	const auto result = _STD allocator_traits<Alloc>::allocate_at_least(al, count);
+	return { result.ptr, result.count };
+#else
+	if constexpr (has_allocate_at_least_v<Alloc>)
+	{
+		const auto result = al.allocate_at_least(count);
+		return { result.ptr, result.count };
+	}
+	else
+	{
+		return { _STD allocator_traits<Alloc>::allocate(al, count), count };
+	}
+#endif // __cpp_lib_allocate_at_least
+}
+
+// Native storage: raw memory from malloc, or from mmap for large buffers on Linux.
+// Unlike operator new, a native buffer can be resized in place by native_reallocate().
+// The size passed to native_deallocate() and native_reallocate() must be the one it was obtained with,
+// or the one native_usable_size() reported for it, and the alignment must be the same.
+// Alignments up to alignof(max_align_t) come from malloc, larger ones from the aligned allocation functions.
+// Mapped buffers are page aligned, and past JSTD_HUGEPAGE_THRESHOLD they are aligned to JSTD_HUGEPAGE_SIZE
+// and backed by transparent huge pages where the kernel allows it.
+
+NODISCARD constexpr bool is_over_aligned(const _STD size_t align) noexcept
+{
+	return align > alignof(_STD max_align_t);
+}
+
+#if defined(__linux__)
+NODISCARD inline _STD size_t page_size() noexcept
+{
+	static const _STD size_t size = static_cast<_STD size_t>(::sysconf(_SC_PAGESIZE));
+	return size;
+}
+
+NODISCARD inline _STD size_t round_to_page(const _STD size_t bytes) noexcept
+{
+	const _STD size_t page = page_size();
+	return (bytes + page - 1) / page * page;
+}
+
+NODISCARD inline bool is_mapped_size(const _STD size_t bytes) noexcept
+{
+	return bytes >= JSTD_MREMAP_THRESHOLD;
+}
+
+NODISCARD inline bool is_huge_size(const _STD size_t bytes) noexcept
+{
+	return bytes >= JSTD_HUGEPAGE_THRESHOLD;
+}
+
+// Length of the mapping that backs a mapped buffer of bytes.
+NODISCARD inline _STD size_t mapped_length(const _STD size_t bytes) noexcept
+{
+	if (is_huge_size(bytes))
+	{
+		return (bytes + JSTD_HUGEPAGE_SIZE - 1) / JSTD_HUGEPAGE_SIZE * JSTD_HUGEPAGE_SIZE;
+	}
+
+	return round_to_page(bytes);
+}
+
+inline void advise_huge_pages(void *ptr, const _STD size_t length) noexcept
+{
+#if defined(MADV_HUGEPAGE)
+	// Only a hint, the buffer works the same if transparent huge pages are disabled.
+	::madvise(ptr, length, MADV_HUGEPAGE);
+#else
+	static_cast<void>(ptr);
+	static_cast<void>(length);
+#endif // MADV_HUGEPAGE
+}
+
+// Maps length bytes aligned to JSTD_HUGEPAGE_SIZE, or reserves them without access if reserve is true.
+// Over-maps by one huge page and unmaps the misaligned head and the tail.
+NODISCARD inline char* map_huge_aligned(const _STD size_t length, const bool reserve)
+{
+	const int protection = reserve ? PROT_NONE : PROT_READ | PROT_WRITE;
+	const int flags      = MAP_PRIVATE | MAP_ANONYMOUS | (reserve ? MAP_NORESERVE : 0);
+	void *ptr            = ::mmap(nullptr, length + JSTD_HUGEPAGE_SIZE, protection, flags, -1, 0);
+	if (ptr == MAP_FAILED)
+	{
+		throw _STD bad_alloc();
+	}
+
+	char *first        = static_cast<char*>(ptr);
+	const auto address = reinterpret_cast<_STD uintptr_t>(first);
+	char *aligned      = first + (JSTD_HUGEPAGE_SIZE - address % JSTD_HUGEPAGE_SIZE) % JSTD_HUGEPAGE_SIZE;
+	char *last         = first + length + JSTD_HUGEPAGE_SIZE;
+
+	if (aligned != first)
+	{
+		::munmap(first, static_cast<_STD size_t>(aligned - first));
+	}
+
+	if (aligned + length != last)
+	{
+		::munmap(aligned + length, static_cast<_STD size_t>(last - (aligned + length)));
+	}
+
+	return aligned;
+}
+#endif // __linux__
+
+// malloc for alignments above alignof(max_align_t).
+NODISCARD inline void* aligned_malloc(const _STD size_t bytes, const _STD size_t align) noexcept
+{
+#if defined(_WIN32)
+	return ::_aligned_malloc(bytes, align);
+#else
+	void *ptr = nullptr;
+	return ::posix_memalign(&ptr, align, bytes) == 0 ? ptr : nullptr;
+#endif // _WIN32
+}
+
+inline void aligned_free(void *ptr) noexcept
+{
+#if defined(_WIN32)
+	::_aligned_free(ptr);
+#else
+	_STD free(ptr);
+#endif // _WIN32
+}
+
+NODISCARD inline void* native_allocate(const _STD size_t bytes, const _STD size_t align = alignof(_STD max_align_t))
+{
+	if (bytes == 0)
+	{
+		return nullptr;
+	}
+
+#if defined(__linux__)
+	if (is_huge_size(bytes))
+	{
+		char *ptr = map_huge_aligned(mapped_length(bytes), false);
+		advise_huge_pages(ptr, mapped_length(bytes));
+		return ptr;
+	}
+
+	if (is_mapped_size(bytes))
+	{
+		void *ptr = ::mmap(nullptr, round_to_page(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (ptr == MAP_FAILED)
+		{
+			throw _STD bad_alloc();
+		}
+
+		return ptr;
+	}
+#endif // __linux__
+
+	void *ptr = is_over_aligned(align) ? aligned_malloc(bytes, align) : _STD malloc(bytes);
+	if (ptr == nullptr)
+	{
+		throw _STD bad_alloc();
+	}
+
+	return ptr;
+}
+
+inline void native_deallocate(void *ptr, const _STD size_t bytes, const _STD size_t align = alignof(_STD max_align_t)) noexcept
+{
+	if (ptr == nullptr)
+	{
+		return;
+	}
+
+#if defined(__linux__)
+	if (is_mapped_size(bytes))
+	{
+		::munmap(ptr, mapped_length(bytes));
+		return;
+	}
+#else
+	static_cast<void>(bytes);
+#endif // __linux__
+
+	if (is_over_aligned(align))
+	{
+		aligned_free(ptr);
+	}
+	else
+	{
+		_STD free(ptr);
+	}
+}
+
+// Debug check that ptr can be a native buffer of bytes with this alignment. Mapped buffers are page aligned,
+// so a buffer of a mapped size from operator new or malloc fails it. Smaller ones cannot be told apart.
+NODISCARD inline bool may_be_native_storage(const void *ptr, const _STD size_t bytes, const _STD size_t align) noexcept
+{
+	const auto address = reinterpret_cast<_STD uintptr_t>(ptr);
+
+	if (ptr == nullptr || address % align != 0)
+	{
+		return ptr == nullptr;
+	}
+
+#if defined(__linux__)
+	if (is_mapped_size(bytes))
+	{
+		return address % page_size() == 0;
+	}
+#else
+	static_cast<void>(bytes);
+#endif // __linux__
+
+	return true;
+}
+
+// Number of bytes usable in a native buffer obtained for bytes, at least bytes.
+// A buffer reported with the returned size is still freed and resized the same way.
+NODISCARD inline _STD size_t native_usable_size(
+	void *ptr, const _STD size_t bytes, const _STD size_t align = alignof(_STD max_align_t)) noexcept
+{
+	if (ptr == nullptr)
+	{
+		return bytes;
+	}
+
+#if defined(__linux__)
+	static_cast<void>(align);
+
+	if (is_mapped_size(bytes))
+	{
+		return mapped_length(bytes);
+	}
+
+	// Stay below the threshold, or the buffer would be taken for a mapped one.
+	const _STD size_t usable = ::malloc_usable_size(ptr);
+	return usable < JSTD_MREMAP_THRESHOLD ? usable : JSTD_MREMAP_THRESHOLD - 1;
+#elif defined(_WIN32)
+	return is_over_aligned(align) ? ::_aligned_msize(ptr, align, 0) : ::_msize(ptr);
+#elif defined(__APPLE__)
+	static_cast<void>(align);
+	return ::malloc_size(ptr);
+#else
+	static_cast<void>(align);
+	return bytes;
+#endif // __linux__
+}
+
+// Resizes a native buffer, keeping the first min(old_bytes, new_bytes) bytes.
+// Mapped buffers are moved by remapping their pages, small ones by realloc, so no copy is made when possible.
+// If an exception is thrown, ptr is left untouched.
+NODISCARD inline void* native_reallocate(
+	void *ptr, const _STD size_t old_bytes, const _STD size_t new_bytes, const _STD size_t align = alignof(_STD max_align_t))
+{
+	if (ptr == nullptr)
+	{
+		return native_allocate(new_bytes, align);
+	}
+
+	if (new_bytes == 0)
+	{
+		native_deallocate(ptr, old_bytes, align);
+		return nullptr;
+	}
+
+#if defined(__linux__)
+	const bool old_mapped = is_mapped_size(old_bytes);
+	const bool new_mapped = is_mapped_size(new_bytes);
+
+	if (old_mapped && new_mapped)
+	{
+		const _STD size_t old_length = mapped_length(old_bytes);
+		const _STD size_t new_length = mapped_length(new_bytes);
+
+		if (!is_huge_size(new_bytes))
+		{
+			void *new_ptr = ::mremap(ptr, old_length, new_length, MREMAP_MAYMOVE);
+			if (new_ptr == MAP_FAILED)
+			{
+				throw _STD bad_alloc();
+			}
+
+			return new_ptr;
+		}
+
+		// Huge buffers are kept aligned: an aligned one grows in place if the next pages are free,
+		// otherwise the pages are moved into an aligned reservation.
+		void *new_ptr = MAP_FAILED;
+
+		if (reinterpret_cast<_STD uintptr_t>(ptr) % JSTD_HUGEPAGE_SIZE == 0)
+		{
+			new_ptr = ::mremap(ptr, old_length, new_length, 0);
+		}
+
+		if (new_ptr == MAP_FAILED)
+		{
+			char *target = map_huge_aligned(new_length, true);
+
+			new_ptr = ::mremap(ptr, old_length, new_length, MREMAP_MAYMOVE | MREMAP_FIXED, target);
+			if (new_ptr == MAP_FAILED)
+			{
+				::munmap(target, new_length);
+				throw _STD bad_alloc();
+			}
+		}
+
+		advise_huge_pages(new_ptr, new_length);
+		return new_ptr;
+	}
+
+	// Crossing the threshold changes the kind of memory, so the contents have to be copied once.
+	if (old_mapped != new_mapped)
+	{
+		void *new_ptr = native_allocate(new_bytes, align);
+		_STD memcpy(new_ptr, ptr, old_bytes < new_bytes ? old_bytes : new_bytes);
+		native_deallocate(ptr, old_bytes, align);
+		return new_ptr;
+	}
+#endif // __linux__
+
+	if (is_over_aligned(align))
+	{
+#if defined(_WIN32)
+		void *new_ptr = ::_aligned_realloc(ptr, new_bytes, align);
+		if (new_ptr == nullptr)
+		{
+			throw _STD bad_alloc();
+		}
+
+		return new_ptr;
+#else
+		// realloc does not keep the alignment.
+		void *new_ptr = native_allocate(new_bytes, align);
+		_STD memcpy(new_ptr, ptr, old_bytes < new_bytes ? old_bytes : new_bytes);
+		aligned_free(ptr);
+		return new_ptr;
+#endif // _WIN32
+	}
+
+	void *new_ptr = _STD realloc(ptr, new_bytes);
+	if (new_ptr == nullptr)
+	{
+		throw _STD bad_alloc();
+	}
+
+	return new_ptr;
+}
+
+// Allocator of native storage aligned to Align, or to alignof(T) if that is larger.
+// JVector keeps trivially relocatable elements in native storage with it, so growth still uses realloc or mremap.
+template <class T, _STD size_t Align>
+class aligned_allocator
+{
+public:
+	static_assert(Align != 0 && (Align & (Align - 1)) == 0, "aligned_allocator needs a power of two alignment.");
+	static_assert(Align <= 4096, "aligned_allocator supports alignments up to 4096.");
+
+	static constexpr _STD size_t alignment = Align < alignof(T) ? alignof(T) : Align;
+
+	using value_type                             = T;
+	using size_type                              = _STD size_t;
+	using difference_type                        = _STD ptrdiff_t;
+	using propagate_on_container_move_assignment = _STD true_type;
+	using is_always_equal                        = _STD true_type;
+
+	template <class U>
+	struct rebind
+	{
+		using other = aligned_allocator<U, Align>;
+	};
+
+	aligned_allocator() noexcept = default;
+
+	template <class U>
+	aligned_allocator(const aligned_allocator<U, Align>&) noexcept {}
+
+	NODISCARD T* allocate(const size_type count)
+	{
+		if (count > static_cast<size_type>(-1) / sizeof(T))
+		{
+			throw _STD bad_array_new_length();
+		}
+
+		return static_cast<T*>(native_allocate(count * sizeof(T), alignment));
+	}
+
+	NODISCARD allocation_result<T*, size_type> allocate_at_least(const size_type count)
+	{
+		T *ptr = allocate(count);
+		return { ptr, native_usable_size(ptr, count * sizeof(T), alignment) / sizeof(T) };
+	}
+
+	void deallocate(T *ptr, const size_type count) noexcept
+	{
+		native_deallocate(ptr, count * sizeof(T), alignment);
+	}
+
+	template <class U>
+	NODISCARD bool operator==(const aligned_allocator<U, Align>&) const noexcept
+	{
+		return true;
+	}
+
+	template <class U>
+	NODISCARD bool operator!=(const aligned_allocator<U, Align>&) const noexcept
+	{
+		return false;
+	}
+};
+
+// A bump allocator over a block the caller owns. Allocating moves a pointer and freeing does nothing;
+// reset() takes back every allocation at once, so the block can serve the next batch of temporaries.
+class arena
+{
+public:
+	arena(void *block, const _STD size_t bytes) noexcept
+		: m_begin(static_cast<unsigned char*>(block)),
+		  m_top(static_cast<unsigned char*>(block)),
+		  m_end(static_cast<unsigned char*>(block) + bytes),
+		  m_generation(0)
+		{}
+
+	arena(const arena&) = delete;
+	arena& operator=(const arena&) = delete;
+
+	// Throws bad_alloc once the block is used up.
+	NODISCARD void* allocate(const _STD size_t bytes, const _STD size_t align)
+	{
+		const _STD uintptr_t top     = reinterpret_cast<_STD uintptr_t>(m_top);
+		const _STD size_t padding    = static_cast<_STD size_t>((align - top % align) % align);
+		const _STD size_t available  = static_cast<_STD size_t>(m_end - m_top);
+
+		if (padding > available || bytes > available - padding)
+		{
+			throw _STD bad_alloc();
+		}
+
+		void *ptr = m_top + padding;
+		m_top    += padding + bytes;
+		return ptr;
+	}
+
+	// Every allocation is released and the generation advanced, allocators of the earlier one become stale.
+	void reset() noexcept
+	{
+		m_top = m_begin;
+		++m_generation;
+	}
+
+	NODISCARD _STD size_t used() const noexcept
+	{
+		return static_cast<_STD size_t>(m_top - m_begin);
+	}
+
+	NODISCARD _STD size_t capacity() const noexcept
+	{
+		return static_cast<_STD size_t>(m_end - m_begin);
+	}
+
+	NODISCARD _STD size_t generation() const noexcept
+	{
+		return m_generation;
+	}
+
+private:
+	unsigned char *m_begin;
+	unsigned char *m_top;
+	unsigned char *m_end;
+	_STD size_t   m_generation;
+};
+
+// Allocator handing out memory of an arena. deallocate() is a no-op, the memory comes back with arena::reset().
+// It remembers the generation of its latest allocation, so a container can tell its buffer was reset under it
+// and must not be touched any more. Containers of elements that are not trivially destructible must be cleared
+// before the reset, their destructors cannot run after it.
+template <class T>
+class arena_allocator
+{
+public:
+	using value_type                             = T;
+	using size_type                              = _STD size_t;
+	using difference_type                        = _STD ptrdiff_t;
+	using propagate_on_container_copy_assignment = _STD true_type;
+	using propagate_on_container_move_assignment = _STD true_type;
+	using propagate_on_container_swap            = _STD true_type;
+	using is_always_equal                        = _STD false_type;
+
+	template <class U>
+	struct rebind
+	{
+		using other = arena_allocator<U>;
+	};
+
+	explicit arena_allocator(JSTD::arena &source) noexcept
+		: m_arena(&source),
+		  m_generation(source.generation())
+		{}
+
+	template <class U>
+	arena_allocator(const arena_allocator<U> &other) noexcept
+		: m_arena(other.m_arena),
+		  m_generation(other.m_generation)
+		{}
+
+	NODISCARD T* allocate(const size_type count)
+	{
+		if (count > static_cast<size_type>(-1) / sizeof(T))
+		{
+			throw _STD bad_array_new_length();
+		}
+
+		T *ptr       = static_cast<T*>(m_arena->allocate(count * sizeof(T), alignof(T)));
+		m_generation = m_arena->generation();
+		return ptr;
+	}
+
+	void deallocate(T*, size_type) noexcept {}
+
+	// True once the arena was reset after the latest allocation.
+	NODISCARD bool stale() const noexcept
+	{
+		return m_generation != m_arena->generation();
+	}
+
+	NODISCARD JSTD::arena& source() const noexcept
+	{
+		return *m_arena;
+	}
+
+	template <class U>
+	NODISCARD bool operator==(const arena_allocator<U> &other) const noexcept
+	{
+		return m_arena == other.m_arena;
+	}
+
+	template <class U>
+	NODISCARD bool operator!=(const arena_allocator<U> &other) const noexcept
+	{
+		return m_arena != other.m_arena;
+	}
+
+private:
+	template <class U>
+	friend class arena_allocator;
+
+	JSTD::arena  *m_arena;
+	_STD size_t  m_generation;
+};
+
+template <class Alloc>
+inline constexpr bool is_arena_allocator_v = false;
+
+template <class T>
+inline constexpr bool is_arena_allocator_v<arena_allocator<T>> = true;
+
+// Alignment of the storage Alloc hands out, Align for aligned_allocator and alignof(value_type) otherwise.
+template <class Alloc>
+inline constexpr _STD size_t storage_alignment_v = alignof(typename _STD allocator_traits<Alloc>::value_type);
+
+template <class T, _STD size_t Align>
+inline constexpr _STD size_t storage_alignment_v<aligned_allocator<T, Align>> = aligned_allocator<T, Align>::alignment;
+
+// Allocators whose memory JVector may take from the native storage functions directly.
+template <class Alloc>
+inline constexpr bool is_native_allocator_v = false;
+
+template <class T>
+inline constexpr bool is_native_allocator_v<_STD allocator<T>> = alignof(T) <= alignof(_STD max_align_t);
+
+template <class T, _STD size_t Align>
+inline constexpr bool is_native_allocator_v<aligned_allocator<T, Align>> = true;
+_JSTD_END
+
+#endif // !_JSTD_MEMORY_
@@ -0,0 +1,668 @@
+#pragma once
+#ifndef _JSTD_PARALLEL_
+#define _JSTD_PARALLEL_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "jstd_core.h"
+#include "JVector.h"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif // __linux__
+
+// Bulk algorithms over the contiguous storage of a JVector, run on a work-stealing thread pool.
+// Every algorithm takes a grain size, the smallest number of elements a task is given (0 picks one),
+// and the pool to run on, the default pool unless given.
+_JSTD_BEGIN
+namespace parallel
+{
+	class thread_pool;
+
+	namespace parallel_detail
+	{
+		// Pool and queue index of the worker running on this thread, if any.
+		inline thread_local thread_pool *current_pool  = nullptr;
+		inline thread_local _STD size_t current_worker = 0;
+	} // namespace parallel_detail
+
+	// A fixed set of worker threads. Each worker takes tasks from the back of its own queue and steals from the front
+	// of the others when it runs dry, so large tasks spawned first are the ones that migrate. Threads that are not
+	// workers submit to a shared queue. A thread waiting for tasks runs queued tasks meanwhile.
+	class thread_pool
+	{
+	public:
+		using task = _STD function<void()>;
+
+		// Starts threads workers. If cpus is not empty, worker i is pinned to cpus[i % cpus.size()].
+		explicit thread_pool(unsigned threads = (_STD max)(_STD thread::hardware_concurrency(), 1u),
+			_STD vector<unsigned> cpus = {})
+			: m_cpus(_STD move(cpus)),
+			  m_queued(0),
+			  m_sleeping(0),
+			  m_stop(false)
+		{
+			threads = (_STD max)(threads, 1u);
+
+			// One queue per worker and the shared queue last.
+			for (unsigned i = 0; i <= threads; ++i)
+			{
+				m_queues.push_back(_STD make_unique<task_queue>());
+			}
+
+			try
+			{
+				for (unsigned i = 0; i < threads; ++i)
+				{
+					m_workers.emplace_back(&thread_pool::worker_loop, this, i);
+				}
+			}
+			catch (...)
+			{
+				shutdown();
+				throw;
+			}
+		}
+
+		thread_pool(const thread_pool&) = delete;
+		thread_pool& operator=(const thread_pool&) = delete;
+
+		~thread_pool()
+		{
+			shutdown();
+		}
+
+		NODISCARD _STD size_t size() const noexcept
+		{
+			return m_workers.size();
+		}
+
+		NODISCARD const _STD vector<unsigned>& cpus() const noexcept
+		{
+			return m_cpus;
+		}
+
+		// Queues a task, on the calling worker's own queue if it is one of ours.
+		void submit(task work)
+		{
+			const _STD size_t index = parallel_detail::current_pool == this ? parallel_detail::current_worker : m_workers.size();
+			task_queue &queue       = *m_queues[index];
+
+			{
+				_STD lock_guard<_STD mutex> lock(queue.mutex);
+				queue.tasks.push_back(_STD move(work));
+			}
+
+			m_queued.fetch_add(1);
+
+			if (m_sleeping.load() != 0)
+			{
+				// Taking the mutex orders the notification after a worker that is about to sleep starts waiting.
+				{
+					_STD lock_guard<_STD mutex> lock(m_sleep_mutex);
+				}
+
+				m_wake.notify_one();
+			}
+		}
+
+		// Runs one queued task on the calling thread. Returns false if there was none.
+		bool run_one()
+		{
+			task work;
+
+			if (!take(work))
+			{
+				return false;
+			}
+
+			work();
+			return true;
+		}
+
+	private:
+		struct task_queue
+		{
+			_STD mutex        mutex;
+			_STD deque<task>  tasks;
+		};
+
+		bool take(task &work)
+		{
+			if (m_queued.load() == 0)
+			{
+				return false;
+			}
+
+			const _STD size_t count = m_queues.size();
+			const _STD size_t own   = parallel_detail::current_pool == this ? parallel_detail::current_worker : count - 1;
+
+			// Newest task of our own queue first, then the oldest one of the others.
+			{
+				task_queue &queue = *m_queues[own];
+				_STD lock_guard<_STD mutex> lock(queue.mutex);
+
+				if (!queue.tasks.empty())
+				{
+					work = _STD move(queue.tasks.back());
+					queue.tasks.pop_back();
+					m_queued.fetch_sub(1);
+					return true;
+				}
+			}
+
+			for (_STD size_t i = 1; i < count; ++i)
+			{
+				task_queue &queue = *m_queues[(own + i) % count];
+				_STD lock_guard<_STD mutex> lock(queue.mutex);
+
+				if (!queue.tasks.empty())
+				{
+					work = _STD move(queue.tasks.front());
+					queue.tasks.pop_front();
+					m_queued.fetch_sub(1);
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		void worker_loop(const _STD size_t index)
+		{
+			parallel_detail::current_pool   = this;
+			parallel_detail::current_worker = index;
+			pin_to_cpu(index);
+
+			while (true)
+			{
+				if (run_one())
+				{
+					continue;
+				}
+
+				_STD unique_lock<_STD mutex> lock(m_sleep_mutex);
+				m_sleeping.fetch_add(1);
+				m_wake.wait(lock, [this] { return m_queued.load() != 0 || m_stop.load(); });
+				m_sleeping.fetch_sub(1);
+
+				if (m_stop.load() && m_queued.load() == 0)
+				{
+					return;
+				}
+			}
+		}
+
+		void pin_to_cpu(const _STD size_t index) noexcept
+		{
+			if (m_cpus.empty())
+			{
+				return;
+			}
+
+			const unsigned cpu = m_cpus[index % m_cpus.size()];
+
+#if defined(__linux__)
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			CPU_SET(cpu, &set);
+			::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+#elif defined(_WIN32)
+			::SetThreadAffinityMask(::GetCurrentThread(), static_cast<DWORD_PTR>(1) << cpu);
+#else
+			static_cast<void>(cpu);
+#endif // __linux__
+		}
+
+		void shutdown() noexcept
+		{
+			{
+				_STD lock_guard<_STD mutex> lock(m_sleep_mutex);
+				m_stop.store(true);
+			}
+
+			m_wake.notify_all();
+
+			for (auto &worker : m_workers)
+			{
+				worker.join();
+			}
+
+			m_workers.clear();
+		}
+
+		_STD vector<_STD unique_ptr<task_queue>> m_queues;
+		_STD vector<_STD thread>                 m_workers;
+		_STD vector<unsigned>                    m_cpus;
+		_STD atomic<_STD size_t>                 m_queued;
+		_STD atomic<_STD size_t>                 m_sleeping;
+		_STD atomic<bool>                        m_stop;
+		_STD mutex                               m_sleep_mutex;
+		_STD condition_variable                  m_wake;
+	};
+
+	namespace parallel_detail
+	{
+		inline _STD mutex default_pool_mutex;
+		inline _STD unique_ptr<thread_pool> default_pool;
+	} // namespace parallel_detail
+
+	// The pool the algorithms use unless given one, one worker per hardware thread until configured.
+	NODISCARD inline thread_pool& default_pool()
+	{
+		_STD lock_guard<_STD mutex> lock(parallel_detail::default_pool_mutex);
+
+		if (!parallel_detail::default_pool)
+		{
+			parallel_detail::default_pool = _STD make_unique<thread_pool>();
+		}
+
+		return *parallel_detail::default_pool;
+	}
+
+	// Replaces the default pool, e.g. to pin it to the cores of one socket. It must not be running anything.
+	inline void configure_default_pool(const unsigned threads, _STD vector<unsigned> cpus = {})
+	{
+		auto pool = _STD make_unique<thread_pool>(threads, _STD move(cpus));
+
+		_STD lock_guard<_STD mutex> lock(parallel_detail::default_pool_mutex);
+		parallel_detail::default_pool = _STD move(pool);
+	}
+
+	// Tasks spawned together and waited for together. The first exception a task throws is rethrown by wait().
+	class task_group
+	{
+	public:
+		explicit task_group(thread_pool &pool) noexcept
+			: m_pool(pool),
+			  m_pending(0)
+			{}
+
+		task_group(const task_group&) = delete;
+		task_group& operator=(const task_group&) = delete;
+
+		~task_group()
+		{
+			// Tasks refer to the group, so it cannot go away before they finish.
+			drain();
+		}
+
+		template <class Fn>
+		void spawn(Fn &&fn)
+		{
+			m_pending.fetch_add(1);
+
+			try
+			{
+				m_pool.submit([this, work = _STD forward<Fn>(fn)]() mutable
+				{
+					try
+					{
+						work();
+					}
+					catch (...)
+					{
+						_STD lock_guard<_STD mutex> lock(m_error_mutex);
+						if (!m_error)
+						{
+							m_error = _STD current_exception();
+						}
+					}
+
+					m_pending.fetch_sub(1);
+				});
+			}
+			catch (...)
+			{
+				m_pending.fetch_sub(1);
+				throw;
+			}
+		}
+
+		// Runs queued tasks until all of this group's are done.
+		void wait()
+		{
+			drain();
+
+			if (m_error)
+			{
+				_STD exception_ptr error = _STD move(m_error);
+				m_error = nullptr;
+				_STD rethrow_exception(error);
+			}
+		}
+
+	private:
+		void drain() noexcept
+		{
+			while (m_pending.load() != 0)
+			{
+				try
+				{
+					if (!m_pool.run_one())
+					{
+						_STD this_thread::yield();
+					}
+				}
+				catch (...)
+				{
+					// Tasks of a group catch their own exceptions, nothing reaches here.
+				}
+			}
+		}
+
+		thread_pool              &m_pool;
+		_STD atomic<_STD size_t> m_pending;
+		_STD mutex               m_error_mutex;
+		_STD exception_ptr       m_error;
+	};
+
+	namespace parallel_detail
+	{
+		// About eight tasks per worker, so that stealing can even out uneven chunks.
+		NODISCARD inline _STD size_t pick_grain(const _STD size_t count, const _STD size_t grain, const thread_pool &pool) noexcept
+		{
+			if (grain != 0)
+			{
+				return grain;
+			}
+
+			return (_STD max)(count / (pool.size() * 8), static_cast<_STD size_t>(1024));
+		}
+
+		// Calls fn(first, last) over [first, last) in chunks of at most grain, halving the range and spawning
+		// the upper half each time, so thieves get the largest pieces.
+		template <class Fn>
+		void split_range(task_group &group, _STD size_t first, _STD size_t last, const _STD size_t grain, const Fn &fn)
+		{
+			while (last - first > grain)
+			{
+				const _STD size_t mid = first + (last - first) / 2;
+				group.spawn([&group, mid, last, grain, &fn] { split_range(group, mid, last, grain, fn); });
+				last = mid;
+			}
+
+			fn(first, last);
+		}
+
+		// Runs fn(first, last) over [0, count) on pool, or on the calling thread if one chunk covers it.
+		template <class Fn>
+		void for_chunks(thread_pool &pool, const _STD size_t count, const _STD size_t grain, const Fn &fn)
+		{
+			const _STD size_t chunk = pick_grain(count, grain, pool);
+
+			if (count <= chunk || pool.size() <= 1)
+			{
+				fn(static_cast<_STD size_t>(0), count);
+				return;
+			}
+
+			task_group group(pool);
+			split_range(group, 0, count, chunk, fn);
+			group.wait();
+		}
+
+		// Merges the sorted ranges [first1, last1) and [first2, last2) into raw-or-live dest by moving,
+		// splitting at the median of the larger range so both halves merge in parallel.
+		template <class T, class Compare>
+		void merge(task_group &group, T *first1, T *last1, T *first2, T *last2, T *dest,
+			const _STD size_t grain, const Compare &comp)
+		{
+			while (static_cast<_STD size_t>((last1 - first1) + (last2 - first2)) > grain)
+			{
+				if (last1 - first1 < last2 - first2)
+				{
+					_STD swap(first1, first2);
+					_STD swap(last1, last2);
+				}
+
+				T *mid1 = first1 + (last1 - first1) / 2;
+				T *mid2 = _STD lower_bound(first2, last2, *mid1, comp);
+				T *mid  = dest + (mid1 - first1) + (mid2 - first2);
+
+				group.spawn([&group, mid1, last1, mid2, last2, mid, grain, &comp]
+				{
+					merge(group, mid1, last1, mid2, last2, mid, grain, comp);
+				});
+
+				last1 = mid1;
+				last2 = mid2;
+			}
+
+			_STD merge(_STD make_move_iterator(first1), _STD make_move_iterator(last1),
+				_STD make_move_iterator(first2), _STD make_move_iterator(last2), dest, comp);
+		}
+
+		// Sorts [data, data + count) into data if into_data, into buffer otherwise.
+		template <class T, class Compare>
+		void sort(thread_pool &pool, T *data, T *buffer, const _STD size_t count, const bool into_data,
+			const _STD size_t grain, const Compare &comp)
+		{
+			if (count <= grain)
+			{
+				_STD sort(data, data + count, comp);
+
+				if (!into_data)
+				{
+					_STD move(data, data + count, buffer);
+				}
+
+				return;
+			}
+
+			const _STD size_t half = count / 2;
+
+			{
+				task_group group(pool);
+				group.spawn([&] { sort(pool, data + half, buffer + half, count - half, !into_data, grain, comp); });
+				sort(pool, data, buffer, half, !into_data, grain, comp);
+				group.wait();
+			}
+
+			// The sorted halves are on the other side, merge them back.
+			T *from = into_data ? buffer : data;
+			T *to   = into_data ? data : buffer;
+
+			task_group group(pool);
+			merge(group, from, from + half, from + half, from + count, to, grain, comp);
+			group.wait();
+		}
+	} // namespace parallel_detail
+
+	// Calls fn(element) for every element.
+	template <class T, class Alloc, class Growth, class Fn>
+	void parallel_for_each(JVector<T, Alloc, Growth> &vec, Fn fn, const _STD size_t grain = 0,
+		thread_pool &pool = default_pool())
+	{
+		T *data = vec.data();
+
+		parallel_detail::for_chunks(pool, vec.size(), grain, [data, &fn](const _STD size_t first, const _STD size_t last)
+		{
+			_STD for_each(data + first, data + last, fn);
+		});
+	}
+
+	// Makes out hold fn(element) for every element of in. Trivial results are written straight into
+	// uninitialized storage, so the pages of out are first touched by the threads that fill them.
+	template <class T, class AllocIn, class GrowthIn, class U, class AllocOut, class GrowthOut, class Fn>
+	void parallel_transform(const JVector<T, AllocIn, GrowthIn> &in, JVector<U, AllocOut, GrowthOut> &out, Fn fn,
+		const _STD size_t grain = 0, thread_pool &pool = default_pool())
+	{
+		if constexpr (_STD is_trivial_v<U>)
+		{
+			out.resize_default_init(in.size());
+		}
+		else
+		{
+			out.resize(in.size());
+		}
+
+		const T *source = in.data();
+		U *dest         = out.data();
+
+		parallel_detail::for_chunks(pool, in.size(), grain, [source, dest, &fn](const _STD size_t first, const _STD size_t last)
+		{
+			_STD transform(source + first, source + last, dest + first, fn);
+		});
+	}
+
+	// Sets every element to value.
+	template <class T, class Alloc, class Growth>
+	void parallel_fill(JVector<T, Alloc, Growth> &vec, const T &value, const _STD size_t grain = 0,
+		thread_pool &pool = default_pool())
+	{
+		// value may be an element, keep a copy.
+		const T copy(value);
+		T *data = vec.data();
+
+		parallel_detail::for_chunks(pool, vec.size(), grain, [data, &copy](const _STD size_t first, const _STD size_t last)
+		{
+			if constexpr (_STD is_trivially_copyable_v<T>)
+			{
+				JSTD::simd_fill(data + first, last - first, copy, true);
+			}
+			else
+			{
+				_STD fill(data + first, data + last, copy);
+			}
+		});
+	}
+
+	// Makes dest a copy of source.
+	template <class T, class AllocIn, class GrowthIn, class AllocOut, class GrowthOut>
+	void parallel_copy(const JVector<T, AllocIn, GrowthIn> &source, JVector<T, AllocOut, GrowthOut> &dest,
+		const _STD size_t grain = 0, thread_pool &pool = default_pool())
+	{
+		if (static_cast<const void*>(&source) == static_cast<const void*>(&dest))
+		{
+			return;
+		}
+
+		if constexpr (_STD is_trivial_v<T>)
+		{
+			dest.resize_default_init(source.size());
+		}
+		else
+		{
+			dest.resize(source.size());
+		}
+
+		const T *from = source.data();
+		T *to         = dest.data();
+
+		parallel_detail::for_chunks(pool, source.size(), grain, [from, to](const _STD size_t first, const _STD size_t last)
+		{
+			if constexpr (_STD is_trivially_copyable_v<T>)
+			{
+				_STD memcpy(to + first, from + first, (last - first) * sizeof(T));
+			}
+			else
+			{
+				_STD copy(from + first, from + last, to + first);
+			}
+		});
+	}
+
+	// Folds transform(e) of every element with reduce, like std::transform_reduce:
+	// reduce(...reduce(reduce(init, transform(e0)), transform(e1))..., transform(en-1)).
+	// reduce takes two Results and must be associative. Each chunk starts from the transform of its first element,
+	// only the first one from init, and the chunk results are reduced in order, so reduce need not be commutative.
+	template <class T, class Alloc, class Growth, class Result, class ReduceOp, class TransformOp>
+	NODISCARD Result parallel_transform_reduce(const JVector<T, Alloc, Growth> &vec, Result init, ReduceOp reduce,
+		TransformOp transform, const _STD size_t grain = 0, thread_pool &pool = default_pool())
+	{
+		const _STD size_t count = vec.size();
+		const _STD size_t chunk = parallel_detail::pick_grain(count, grain, pool);
+
+		if (count == 0)
+		{
+			return init;
+		}
+
+		const T *data            = vec.data();
+		const _STD size_t chunks = (count + chunk - 1) / chunk;
+		_STD vector<_STD optional<Result>> partial(chunks);
+
+		parallel_detail::for_chunks(pool, chunks, 1, [&, data](const _STD size_t first, const _STD size_t last)
+		{
+			for (_STD size_t c = first; c != last; ++c)
+			{
+				const T *begin = data + c * chunk;
+				const T *end   = data + (_STD min)(count, (c + 1) * chunk);
+				Result result  = c == 0 ? reduce(init, transform(*begin)) : Result(transform(*begin));
+
+				for (++begin; begin != end; ++begin)
+				{
+					result = reduce(_STD move(result), transform(*begin));
+				}
+
+				partial[c].emplace(_STD move(result));
+			}
+		});
+
+		Result result = _STD move(*partial[0]);
+
+		for (_STD size_t c = 1; c != chunks; ++c)
+		{
+			result = reduce(_STD move(result), _STD move(*partial[c]));
+		}
+
+		return result;
+	}
+
+	// Folds the elements with op, like std::reduce: op takes two Results, the elements convert to Result,
+	// and op must be associative. For an op that takes an accumulator and an element of another type,
+	// use parallel_transform_reduce with a separate transform.
+	template <class T, class Alloc, class Growth, class Result, class BinaryOp = _STD plus<>>
+	NODISCARD Result parallel_reduce(const JVector<T, Alloc, Growth> &vec, Result init, BinaryOp op = BinaryOp(),
+		const _STD size_t grain = 0, thread_pool &pool = default_pool())
+	{
+		static_assert(_STD is_convertible_v<const T&, Result>,
+			"parallel_reduce requires elements convertible to the result, use parallel_transform_reduce.");
+
+		return parallel_transform_reduce(vec, _STD move(init), _STD move(op),
+			[](const T &value) { return static_cast<Result>(value); }, grain, pool);
+	}
+
+	// Sorts the elements with comp, not stably. Chunks are sorted in parallel and merged pairwise with parallel merges,
+	// which takes a temporary buffer of the same size.
+	template <class T, class Alloc, class Growth, class Compare = _STD less<>>
+	void parallel_sort(JVector<T, Alloc, Growth> &vec, Compare comp = Compare(), const _STD size_t grain = 0,
+		thread_pool &pool = default_pool())
+	{
+		const _STD size_t count = vec.size();
+		const _STD size_t chunk = parallel_detail::pick_grain(count, grain, pool);
+
+		if (count <= chunk || pool.size() <= 1)
+		{
+			_STD sort(vec.data(), vec.data() + count, comp);
+			return;
+		}
+
+		JVector<T> buffer;
+		buffer.resize_default_init(count);
+
+		parallel_detail::sort(pool, vec.data(), buffer.data(), count, true, chunk, comp);
+	}
+} // namespace parallel
+_JSTD_END
+
+#endif // !_JSTD_PARALLEL_
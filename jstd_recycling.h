@@ -0,0 +1,448 @@
+#pragma once
+#ifndef _JSTD_RECYCLING_
+#define _JSTD_RECYCLING_
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+#include "jstd_core.h"
+#include "jstd_memory.h"
+
+// Largest buffer kept for reuse, a power of two. Larger ones go straight to native storage.
+#ifndef JSTD_RECYCLING_MAX_BYTES
+#define JSTD_RECYCLING_MAX_BYTES (static_cast<_STD size_t>(1) << 20)
+#endif // !JSTD_RECYCLING_MAX_BYTES
+
+// Default limits of the bytes kept by each thread and by the shared depot.
+#ifndef JSTD_RECYCLING_THREAD_BYTES
+#define JSTD_RECYCLING_THREAD_BYTES (static_cast<_STD size_t>(8) << 20)
+#endif // !JSTD_RECYCLING_THREAD_BYTES
+
+#ifndef JSTD_RECYCLING_GLOBAL_BYTES
+#define JSTD_RECYCLING_GLOBAL_BYTES (static_cast<_STD size_t>(64) << 20)
+#endif // !JSTD_RECYCLING_GLOBAL_BYTES
+
+static_assert((JSTD_RECYCLING_MAX_BYTES & (JSTD_RECYCLING_MAX_BYTES - 1)) == 0 && JSTD_RECYCLING_MAX_BYTES >= 64,
+	"JSTD_RECYCLING_MAX_BYTES must be a power of two of at least 64.");
+
+_JSTD_BEGIN
+// Counters of the recycling pool. A hit is a buffer served from a free list, a miss one taken from native storage.
+struct recycling_stats
+{
+	_STD size_t hits;
+	_STD size_t misses;
+	_STD size_t depot_fetches; // batches a thread took from the depot
+	_STD size_t depot_returns; // batches a thread handed to the depot
+	_STD size_t cached_bytes;  // bytes kept in free lists
+};
+
+namespace recycling_detail
+{
+	// Size classes are the powers of two from 64 bytes to JSTD_RECYCLING_MAX_BYTES.
+	inline constexpr _STD size_t min_class_bytes = 64;
+
+	NODISCARD constexpr _STD size_t class_count() noexcept
+	{
+		_STD size_t count = 1;
+
+		for (_STD size_t bytes = min_class_bytes; bytes < JSTD_RECYCLING_MAX_BYTES; bytes <<= 1)
+		{
+			++count;
+		}
+
+		return count;
+	}
+
+	inline constexpr _STD size_t classes = class_count();
+
+	NODISCARD constexpr _STD size_t size_class(const _STD size_t bytes) noexcept
+	{
+		_STD size_t index = 0;
+
+		for (_STD size_t size = min_class_bytes; size < bytes; size <<= 1)
+		{
+			++index;
+		}
+
+		return index;
+	}
+
+	NODISCARD constexpr _STD size_t class_bytes(const _STD size_t index) noexcept
+	{
+		return min_class_bytes << index;
+	}
+
+	// Free buffers are linked through their first bytes. The first buffer of a batch also links the next batch.
+	struct free_node
+	{
+		free_node   *next;
+		free_node   *next_batch;
+		_STD size_t count;
+	};
+
+	inline _STD atomic<_STD size_t> thread_limit(JSTD_RECYCLING_THREAD_BYTES);
+	inline _STD atomic<_STD size_t> global_limit(JSTD_RECYCLING_GLOBAL_BYTES);
+
+	// Buffers shared between threads, in batches so that a thread takes one lock per batch rather than per buffer.
+	class depot
+	{
+	public:
+		depot() noexcept
+			: m_bytes(0),
+			  m_batches{},
+			  m_exited{}
+			{}
+
+		depot(const depot&) = delete;
+		depot& operator=(const depot&) = delete;
+
+		// Keeps the batch unless that would exceed the global limit, in which case it is freed.
+		void put(free_node *batch, const _STD size_t index) noexcept
+		{
+			const _STD size_t bytes = batch->count * class_bytes(index);
+
+			{
+				_STD lock_guard<_STD mutex> lock(m_mutex);
+
+				if (m_bytes + bytes <= global_limit.load(_STD memory_order_relaxed))
+				{
+					batch->next_batch = m_batches[index];
+					m_batches[index]  = batch;
+					m_bytes          += bytes;
+					return;
+				}
+			}
+
+			release_batch(batch, index);
+		}
+
+		NODISCARD free_node* take(const _STD size_t index) noexcept
+		{
+			_STD lock_guard<_STD mutex> lock(m_mutex);
+			free_node *batch = m_batches[index];
+
+			if (batch != nullptr)
+			{
+				m_batches[index] = batch->next_batch;
+				m_bytes         -= batch->count * class_bytes(index);
+			}
+
+			return batch;
+		}
+
+		NODISCARD _STD size_t bytes() noexcept
+		{
+			_STD lock_guard<_STD mutex> lock(m_mutex);
+			return m_bytes;
+		}
+
+		// Counters of threads that have exited.
+		void add_exited(const recycling_stats &stats) noexcept
+		{
+			_STD lock_guard<_STD mutex> lock(m_mutex);
+			m_exited.hits          += stats.hits;
+			m_exited.misses        += stats.misses;
+			m_exited.depot_fetches += stats.depot_fetches;
+			m_exited.depot_returns += stats.depot_returns;
+		}
+
+		NODISCARD recycling_stats exited() noexcept
+		{
+			_STD lock_guard<_STD mutex> lock(m_mutex);
+			return m_exited;
+		}
+
+		static void release_batch(free_node *batch, const _STD size_t index) noexcept
+		{
+			while (batch != nullptr)
+			{
+				free_node *next = batch->next;
+				native_deallocate(batch, class_bytes(index));
+				batch = next;
+			}
+		}
+
+	private:
+		_STD mutex      m_mutex;
+		_STD size_t     m_bytes;
+		free_node       *m_batches[classes];
+		recycling_stats m_exited;
+	};
+
+	// Never destroyed, vectors with static storage duration may free their buffers after static destruction began.
+	NODISCARD inline depot& shared_depot() noexcept
+	{
+		static depot *instance = new depot();
+		return *instance;
+	}
+
+	// Free lists of one thread, handed to the depot when the thread exits.
+	class thread_cache
+	{
+	public:
+		thread_cache() noexcept
+			: m_lists{},
+			  m_counts{},
+			  m_bytes(0),
+			  m_stats{},
+			  m_depot(shared_depot())
+			{}
+
+		thread_cache(const thread_cache&) = delete;
+		thread_cache& operator=(const thread_cache&) = delete;
+
+		~thread_cache();
+
+		NODISCARD void* allocate(const _STD size_t index)
+		{
+			if (m_lists[index] == nullptr)
+			{
+				free_node *batch = m_depot.take(index);
+
+				if (batch == nullptr)
+				{
+					++m_stats.misses;
+					return native_allocate(class_bytes(index));
+				}
+
+				++m_stats.depot_fetches;
+				m_lists[index]  = batch;
+				m_counts[index] = batch->count;
+				m_bytes        += batch->count * class_bytes(index);
+			}
+
+			free_node *node  = m_lists[index];
+			m_lists[index]   = node->next;
+			m_counts[index] -= 1;
+			m_bytes         -= class_bytes(index);
+			++m_stats.hits;
+			return node;
+		}
+
+		void deallocate(void *ptr, const _STD size_t index) noexcept
+		{
+			free_node *node = static_cast<free_node*>(ptr);
+			node->next      = m_lists[index];
+			m_lists[index]  = node;
+			m_counts[index] += 1;
+			m_bytes         += class_bytes(index);
+
+			const _STD size_t limit = thread_limit.load(_STD memory_order_relaxed);
+
+			if (m_bytes > limit)
+			{
+				// Half of the list just grown first, then the largest classes until the thread is under its limit.
+				spill(index);
+
+				for (_STD size_t other = classes; m_bytes > limit && other-- != 0;)
+				{
+					while (m_bytes > limit && m_lists[other] != nullptr)
+					{
+						spill(other);
+					}
+				}
+			}
+		}
+
+		NODISCARD recycling_stats stats() const noexcept
+		{
+			recycling_stats result = m_stats;
+			result.cached_bytes    = m_bytes;
+			return result;
+		}
+
+	private:
+		// Hands the older half of a free list, at least one buffer, to the depot.
+		void spill(const _STD size_t index) noexcept
+		{
+			const _STD size_t keep = m_counts[index] / 2;
+			free_node **link       = &m_lists[index];
+
+			for (_STD size_t i = 0; i < keep; ++i)
+			{
+				link = &(*link)->next;
+			}
+
+			free_node *batch = *link;
+			*link            = nullptr;
+			batch->count     = m_counts[index] - keep;
+			m_counts[index]  = keep;
+			m_bytes         -= batch->count * class_bytes(index);
+			++m_stats.depot_returns;
+			m_depot.put(batch, index);
+		}
+
+		free_node       *m_lists[classes];
+		_STD size_t     m_counts[classes];
+		_STD size_t     m_bytes;
+		recycling_stats m_stats;
+		depot           &m_depot;
+	};
+
+	// Set once the cache of this thread is gone, buffers freed later during thread exit go to the depot directly.
+	inline thread_local bool cache_destroyed = false;
+
+	inline thread_cache::~thread_cache()
+	{
+		cache_destroyed = true;
+
+		for (_STD size_t index = 0; index < classes; ++index)
+		{
+			if (m_lists[index] != nullptr)
+			{
+				m_lists[index]->count = m_counts[index];
+				m_depot.put(m_lists[index], index);
+			}
+		}
+
+		m_depot.add_exited(m_stats);
+	}
+
+	NODISCARD inline thread_cache& local_cache() noexcept
+	{
+		static thread_local thread_cache cache;
+		return cache;
+	}
+
+	NODISCARD inline void* allocate(const _STD size_t bytes)
+	{
+		if (bytes > JSTD_RECYCLING_MAX_BYTES)
+		{
+			return native_allocate(bytes);
+		}
+
+		const _STD size_t index = size_class(bytes);
+
+		if (cache_destroyed)
+		{
+			return native_allocate(class_bytes(index));
+		}
+
+		return local_cache().allocate(index);
+	}
+
+	inline void deallocate(void *ptr, const _STD size_t bytes) noexcept
+	{
+		if (bytes > JSTD_RECYCLING_MAX_BYTES)
+		{
+			native_deallocate(ptr, bytes);
+			return;
+		}
+
+		const _STD size_t index = size_class(bytes);
+
+		if (cache_destroyed)
+		{
+			free_node *node = static_cast<free_node*>(ptr);
+			node->next      = nullptr;
+			node->count     = 1;
+			shared_depot().put(node, index);
+			return;
+		}
+
+		local_cache().deallocate(ptr, index);
+	}
+} // namespace recycling_detail
+
+// Limits of the bytes each thread keeps, beyond which half a free list moves to the depot,
+// and of the bytes the depot keeps, beyond which buffers are freed.
+inline void set_recycling_limits(const _STD size_t thread_bytes, const _STD size_t global_bytes) noexcept
+{
+	recycling_detail::thread_limit.store(thread_bytes, _STD memory_order_relaxed);
+	recycling_detail::global_limit.store(global_bytes, _STD memory_order_relaxed);
+}
+
+// Counters of the calling thread, cached_bytes is what its free lists hold.
+NODISCARD inline recycling_stats recycling_thread_stats() noexcept
+{
+	return recycling_detail::local_cache().stats();
+}
+
+// Counters of the calling thread and of every exited one, cached_bytes is what the depot holds.
+NODISCARD inline recycling_stats recycling_global_stats() noexcept
+{
+	recycling_detail::depot &depot = recycling_detail::shared_depot();
+	recycling_stats result         = depot.exited();
+	const recycling_stats local    = recycling_detail::local_cache().stats();
+
+	result.hits          += local.hits;
+	result.misses        += local.misses;
+	result.depot_fetches += local.depot_fetches;
+	result.depot_returns += local.depot_returns;
+	result.cached_bytes   = depot.bytes();
+	return result;
+}
+
+// Allocator that keeps freed buffers in thread local free lists, one per power of two size class, instead of
+// returning them to malloc. Vectors of similar sizes created and destroyed in a loop then reuse the same buffers.
+// Buffers freed on another thread join that thread's lists. allocate_at_least() reports the whole size class,
+// so a JVector grows into it without reallocating.
+template <class T>
+class recycling_allocator
+{
+public:
+	static_assert(alignof(T) <= alignof(_STD max_align_t), "recycling_allocator does not support over-aligned types.");
+
+	using value_type                             = T;
+	using size_type                              = _STD size_t;
+	using difference_type                        = _STD ptrdiff_t;
+	using propagate_on_container_move_assignment = _STD true_type;
+	using is_always_equal                        = _STD true_type;
+
+	template <class U>
+	struct rebind
+	{
+		using other = recycling_allocator<U>;
+	};
+
+	recycling_allocator() noexcept = default;
+
+	template <class U>
+	recycling_allocator(const recycling_allocator<U>&) noexcept {}
+
+	NODISCARD T* allocate(const size_type count)
+	{
+		return allocate_at_least(count).ptr;
+	}
+
+	NODISCARD allocation_result<T*, size_type> allocate_at_least(const size_type count)
+	{
+		if (count > static_cast<size_type>(-1) / sizeof(T))
+		{
+			throw _STD bad_array_new_length();
+		}
+
+		const _STD size_t bytes = count * sizeof(T);
+		T *ptr                  = static_cast<T*>(recycling_detail::allocate(bytes));
+
+		if (bytes > JSTD_RECYCLING_MAX_BYTES)
+		{
+			return { ptr, count };
+		}
+
+		return { ptr, recycling_detail::class_bytes(recycling_detail::size_class(bytes)) / sizeof(T) };
+	}
+
+	void deallocate(T *ptr, const size_type count) noexcept
+	{
+		recycling_detail::deallocate(ptr, count * sizeof(T));
+	}
+
+	template <class U>
+	NODISCARD bool operator==(const recycling_allocator<U>&) const noexcept
+	{
+		return true;
+	}
+
+	template <class U>
+	NODISCARD bool operator!=(const recycling_allocator<U>&) const noexcept
+	{
+		return false;
+	}
+};
+_JSTD_END
+
+#endif // !_JSTD_RECYCLING_
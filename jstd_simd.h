@@ -0,0 +1,1040 @@
+#pragma once
+#ifndef _JSTD_SIMD_
+#define _JSTD_SIMD_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "jstd_core.h"
+
+// SIMD kernels are built for x86-64, where SSE2 is always available. Define JSTD_NO_SIMD to use scalar code only.
+#if !defined(JSTD_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64))
+#define JSTD_SIMD_X86 1
+#endif // !JSTD_NO_SIMD && x86-64
+
+#if defined(JSTD_SIMD_X86)
+#include <immintrin.h>
+#endif // JSTD_SIMD_X86
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif // _MSC_VER
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif // __linux__
+
+// Copies of at least this many bytes are split across the threads set by set_copy_threads().
+#ifndef JSTD_PARALLEL_COPY_THRESHOLD
+#define JSTD_PARALLEL_COPY_THRESHOLD (static_cast<_STD size_t>(64) << 20)
+#endif // !JSTD_PARALLEL_COPY_THRESHOLD
+
+// Compiles a function for an instruction set above the one the translation unit is built for.
+// MSVC accepts the intrinsics of every instruction set without it.
+#if defined(__GNUC__) || defined(__clang__)
+#define JSTD_TARGET(isa) __attribute__((target(isa)))
+#else
+#define JSTD_TARGET(isa)
+#endif // __GNUC__ || __clang__
+
+_JSTD_BEGIN
+// Element types whose comparisons have SIMD kernels. Integral types are compared as bytes,
+// float and double lane by lane, so NaN and signed zeros compare as they do with the scalar operators.
+template <class T>
+inline constexpr bool is_simd_comparable_v =
+	_STD is_integral_v<T> || _STD is_same_v<T, float> || _STD is_same_v<T, double>;
+
+struct cpu_features
+{
+	bool popcnt;
+	bool avx2;
+	bool avx512f;
+	bool avx512bw;
+};
+
+// Instruction sets usable on this CPU, detected once.
+NODISCARD inline const cpu_features& detect_cpu_features() noexcept
+{
+	static const cpu_features features = []() noexcept
+	{
+		cpu_features result = {};
+
+#if defined(JSTD_SIMD_X86)
+#if defined(__GNUC__) || defined(__clang__)
+		__builtin_cpu_init();
+		result.popcnt   = __builtin_cpu_supports("popcnt");
+		result.avx2     = __builtin_cpu_supports("avx2");
+		result.avx512f  = __builtin_cpu_supports("avx512f");
+		result.avx512bw = __builtin_cpu_supports("avx512bw");
+#elif defined(_MSC_VER)
+		int regs[4];
+		__cpuid(regs, 0);
+		const int max_leaf = regs[0];
+
+		__cpuid(regs, 1);
+		result.popcnt           = (regs[2] & (1 << 23)) != 0;
+		const bool os_saves_ymm = (regs[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x06) == 0x06;
+		const bool os_saves_zmm = os_saves_ymm && (_xgetbv(0) & 0xE6) == 0xE6;
+
+		if (max_leaf >= 7)
+		{
+			__cpuidx(regs, 7, 0);
+			result.avx2     = os_saves_ymm && (regs[1] & (1 << 5)) != 0;
+			result.avx512f  = os_saves_zmm && (regs[1] & (1 << 16)) != 0;
+			result.avx512bw = result.avx512f && (regs[1] & (1 << 30)) != 0;
+		}
+#endif // __GNUC__ || __clang__
+#endif // JSTD_SIMD_X86
+
+		return result;
+	}();
+
+	return features;
+}
+
+namespace simd_detail
+{
+	// Ordered kernels look for the first pair where a < b or b < a, as lexicographical_compare does.
+	// The others look for the first pair where !(a == b), as equal does. Both agree on integral types.
+	template <class T, bool Ordered>
+	NODISCARD inline bool differs(const T a, const T b) noexcept
+	{
+		if constexpr (Ordered)
+		{
+			return a < b || b < a;
+		}
+		else
+		{
+			return !(a == b);
+		}
+	}
+
+	template <class T, bool Ordered>
+	NODISCARD inline _STD size_t mismatch_scalar(const T *a, const T *b, _STD size_t first, const _STD size_t count) noexcept
+	{
+		for (; first != count; ++first)
+		{
+			if (differs<T, Ordered>(a[first], b[first]))
+			{
+				break;
+			}
+		}
+
+		return first;
+	}
+
+	template <class T, bool Ordered>
+	using mismatch_kernel = _STD size_t (*)(const T*, const T*, _STD size_t) noexcept;
+
+#if defined(JSTD_SIMD_X86)
+	NODISCARD inline unsigned count_trailing_zeros(const _STD uint64_t mask) noexcept
+	{
+#if defined(_MSC_VER) && !defined(__clang__)
+		unsigned long index;
+		_BitScanForward64(&index, mask);
+		return static_cast<unsigned>(index);
+#else
+		return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif // _MSC_VER
+	}
+
+	// Byte kernels, used for integral types.
+
+	NODISCARD inline _STD size_t mismatch_bytes_sse2(
+		const unsigned char *a, const unsigned char *b, const _STD size_t count) noexcept
+	{
+		_STD size_t i = 0;
+
+		for (; i + 16 <= count; i += 16)
+		{
+			const __m128i x   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+			const __m128i y   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+			const unsigned eq = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)));
+
+			if (eq != 0xFFFF)
+			{
+				return i + count_trailing_zeros(~eq);
+			}
+		}
+
+		return mismatch_scalar<unsigned char, false>(a, b, i, count);
+	}
+
+	JSTD_TARGET("avx2")
+	NODISCARD inline _STD size_t mismatch_bytes_avx2(
+		const unsigned char *a, const unsigned char *b, const _STD size_t count) noexcept
+	{
+		_STD size_t i = 0;
+
+		// Two vectors per iteration, the mismatch is located only once one is found.
+		for (; i + 64 <= count; i += 64)
+		{
+			const __m256i eq0 = _mm256_cmpeq_epi8(
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+			const __m256i eq1 = _mm256_cmpeq_epi8(
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i + 32)),
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i + 32)));
+
+			if (static_cast<unsigned>(_mm256_movemask_epi8(_mm256_and_si256(eq0, eq1))) != 0xFFFFFFFFu)
+			{
+				const _STD uint64_t low  = static_cast<unsigned>(_mm256_movemask_epi8(eq0));
+				const _STD uint64_t high = static_cast<unsigned>(_mm256_movemask_epi8(eq1));
+				return i + count_trailing_zeros(~(low | high << 32));
+			}
+		}
+
+		for (; i + 32 <= count; i += 32)
+		{
+			const unsigned eq = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)))));
+
+			if (eq != 0xFFFFFFFFu)
+			{
+				return i + count_trailing_zeros(~eq);
+			}
+		}
+
+		return i + mismatch_bytes_sse2(a + i, b + i, count - i);
+	}
+
+	JSTD_TARGET("avx512f,avx512bw")
+	NODISCARD inline _STD size_t mismatch_bytes_avx512(
+		const unsigned char *a, const unsigned char *b, const _STD size_t count) noexcept
+	{
+		_STD size_t i = 0;
+
+		for (; i + 64 <= count; i += 64)
+		{
+			const __mmask64 ne = _mm512_cmpneq_epi8_mask(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+
+			if (ne != 0)
+			{
+				return i + count_trailing_zeros(ne);
+			}
+		}
+
+		// The tail is read with a masked load, which does not touch the bytes past the end.
+		if (i != count)
+		{
+			const __mmask64 tail = ~_STD uint64_t(0) >> (64 - (count - i));
+			const __mmask64 ne   = _mm512_mask_cmpneq_epi8_mask(
+				tail, _mm512_maskz_loadu_epi8(tail, a + i), _mm512_maskz_loadu_epi8(tail, b + i));
+
+			return ne != 0 ? i + count_trailing_zeros(ne) : count;
+		}
+
+		return count;
+	}
+
+	// Floating point kernels, one lane per element.
+
+	template <class T, bool Ordered>
+	NODISCARD inline _STD size_t mismatch_float_sse2(const T *a, const T *b, const _STD size_t count) noexcept
+	{
+		constexpr _STD size_t lanes = 16 / sizeof(T);
+		_STD size_t i               = 0;
+
+		for (; i + lanes <= count; i += lanes)
+		{
+			unsigned ne;
+
+			if constexpr (_STD is_same_v<T, float>)
+			{
+				const __m128 x = _mm_loadu_ps(a + i);
+				const __m128 y = _mm_loadu_ps(b + i);
+				ne = static_cast<unsigned>(_mm_movemask_ps(
+					Ordered ? _mm_or_ps(_mm_cmplt_ps(x, y), _mm_cmplt_ps(y, x)) : _mm_cmpneq_ps(x, y)));
+			}
+			else
+			{
+				const __m128d x = _mm_loadu_pd(a + i);
+				const __m128d y = _mm_loadu_pd(b + i);
+				ne = static_cast<unsigned>(_mm_movemask_pd(
+					Ordered ? _mm_or_pd(_mm_cmplt_pd(x, y), _mm_cmplt_pd(y, x)) : _mm_cmpneq_pd(x, y)));
+			}
+
+			if (ne != 0)
+			{
+				return i + count_trailing_zeros(ne);
+			}
+		}
+
+		return mismatch_scalar<T, Ordered>(a, b, i, count);
+	}
+
+	template <class T, bool Ordered>
+	JSTD_TARGET("avx2")
+	NODISCARD inline _STD size_t mismatch_float_avx2(const T *a, const T *b, const _STD size_t count) noexcept
+	{
+		constexpr int predicate     = Ordered ? _CMP_NEQ_OQ : _CMP_NEQ_UQ;
+		constexpr _STD size_t lanes = 32 / sizeof(T);
+		_STD size_t i               = 0;
+
+		for (; i + lanes <= count; i += lanes)
+		{
+			unsigned ne;
+
+			if constexpr (_STD is_same_v<T, float>)
+			{
+				ne = static_cast<unsigned>(_mm256_movemask_ps(
+					_mm256_cmp_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), predicate)));
+			}
+			else
+			{
+				ne = static_cast<unsigned>(_mm256_movemask_pd(
+					_mm256_cmp_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), predicate)));
+			}
+
+			if (ne != 0)
+			{
+				return i + count_trailing_zeros(ne);
+			}
+		}
+
+		return mismatch_scalar<T, Ordered>(a, b, i, count);
+	}
+
+	template <class T, bool Ordered>
+	JSTD_TARGET("avx512f")
+	NODISCARD inline _STD size_t mismatch_float_avx512(const T *a, const T *b, const _STD size_t count) noexcept
+	{
+		constexpr int predicate     = Ordered ? _CMP_NEQ_OQ : _CMP_NEQ_UQ;
+		constexpr _STD size_t lanes = 64 / sizeof(T);
+		_STD size_t i               = 0;
+
+		for (; i + lanes <= count; i += lanes)
+		{
+			unsigned ne;
+
+			if constexpr (_STD is_same_v<T, float>)
+			{
+				ne = _mm512_cmp_ps_mask(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), predicate);
+			}
+			else
+			{
+				ne = _mm512_cmp_pd_mask(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i), predicate);
+			}
+
+			if (ne != 0)
+			{
+				return i + count_trailing_zeros(ne);
+			}
+		}
+
+		// Masked-off lanes compare equal under both predicates, so they never report a mismatch.
+		if (i != count)
+		{
+			unsigned ne;
+
+			if constexpr (_STD is_same_v<T, float>)
+			{
+				const __mmask16 tail = static_cast<__mmask16>(0xFFFFu >> (16 - (count - i)));
+				ne = _mm512_mask_cmp_ps_mask(tail, _mm512_maskz_loadu_ps(tail, a + i), _mm512_maskz_loadu_ps(tail, b + i), predicate);
+			}
+			else
+			{
+				const __mmask8 tail = static_cast<__mmask8>(0xFFu >> (8 - (count - i)));
+				ne = _mm512_mask_cmp_pd_mask(tail, _mm512_maskz_loadu_pd(tail, a + i), _mm512_maskz_loadu_pd(tail, b + i), predicate);
+			}
+
+			return ne != 0 ? i + count_trailing_zeros(ne) : count;
+		}
+
+		return count;
+	}
+#endif // JSTD_SIMD_X86
+
+	template <class T, bool Ordered>
+	NODISCARD inline _STD size_t mismatch_portable(const T *a, const T *b, const _STD size_t count) noexcept
+	{
+		return mismatch_scalar<T, Ordered>(a, b, 0, count);
+	}
+
+	// Picks the widest kernel the CPU supports.
+	template <class T, bool Ordered>
+	NODISCARD inline mismatch_kernel<T, Ordered> select_mismatch_kernel() noexcept
+	{
+#if defined(JSTD_SIMD_X86)
+		const cpu_features &features = detect_cpu_features();
+
+		if constexpr (_STD is_integral_v<T>)
+		{
+			if (features.avx512bw)
+			{
+				return [](const T *a, const T *b, const _STD size_t count) noexcept
+				{
+					return mismatch_bytes_avx512(reinterpret_cast<const unsigned char*>(a),
+						reinterpret_cast<const unsigned char*>(b), count * sizeof(T)) / sizeof(T);
+				};
+			}
+
+			if (features.avx2)
+			{
+				return [](const T *a, const T *b, const _STD size_t count) noexcept
+				{
+					return mismatch_bytes_avx2(reinterpret_cast<const unsigned char*>(a),
+						reinterpret_cast<const unsigned char*>(b), count * sizeof(T)) / sizeof(T);
+				};
+			}
+
+			return [](const T *a, const T *b, const _STD size_t count) noexcept
+			{
+				return mismatch_bytes_sse2(reinterpret_cast<const unsigned char*>(a),
+					reinterpret_cast<const unsigned char*>(b), count * sizeof(T)) / sizeof(T);
+			};
+		}
+		else
+		{
+			if (features.avx512f)
+			{
+				return &mismatch_float_avx512<T, Ordered>;
+			}
+
+			if (features.avx2)
+			{
+				return &mismatch_float_avx2<T, Ordered>;
+			}
+
+			return &mismatch_float_sse2<T, Ordered>;
+		}
+#else
+		return &mismatch_portable<T, Ordered>;
+#endif // JSTD_SIMD_X86
+	}
+
+	template <class T, bool Ordered>
+	NODISCARD inline _STD size_t mismatch(const T *a, const T *b, const _STD size_t count) noexcept
+	{
+		static_assert(is_simd_comparable_v<T>, "No SIMD comparison for this type.");
+
+		static const mismatch_kernel<T, Ordered> kernel = select_mismatch_kernel<T, Ordered>();
+		return kernel(a, b, count);
+	}
+} // namespace simd_detail
+
+// Index of the first i in [0, count) with !(a[i] == b[i]), or count if there is none.
+template <class T>
+NODISCARD inline _STD size_t simd_mismatch(const T *a, const T *b, const _STD size_t count) noexcept
+{
+	return simd_detail::mismatch<T, false>(a, b, count);
+}
+
+// Index of the first i in [0, count) with a[i] < b[i] or b[i] < a[i], or count if there is none.
+// Differs from simd_mismatch() only for NaN, which lexicographical_compare skips.
+template <class T>
+NODISCARD inline _STD size_t simd_ordered_mismatch(const T *a, const T *b, const _STD size_t count) noexcept
+{
+	return simd_detail::mismatch<T, _STD is_floating_point_v<T>>(a, b, count);
+}
+// Fills and copies of at least this many bytes may bypass the caches with streaming stores, so they do not evict
+// the working set of other threads. Defaults to the size of the last level cache.
+NODISCARD inline _STD size_t streaming_store_threshold() noexcept
+{
+#if defined(JSTD_STREAMING_THRESHOLD)
+	return JSTD_STREAMING_THRESHOLD;
+#else
+	static const _STD size_t threshold = []() noexcept
+	{
+		long size = 0;
+
+#if defined(__linux__) && defined(_SC_LEVEL3_CACHE_SIZE)
+		size = ::sysconf(_SC_LEVEL3_CACHE_SIZE);
+		if (size <= 0)
+		{
+			size = ::sysconf(_SC_LEVEL2_CACHE_SIZE);
+		}
+#endif // __linux__ && _SC_LEVEL3_CACHE_SIZE
+
+		return size > 0 ? static_cast<_STD size_t>(size) : static_cast<_STD size_t>(32) << 20;
+	}();
+
+	return threshold;
+#endif // JSTD_STREAMING_THRESHOLD
+}
+
+namespace simd_detail
+{
+	// Fill kernels store a 64-byte pattern over [first, first + bytes), first 64-byte aligned
+	// and bytes a multiple of 64. With stream, the stores bypass the caches.
+	using fill_kernel = void (*)(unsigned char*, _STD size_t, const unsigned char*, bool) noexcept;
+
+	inline void fill_blocks_portable(
+		unsigned char *first, const _STD size_t bytes, const unsigned char *pattern, bool) noexcept
+	{
+		for (_STD size_t i = 0; i != bytes; i += 64)
+		{
+			_STD memcpy(first + i, pattern, 64);
+		}
+	}
+
+#if defined(JSTD_SIMD_X86)
+	inline void fill_blocks_sse2(
+		unsigned char *first, const _STD size_t bytes, const unsigned char *pattern, const bool stream) noexcept
+	{
+		const __m128i p0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern));
+		const __m128i p1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern + 16));
+		const __m128i p2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern + 32));
+		const __m128i p3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern + 48));
+
+		for (_STD size_t i = 0; i != bytes; i += 64)
+		{
+			__m128i *block = reinterpret_cast<__m128i*>(first + i);
+
+			if (stream)
+			{
+				_mm_stream_si128(block, p0);
+				_mm_stream_si128(block + 1, p1);
+				_mm_stream_si128(block + 2, p2);
+				_mm_stream_si128(block + 3, p3);
+			}
+			else
+			{
+				_mm_store_si128(block, p0);
+				_mm_store_si128(block + 1, p1);
+				_mm_store_si128(block + 2, p2);
+				_mm_store_si128(block + 3, p3);
+			}
+		}
+	}
+
+	JSTD_TARGET("avx2")
+	inline void fill_blocks_avx2(
+		unsigned char *first, const _STD size_t bytes, const unsigned char *pattern, const bool stream) noexcept
+	{
+		const __m256i p0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pattern));
+		const __m256i p1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pattern + 32));
+
+		for (_STD size_t i = 0; i != bytes; i += 64)
+		{
+			__m256i *block = reinterpret_cast<__m256i*>(first + i);
+
+			if (stream)
+			{
+				_mm256_stream_si256(block, p0);
+				_mm256_stream_si256(block + 1, p1);
+			}
+			else
+			{
+				_mm256_store_si256(block, p0);
+				_mm256_store_si256(block + 1, p1);
+			}
+		}
+	}
+
+	JSTD_TARGET("avx512f")
+	inline void fill_blocks_avx512(
+		unsigned char *first, const _STD size_t bytes, const unsigned char *pattern, const bool stream) noexcept
+	{
+		const __m512i p = _mm512_loadu_si512(pattern);
+
+		for (_STD size_t i = 0; i != bytes; i += 64)
+		{
+			if (stream)
+			{
+				_mm512_stream_si512(reinterpret_cast<__m512i*>(first + i), p);
+			}
+			else
+			{
+				_mm512_store_si512(first + i, p);
+			}
+		}
+	}
+#endif // JSTD_SIMD_X86
+
+	NODISCARD inline fill_kernel select_fill_kernel() noexcept
+	{
+#if defined(JSTD_SIMD_X86)
+		const cpu_features &features = detect_cpu_features();
+
+		if (features.avx512f)
+		{
+			return &fill_blocks_avx512;
+		}
+
+		if (features.avx2)
+		{
+			return &fill_blocks_avx2;
+		}
+
+		return &fill_blocks_sse2;
+#else
+		return &fill_blocks_portable;
+#endif // JSTD_SIMD_X86
+	}
+
+	// Fills bytes at dest with a value of size bytes, where size divides 64 and bytes is a multiple of size.
+	inline void fill_pattern(unsigned char *dest, const _STD size_t bytes, const unsigned char *value,
+		const _STD size_t size, const bool stream) noexcept
+	{
+		static const fill_kernel kernel = select_fill_kernel();
+
+		unsigned char *const last    = dest + bytes;
+		const auto address           = reinterpret_cast<_STD uintptr_t>(dest);
+		unsigned char *const first   = dest + (64 - address % 64) % 64;
+		const _STD size_t body_bytes = static_cast<_STD size_t>(last - first) / 64 * 64;
+
+		// The pattern is phased to the aligned blocks. As size divides 64, it also fits the head before them.
+		alignas(64) unsigned char pattern[64];
+		const _STD size_t phase = static_cast<_STD size_t>(first - dest) % size;
+
+		for (_STD size_t i = 0; i != 64; ++i)
+		{
+			pattern[i] = value[(phase + i) % size];
+		}
+
+		const _STD size_t head_bytes = static_cast<_STD size_t>(first - dest);
+		_STD memcpy(dest, pattern + (64 - head_bytes), head_bytes);
+
+		kernel(first, body_bytes, pattern, stream);
+
+#if defined(JSTD_SIMD_X86)
+		if (stream)
+		{
+			// Streaming stores are weakly ordered, make them visible before the elements are used.
+			_mm_sfence();
+		}
+#endif // JSTD_SIMD_X86
+
+		_STD memcpy(first + body_bytes, pattern, static_cast<_STD size_t>(last - (first + body_bytes)));
+	}
+} // namespace simd_detail
+
+// Writes count copies of value at dest, for trivially copyable T. dest may be raw memory, and value may be one of
+// the elements overwritten. Uniform byte patterns go to memset, values whose size divides 64 to SIMD stores.
+// Other sizes are copied one element at a time.
+// With allow_streaming, fills past streaming_store_threshold() use streaming stores. Only pass it for memory
+// that is already resident: the kernel zeroes fresh pages through the cache when they are first touched,
+// so streaming over them evicts nothing less and is slower.
+template <class T>
+inline void simd_fill(T *dest, const _STD size_t count, const T &value, const bool allow_streaming = false) noexcept
+{
+	static_assert(_STD is_trivially_copyable_v<T>, "simd_fill requires a trivially copyable type.");
+
+	if (count == 0)
+	{
+		return;
+	}
+
+	unsigned char bytes[sizeof(T)];
+	_STD memcpy(bytes, _STD addressof(value), sizeof(T));
+
+	const _STD size_t total = count * sizeof(T);
+	auto *const first       = reinterpret_cast<unsigned char*>(dest);
+
+	bool uniform = true;
+	for (_STD size_t i = 1; i != sizeof(T); ++i)
+	{
+		uniform = uniform && bytes[i] == bytes[0];
+	}
+
+	const bool stream = allow_streaming && total >= streaming_store_threshold();
+
+	if (uniform && !stream)
+	{
+		_STD memset(first, bytes[0], total);
+	}
+	else if (64 % sizeof(T) == 0 && total >= 256)
+	{
+		simd_detail::fill_pattern(first, total, bytes, sizeof(T), stream);
+	}
+	else
+	{
+		for (_STD size_t i = 0; i != total; i += sizeof(T))
+		{
+			_STD memcpy(first + i, bytes, sizeof(T));
+		}
+	}
+}
+namespace simd_detail
+{
+	// Copy kernels copy bytes from src to dest with streaming stores, dest 64-byte aligned
+	// and bytes a multiple of 64. src may be unaligned.
+	using stream_copy_kernel = void (*)(unsigned char*, const unsigned char*, _STD size_t) noexcept;
+
+	inline void stream_copy_portable(unsigned char *dest, const unsigned char *src, const _STD size_t bytes) noexcept
+	{
+		_STD memcpy(dest, src, bytes);
+	}
+
+#if defined(JSTD_SIMD_X86)
+	inline void stream_copy_sse2(unsigned char *dest, const unsigned char *src, const _STD size_t bytes) noexcept
+	{
+		for (_STD size_t i = 0; i != bytes; i += 64)
+		{
+			const __m128i *from = reinterpret_cast<const __m128i*>(src + i);
+			__m128i *to         = reinterpret_cast<__m128i*>(dest + i);
+			const __m128i x0    = _mm_loadu_si128(from);
+			const __m128i x1    = _mm_loadu_si128(from + 1);
+			const __m128i x2    = _mm_loadu_si128(from + 2);
+			const __m128i x3    = _mm_loadu_si128(from + 3);
+
+			_mm_stream_si128(to, x0);
+			_mm_stream_si128(to + 1, x1);
+			_mm_stream_si128(to + 2, x2);
+			_mm_stream_si128(to + 3, x3);
+		}
+	}
+
+	JSTD_TARGET("avx2")
+	inline void stream_copy_avx2(unsigned char *dest, const unsigned char *src, const _STD size_t bytes) noexcept
+	{
+		for (_STD size_t i = 0; i != bytes; i += 64)
+		{
+			const __m256i *from = reinterpret_cast<const __m256i*>(src + i);
+			__m256i *to         = reinterpret_cast<__m256i*>(dest + i);
+			const __m256i x0    = _mm256_loadu_si256(from);
+			const __m256i x1    = _mm256_loadu_si256(from + 1);
+
+			_mm256_stream_si256(to, x0);
+			_mm256_stream_si256(to + 1, x1);
+		}
+	}
+
+	JSTD_TARGET("avx512f")
+	inline void stream_copy_avx512(unsigned char *dest, const unsigned char *src, const _STD size_t bytes) noexcept
+	{
+		for (_STD size_t i = 0; i != bytes; i += 64)
+		{
+			_mm512_stream_si512(reinterpret_cast<__m512i*>(dest + i), _mm512_loadu_si512(src + i));
+		}
+	}
+#endif // JSTD_SIMD_X86
+
+	NODISCARD inline stream_copy_kernel select_stream_copy_kernel() noexcept
+	{
+#if defined(JSTD_SIMD_X86)
+		const cpu_features &features = detect_cpu_features();
+
+		if (features.avx512f)
+		{
+			return &stream_copy_avx512;
+		}
+
+		if (features.avx2)
+		{
+			return &stream_copy_avx2;
+		}
+
+		return &stream_copy_sse2;
+#else
+		return &stream_copy_portable;
+#endif // JSTD_SIMD_X86
+	}
+
+	inline void copy_bytes(unsigned char *dest, const unsigned char *src, const _STD size_t bytes, const bool stream) noexcept
+	{
+		static const stream_copy_kernel kernel = select_stream_copy_kernel();
+
+		if (!stream || bytes < 128)
+		{
+			_STD memcpy(dest, src, bytes);
+			return;
+		}
+
+		const auto address           = reinterpret_cast<_STD uintptr_t>(dest);
+		const _STD size_t head_bytes = (64 - address % 64) % 64;
+		const _STD size_t body_bytes = (bytes - head_bytes) / 64 * 64;
+
+		_STD memcpy(dest, src, head_bytes);
+		kernel(dest + head_bytes, src + head_bytes, body_bytes);
+
+#if defined(JSTD_SIMD_X86)
+		_mm_sfence();
+#endif // JSTD_SIMD_X86
+
+		_STD memcpy(dest + head_bytes + body_bytes, src + head_bytes + body_bytes, bytes - head_bytes - body_bytes);
+	}
+
+	inline _STD atomic<unsigned> copy_threads{ 1 };
+} // namespace simd_detail
+
+// Number of threads large_copy() may use, 1 by default. 0 selects one per hardware thread.
+inline void set_copy_threads(const unsigned threads) noexcept
+{
+	simd_detail::copy_threads.store(threads != 0 ? threads : (_STD max)(_STD thread::hardware_concurrency(), 1u),
+		_STD memory_order_relaxed);
+}
+
+NODISCARD inline unsigned copy_threads() noexcept
+{
+	return simd_detail::copy_threads.load(_STD memory_order_relaxed);
+}
+
+// memcpy for large buffers that do not overlap. Copies of at least JSTD_PARALLEL_COPY_THRESHOLD bytes are split
+// across copy_threads() threads. With allow_streaming, copies past streaming_store_threshold() use streaming
+// stores. As with simd_fill(), only pass it when dest is already resident.
+inline void large_copy(void *dest, const void *src, const _STD size_t bytes, const bool allow_streaming = false) noexcept
+{
+	auto *const to          = static_cast<unsigned char*>(dest);
+	const auto *const from  = static_cast<const unsigned char*>(src);
+	const bool stream       = allow_streaming && bytes >= streaming_store_threshold();
+	const unsigned threads  = bytes >= JSTD_PARALLEL_COPY_THRESHOLD ? copy_threads() : 1;
+
+	if (threads <= 1)
+	{
+		simd_detail::copy_bytes(to, from, bytes, stream);
+		return;
+	}
+
+	// Chunks start on cache lines, the calling thread copies the last one.
+	const _STD size_t chunk = (bytes / threads + 63) / 64 * 64;
+	_STD size_t offset      = 0;
+	_STD vector<_STD thread> workers;
+
+	try
+	{
+		workers.reserve(threads - 1);
+
+		for (; workers.size() + 1 < threads && offset + chunk < bytes; offset += chunk)
+		{
+			workers.emplace_back(simd_detail::copy_bytes, to + offset, from + offset, chunk, stream);
+		}
+	}
+	catch (...)
+	{
+		// Without more threads the rest is copied here.
+	}
+
+	simd_detail::copy_bytes(to + offset, from + offset, bytes - offset, stream);
+
+	for (auto &worker : workers)
+	{
+		worker.join();
+	}
+}
+
+// Index of the lowest set bit of a non-zero word. GCC and Clang emit rep bsf, which runs as TZCNT where BMI1 is.
+NODISCARD inline unsigned trailing_zeros(const _STD uint64_t word) noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+	unsigned long index;
+	_BitScanForward64(&index, word);
+	return static_cast<unsigned>(index);
+#else
+	return static_cast<unsigned>(__builtin_ctzll(word));
+#endif // _MSC_VER
+}
+
+namespace simd_detail
+{
+	using popcount_kernel = _STD size_t (*)(const _STD uint64_t*, _STD size_t) noexcept;
+
+	NODISCARD inline _STD size_t popcount_portable(const _STD uint64_t *words, const _STD size_t count) noexcept
+	{
+		_STD size_t total = 0;
+
+		for (_STD size_t i = 0; i != count; ++i)
+		{
+			_STD uint64_t word = words[i];
+			word  = word - ((word >> 1) & 0x5555555555555555u);
+			word  = (word & 0x3333333333333333u) + ((word >> 2) & 0x3333333333333333u);
+			word  = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Fu;
+			total += static_cast<_STD size_t>((word * 0x0101010101010101u) >> 56);
+		}
+
+		return total;
+	}
+
+#if defined(JSTD_SIMD_X86)
+	// Four counters, so the POPCNT instructions do not wait on one another.
+	JSTD_TARGET("popcnt")
+	NODISCARD inline _STD size_t popcount_popcnt(const _STD uint64_t *words, const _STD size_t count) noexcept
+	{
+		_STD uint64_t totals[4] = {};
+		_STD size_t i = 0;
+
+		for (; i + 4 <= count; i += 4)
+		{
+			totals[0] += static_cast<_STD uint64_t>(_mm_popcnt_u64(words[i]));
+			totals[1] += static_cast<_STD uint64_t>(_mm_popcnt_u64(words[i + 1]));
+			totals[2] += static_cast<_STD uint64_t>(_mm_popcnt_u64(words[i + 2]));
+			totals[3] += static_cast<_STD uint64_t>(_mm_popcnt_u64(words[i + 3]));
+		}
+
+		for (; i != count; ++i)
+		{
+			totals[0] += static_cast<_STD uint64_t>(_mm_popcnt_u64(words[i]));
+		}
+
+		return static_cast<_STD size_t>(totals[0] + totals[1] + totals[2] + totals[3]);
+	}
+#endif // JSTD_SIMD_X86
+
+	NODISCARD inline popcount_kernel select_popcount_kernel() noexcept
+	{
+#if defined(JSTD_SIMD_X86)
+		if (detect_cpu_features().popcnt)
+		{
+			return &popcount_popcnt;
+		}
+#endif // JSTD_SIMD_X86
+
+		return &popcount_portable;
+	}
+} // namespace simd_detail
+
+// Number of set bits in count words, with POPCNT where the CPU has it.
+NODISCARD inline _STD size_t popcount_words(const _STD uint64_t *words, const _STD size_t count) noexcept
+{
+	static const simd_detail::popcount_kernel kernel = simd_detail::select_popcount_kernel();
+	return kernel(words, count);
+}
+
+// Blocks of 128 32-bit values packed bits wide, bits <= 32, into 4 * bits words. Value j goes to lane j % 4,
+// at bit (j / 4) * bits of that lane, and word w of a lane is word 4 * w + lane of the block. The four lanes
+// unpack side by side in one SSE2 register.
+inline constexpr _STD size_t packed_block_size = 128;
+
+namespace simd_detail
+{
+	NODISCARD constexpr _STD uint32_t low_mask32(const unsigned bits) noexcept
+	{
+		return bits >= 32 ? ~_STD uint32_t(0) : (_STD uint32_t(1) << bits) - 1;
+	}
+
+	inline void unpack_block_portable(const _STD uint32_t *in, const unsigned bits, _STD uint32_t *out) noexcept
+	{
+		const _STD uint32_t mask = low_mask32(bits);
+
+		for (_STD size_t j = 0; j != packed_block_size; ++j)
+		{
+			const _STD size_t lane   = j % 4;
+			const _STD size_t pos    = (j / 4) * bits;
+			const _STD size_t word   = pos / 32;
+			const unsigned    offset = static_cast<unsigned>(pos % 32);
+
+			_STD uint32_t value = in[4 * word + lane] >> offset;
+
+			if (offset + bits > 32)
+			{
+				value |= in[4 * (word + 1) + lane] << (32 - offset);
+			}
+
+			out[j] = value & mask;
+		}
+	}
+
+	inline void prefix_sum_block_portable(_STD uint32_t *values, _STD uint32_t previous) noexcept
+	{
+		for (_STD size_t j = 0; j != packed_block_size; ++j)
+		{
+			previous += values[j];
+			values[j] = previous;
+		}
+	}
+
+#if defined(JSTD_SIMD_X86)
+	inline void unpack_block_sse2(const _STD uint32_t *in, const unsigned bits, _STD uint32_t *out) noexcept
+	{
+		const __m128i *words = reinterpret_cast<const __m128i*>(in);
+		const __m128i mask   = _mm_set1_epi32(static_cast<int>(low_mask32(bits)));
+
+		__m128i word   = _mm_loadu_si128(words++);
+		unsigned shift = 0;
+
+		for (_STD size_t row = 0; row != packed_block_size / 4; ++row)
+		{
+			__m128i value = _mm_srl_epi32(word, _mm_cvtsi32_si128(static_cast<int>(shift)));
+			shift += bits;
+
+			if (shift >= 32)
+			{
+				// The last row ends on a word boundary, so there is no word past the block to load.
+				shift -= 32;
+
+				if (row + 1 != packed_block_size / 4)
+				{
+					word = _mm_loadu_si128(words++);
+				}
+
+				if (shift != 0)
+				{
+					value = _mm_or_si128(value, _mm_sll_epi32(word, _mm_cvtsi32_si128(static_cast<int>(bits - shift))));
+				}
+			}
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out) + row, _mm_and_si128(value, mask));
+		}
+	}
+
+	inline void prefix_sum_block_sse2(_STD uint32_t *values, const _STD uint32_t previous) noexcept
+	{
+		__m128i *rows = reinterpret_cast<__m128i*>(values);
+		__m128i carry = _mm_set1_epi32(static_cast<int>(previous));
+
+		for (_STD size_t row = 0; row != packed_block_size / 4; ++row)
+		{
+			__m128i sum = _mm_loadu_si128(rows + row);
+			sum         = _mm_add_epi32(sum, _mm_slli_si128(sum, 4));
+			sum         = _mm_add_epi32(sum, _mm_slli_si128(sum, 8));
+			sum         = _mm_add_epi32(sum, carry);
+			_mm_storeu_si128(rows + row, sum);
+			carry       = _mm_shuffle_epi32(sum, 0xFF);
+		}
+	}
+#endif // JSTD_SIMD_X86
+} // namespace simd_detail
+
+// Packs packed_block_size values, each below 2^bits, into 4 * bits words at out.
+inline void pack_block(const _STD uint32_t *in, const unsigned bits, _STD uint32_t *out) noexcept
+{
+	// Nothing to write, out may be null.
+	if (bits == 0)
+	{
+		return;
+	}
+
+	_STD memset(out, 0, 4 * bits * sizeof(_STD uint32_t));
+
+	for (_STD size_t j = 0; j != packed_block_size; ++j)
+	{
+		const _STD size_t lane   = j % 4;
+		const _STD size_t pos    = (j / 4) * bits;
+		const _STD size_t word   = pos / 32;
+		const unsigned    offset = static_cast<unsigned>(pos % 32);
+
+		out[4 * word + lane] |= in[j] << offset;
+
+		if (offset + bits > 32)
+		{
+			out[4 * (word + 1) + lane] |= in[j] >> (32 - offset);
+		}
+	}
+}
+
+// Unpacks the packed_block_size values pack_block() wrote.
+inline void unpack_block(const _STD uint32_t *in, const unsigned bits, _STD uint32_t *out) noexcept
+{
+	if (bits == 0)
+	{
+		_STD memset(out, 0, packed_block_size * sizeof(_STD uint32_t));
+		return;
+	}
+
+#if defined(JSTD_SIMD_X86)
+	simd_detail::unpack_block_sse2(in, bits, out);
+#else
+	simd_detail::unpack_block_portable(in, bits, out);
+#endif // JSTD_SIMD_X86
+}
+
+// Turns packed_block_size deltas into running sums starting from previous, wrapping like unsigned addition.
+inline void prefix_sum_block(_STD uint32_t *values, const _STD uint32_t previous) noexcept
+{
+#if defined(JSTD_SIMD_X86)
+	simd_detail::prefix_sum_block_sse2(values, previous);
+#else
+	simd_detail::prefix_sum_block_portable(values, previous);
+#endif // JSTD_SIMD_X86
+}
+_JSTD_END
+
+#endif // !_JSTD_SIMD_
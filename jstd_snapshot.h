@@ -0,0 +1,562 @@
+#pragma once
+#ifndef _JSTD_SNAPSHOT_
+#define _JSTD_SNAPSHOT_
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include "jstd_core.h"
+#include "JVector.h"
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // !_WIN32
+
+// Snapshot files: a 64 byte header followed by the raw elements, which therefore start 64 byte aligned.
+// The header records what the elements were written as, so a mismatching reader is refused instead of reading garbage.
+_JSTD_BEGIN
+inline constexpr char          snapshot_magic[8]   = { 'J', 'V', 'E', 'C', 'S', 'N', 'A', 'P' };
+inline constexpr _STD uint32_t snapshot_version    = 1;
+inline constexpr _STD uint64_t snapshot_byte_order = 0x0102030405060708ull;
+
+struct snapshot_header
+{
+	char          magic[8];
+	_STD uint32_t version;
+	_STD uint32_t element_size;
+	_STD uint32_t element_alignment;
+	_STD uint32_t data_offset;
+	_STD uint64_t byte_order; // snapshot_byte_order as the writer stored it
+	_STD uint64_t count;
+	_STD uint64_t checksum;   // XXH64 of the element bytes
+	unsigned char reserved[16];
+};
+
+static_assert(sizeof(snapshot_header) == 64, "snapshot_header must be 64 bytes.");
+
+// XXH64 computed incrementally, so a writer can checksum data it never holds at once.
+class snapshot_checksum
+{
+public:
+	snapshot_checksum() noexcept
+		: m_lanes{ prime1 + prime2, prime2, 0, 0 - prime1 },
+		  m_buffer{},
+		  m_buffered(0),
+		  m_total(0)
+		{}
+
+	void update(const void *data, _STD size_t bytes) noexcept
+	{
+		const unsigned char *input = static_cast<const unsigned char*>(data);
+		m_total                   += bytes;
+
+		if (m_buffered != 0)
+		{
+			const _STD size_t take = (_STD min)(bytes, sizeof(m_buffer) - m_buffered);
+			_STD memcpy(m_buffer + m_buffered, input, take);
+			m_buffered += take;
+			input      += take;
+			bytes      -= take;
+
+			if (m_buffered < sizeof(m_buffer))
+			{
+				return;
+			}
+
+			stripe(m_buffer);
+			m_buffered = 0;
+		}
+
+		for (; bytes >= 32; input += 32, bytes -= 32)
+		{
+			stripe(input);
+		}
+
+		_STD memcpy(m_buffer, input, bytes);
+		m_buffered = bytes;
+	}
+
+	NODISCARD _STD uint64_t finish() const noexcept
+	{
+		_STD uint64_t hash;
+
+		if (m_total >= 32)
+		{
+			hash = rotl(m_lanes[0], 1) + rotl(m_lanes[1], 7) + rotl(m_lanes[2], 12) + rotl(m_lanes[3], 18);
+
+			for (const _STD uint64_t lane : m_lanes)
+			{
+				hash ^= round(0, lane);
+				hash  = hash * prime1 + prime4;
+			}
+		}
+		else
+		{
+			hash = prime5;
+		}
+
+		hash += m_total;
+
+		const unsigned char *tail = m_buffer;
+		_STD size_t left          = m_buffered;
+
+		for (; left >= 8; tail += 8, left -= 8)
+		{
+			hash ^= round(0, read64(tail));
+			hash  = rotl(hash, 27) * prime1 + prime4;
+		}
+
+		if (left >= 4)
+		{
+			_STD uint32_t word;
+			_STD memcpy(&word, tail, 4);
+			hash ^= word * prime1;
+			hash  = rotl(hash, 23) * prime2 + prime3;
+			tail += 4;
+			left -= 4;
+		}
+
+		for (; left != 0; ++tail, --left)
+		{
+			hash ^= *tail * prime5;
+			hash  = rotl(hash, 11) * prime1;
+		}
+
+		hash ^= hash >> 33;
+		hash *= prime2;
+		hash ^= hash >> 29;
+		hash *= prime3;
+		hash ^= hash >> 32;
+		return hash;
+	}
+
+private:
+	static constexpr _STD uint64_t prime1 = 0x9E3779B185EBCA87ull;
+	static constexpr _STD uint64_t prime2 = 0xC2B2AE3D27D4EB4Full;
+	static constexpr _STD uint64_t prime3 = 0x165667B19E3779F9ull;
+	static constexpr _STD uint64_t prime4 = 0x85EBCA77C2B2AE63ull;
+	static constexpr _STD uint64_t prime5 = 0x27D4EB2F165667C5ull;
+
+	NODISCARD static _STD uint64_t rotl(const _STD uint64_t value, const int bits) noexcept
+	{
+		return (value << bits) | (value >> (64 - bits));
+	}
+
+	NODISCARD static _STD uint64_t read64(const unsigned char *ptr) noexcept
+	{
+		_STD uint64_t value;
+		_STD memcpy(&value, ptr, 8);
+		return value;
+	}
+
+	NODISCARD static _STD uint64_t round(_STD uint64_t acc, const _STD uint64_t input) noexcept
+	{
+		acc += input * prime2;
+		return rotl(acc, 31) * prime1;
+	}
+
+	void stripe(const unsigned char *input) noexcept
+	{
+		m_lanes[0] = round(m_lanes[0], read64(input));
+		m_lanes[1] = round(m_lanes[1], read64(input + 8));
+		m_lanes[2] = round(m_lanes[2], read64(input + 16));
+		m_lanes[3] = round(m_lanes[3], read64(input + 24));
+	}
+
+	_STD uint64_t m_lanes[4];
+	unsigned char m_buffer[32];
+	_STD size_t   m_buffered;
+	_STD uint64_t m_total;
+};
+
+// Writes a snapshot in chunks, so it may hold more elements than fit in memory.
+// The header is written last by close(); a file whose writer never closed it is refused when loaded.
+template <class T>
+class snapshot_writer
+{
+public:
+	static_assert(_STD is_trivially_copyable_v<T>, "Snapshots require trivially copyable elements.");
+	static_assert(alignof(T) <= 64, "Snapshot elements are aligned to 64 bytes at most.");
+
+	explicit snapshot_writer(const char *path)
+		: m_file(_STD fopen(path, "wb")),
+		  m_count(0)
+	{
+		if (m_file == nullptr)
+		{
+			throw _STD system_error(errno, _STD generic_category(), "snapshot_writer: fopen");
+		}
+
+		// Zeros until close(), the missing magic marks the file unfinished.
+		const snapshot_header blank{};
+		write(&blank, sizeof(blank));
+	}
+
+	snapshot_writer(const snapshot_writer&) = delete;
+	snapshot_writer& operator=(const snapshot_writer&) = delete;
+
+	~snapshot_writer()
+	{
+		if (m_file != nullptr)
+		{
+			_STD fclose(m_file);
+		}
+	}
+
+	void append(const T *data, const _STD size_t count)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		write(data, count * sizeof(T));
+		m_checksum.update(data, count * sizeof(T));
+		m_count += count;
+	}
+
+	void append(const T &value)
+	{
+		append(&value, 1);
+	}
+
+	template <class Alloc, class Growth>
+	void append(const JVector<T, Alloc, Growth> &vec)
+	{
+		append(vec.data(), vec.size());
+	}
+
+	NODISCARD _STD uint64_t count() const noexcept
+	{
+		return m_count;
+	}
+
+	// Writes the header and closes the file.
+	void close()
+	{
+		snapshot_header header{};
+		_STD memcpy(header.magic, snapshot_magic, sizeof(header.magic));
+		header.version           = snapshot_version;
+		header.element_size      = static_cast<_STD uint32_t>(sizeof(T));
+		header.element_alignment = static_cast<_STD uint32_t>(alignof(T));
+		header.data_offset       = static_cast<_STD uint32_t>(sizeof(snapshot_header));
+		header.byte_order        = snapshot_byte_order;
+		header.count             = m_count;
+		header.checksum          = m_checksum.finish();
+
+		if (_STD fflush(m_file) != 0 || _STD fseek(m_file, 0, SEEK_SET) != 0)
+		{
+			throw _STD system_error(errno, _STD generic_category(), "snapshot_writer: fseek");
+		}
+
+		write(&header, sizeof(header));
+
+		_STD FILE *file = m_file;
+		m_file          = nullptr;
+
+		if (_STD fclose(file) != 0)
+		{
+			throw _STD system_error(errno, _STD generic_category(), "snapshot_writer: fclose");
+		}
+	}
+
+private:
+	void write(const void *data, const _STD size_t bytes)
+	{
+		if (m_file == nullptr)
+		{
+			throw _STD logic_error("snapshot_writer is closed.");
+		}
+
+		if (_STD fwrite(data, 1, bytes, m_file) != bytes)
+		{
+			throw _STD system_error(errno, _STD generic_category(), "snapshot_writer: fwrite");
+		}
+	}
+
+	_STD FILE         *m_file;
+	_STD uint64_t     m_count;
+	snapshot_checksum m_checksum;
+};
+
+// Writes vec to path as a snapshot.
+template <class T, class Alloc, class Growth>
+void save(const JVector<T, Alloc, Growth> &vec, const char *path)
+{
+	snapshot_writer<T> writer(path);
+	writer.append(vec);
+	writer.close();
+}
+
+template <class T, class Alloc, class Growth>
+void save(const JVector<T, Alloc, Growth> &vec, const _STD string &path)
+{
+	save(vec, path.c_str());
+}
+
+// Checks that header describes elements of type T written on a machine like this one, throws otherwise.
+template <class T>
+void check_snapshot_header(const snapshot_header &header, const _STD uint64_t file_bytes)
+{
+	if (_STD memcmp(header.magic, snapshot_magic, sizeof(header.magic)) != 0)
+	{
+		throw _STD runtime_error("Not a snapshot, or one that was not finished.");
+	}
+
+	if (header.version != snapshot_version)
+	{
+		throw _STD runtime_error("Unsupported snapshot version.");
+	}
+
+	if (header.byte_order != snapshot_byte_order)
+	{
+		throw _STD runtime_error("Snapshot was written with a different byte order.");
+	}
+
+	if (header.element_size != sizeof(T) || header.element_alignment != alignof(T))
+	{
+		throw _STD runtime_error("Snapshot holds elements of a different size or alignment.");
+	}
+
+	if (header.data_offset < sizeof(snapshot_header) || header.data_offset % 64 != 0 || header.data_offset > file_bytes
+		|| header.count > (file_bytes - header.data_offset) / sizeof(T))
+	{
+		throw _STD runtime_error("Snapshot is truncated.");
+	}
+}
+
+#if !defined(_WIN32)
+enum class snapshot_check
+{
+	header,  // the header only, nothing of the data is read
+	checksum // also every element against the checksum
+};
+
+// Read-only view of the elements of a snapshot, mapped from the file in place.
+template <class T>
+class snapshot_view
+{
+public:
+	static_assert(_STD is_trivially_copyable_v<T>, "Snapshots require trivially copyable elements.");
+
+	using value_type             = T;
+	using pointer                = const T*;
+	using const_pointer          = const T*;
+	using reference              = const T&;
+	using const_reference        = const T&;
+	using size_type              = _STD size_t;
+	using difference_type        = _STD ptrdiff_t;
+	using iterator               = JVector_Const_Iterator<snapshot_view<T>>;
+	using const_iterator         = iterator;
+	using reverse_iterator       = _STD reverse_iterator<iterator>;
+	using const_reverse_iterator = reverse_iterator;
+
+	snapshot_view() noexcept
+		: m_mapping(nullptr),
+		  m_length(0),
+		  m_data(nullptr),
+		  m_size(0),
+		  m_header{}
+		{}
+
+	snapshot_view(snapshot_view &&other) noexcept
+		: snapshot_view()
+	{
+		swap(other);
+	}
+
+	snapshot_view& operator=(snapshot_view &&other) noexcept
+	{
+		snapshot_view temp(_STD move(other));
+		swap(temp);
+		return *this;
+	}
+
+	snapshot_view(const snapshot_view&) = delete;
+	snapshot_view& operator=(const snapshot_view&) = delete;
+
+	~snapshot_view()
+	{
+		if (m_mapping != nullptr)
+		{
+			::munmap(m_mapping, m_length);
+		}
+	}
+
+	NODISCARD const snapshot_header& header() const noexcept
+	{
+		return m_header;
+	}
+
+	// True if the elements match the checksum of the header. Reads all of them.
+	NODISCARD bool verify() const noexcept
+	{
+		snapshot_checksum checksum;
+		checksum.update(m_data, m_size * sizeof(T));
+		return checksum.finish() == m_header.checksum;
+	}
+
+	NODISCARD const_reference at(const size_type pos) const
+	{
+		if (pos >= m_size)
+		{
+			throw _STD out_of_range("Index out of range.");
+		}
+
+		return m_data[pos];
+	}
+
+	NODISCARD const_reference operator[](const size_type pos) const noexcept
+	{
+		return m_data[pos];
+	}
+
+	NODISCARD const_reference front() const noexcept
+	{
+		return m_data[0];
+	}
+
+	NODISCARD const_reference back() const noexcept
+	{
+		return m_data[m_size - 1];
+	}
+
+	NODISCARD const_pointer data() const noexcept
+	{
+		return m_data;
+	}
+
+	NODISCARD const_iterator begin() const noexcept
+	{
+		return const_iterator(m_data);
+	}
+
+	NODISCARD const_iterator end() const noexcept
+	{
+		return const_iterator(m_data + m_size);
+	}
+
+	NODISCARD const_iterator cbegin() const noexcept
+	{
+		return begin();
+	}
+
+	NODISCARD const_iterator cend() const noexcept
+	{
+		return end();
+	}
+
+	NODISCARD const_reverse_iterator rbegin() const noexcept
+	{
+		return const_reverse_iterator(end());
+	}
+
+	NODISCARD const_reverse_iterator rend() const noexcept
+	{
+		return const_reverse_iterator(begin());
+	}
+
+	NODISCARD bool empty() const noexcept
+	{
+		return m_size == 0;
+	}
+
+	NODISCARD size_type size() const noexcept
+	{
+		return m_size;
+	}
+
+	void swap(snapshot_view &other) noexcept
+	{
+		_STD swap(m_mapping, other.m_mapping);
+		_STD swap(m_length, other.m_length);
+		_STD swap(m_data, other.m_data);
+		_STD swap(m_size, other.m_size);
+		_STD swap(m_header, other.m_header);
+	}
+
+private:
+	template <class U>
+	friend snapshot_view<U> load_view(const char *path, snapshot_check check);
+
+	void      *m_mapping;
+	size_type m_length;
+	const T   *m_data;
+	size_type m_size;
+	snapshot_header m_header;
+};
+
+// Maps the snapshot at path read-only. The elements are used where the page cache holds them, nothing is copied.
+template <class T>
+snapshot_view<T> load_view(const char *path, snapshot_check check = snapshot_check::header)
+{
+	const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+
+	if (fd < 0)
+	{
+		throw _STD system_error(errno, _STD generic_category(), "load_view: open");
+	}
+
+	struct stat info;
+
+	if (::fstat(fd, &info) != 0)
+	{
+		const int error = errno;
+		::close(fd);
+		throw _STD system_error(error, _STD generic_category(), "load_view: fstat");
+	}
+
+	const _STD size_t length = static_cast<_STD size_t>(info.st_size);
+
+	if (length < sizeof(snapshot_header))
+	{
+		::close(fd);
+		throw _STD runtime_error("Not a snapshot, or one that was not finished.");
+	}
+
+	void *mapping = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+	const int error = errno;
+	::close(fd);
+
+	if (mapping == MAP_FAILED)
+	{
+		throw _STD system_error(error, _STD generic_category(), "load_view: mmap");
+	}
+
+	snapshot_view<T> view;
+	view.m_mapping = mapping;
+	view.m_length  = length;
+	_STD memcpy(&view.m_header, mapping, sizeof(snapshot_header));
+
+	check_snapshot_header<T>(view.m_header, length);
+
+	view.m_data = reinterpret_cast<const T*>(static_cast<const unsigned char*>(mapping) + view.m_header.data_offset);
+	view.m_size = static_cast<_STD size_t>(view.m_header.count);
+
+	if (check == snapshot_check::checksum && !view.verify())
+	{
+		throw _STD runtime_error("Snapshot does not match its checksum.");
+	}
+
+	return view;
+}
+
+template <class T>
+snapshot_view<T> load_view(const _STD string &path, snapshot_check check = snapshot_check::header)
+{
+	return load_view<T>(path.c_str(), check);
+}
+#endif // !_WIN32
+_JSTD_END
+
+#endif // !_JSTD_SNAPSHOT_
@@ -0,0 +1,367 @@
+#pragma once
+#ifndef _JSTD_STATS_
+#define _JSTD_STATS_
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+#include "jstd_core.h"
+
+// Define JVECTOR_STATS to count, for every JVector instantiation, what its vectors allocate, move and waste.
+// Without it the hooks are empty and JVector compiles to what it was.
+//
+// Counters are also kept per call site: JVECTOR_STATS_SITE() at the start of a block attributes everything
+// JVectors do on this thread until the block ends to that line, as well as to their instantiations.
+//
+//	void load(JVector<record> &records)
+//	{
+//		JVECTOR_STATS_SITE();
+//		...
+//	}
+//
+// JSTD::dump_vector_stats(std::cout) lists them all, as text or as JSON.
+#if defined(JVECTOR_STATS)
+#include <atomic>
+#include <cstdlib>
+#include <typeinfo>
+
+#if defined(__GNUC__) || defined(__clang__)
+#include <cxxabi.h>
+#endif // __GNUC__ || __clang__
+#endif // JVECTOR_STATS
+
+_JSTD_BEGIN
+enum class vector_counter : unsigned
+{
+	allocations,        // Buffers obtained, reallocations included.
+	reallocations,      // Buffers replaced while holding elements, by growth, reserve or shrink_to_fit.
+	relocated_bytes,    // Bytes of elements carried into a new buffer.
+	moved_bytes,        // Bytes of elements shifted inside a buffer by insert and erase, move_range and rmove.
+	value_initialized,  // Elements value-initialized, by resize(count) or emplace_back().
+	wasted_bytes,       // Unused capacity of vectors when they were destroyed.
+	shrink_saved_bytes, // Capacity given back by shrink_to_fit.
+	destroyed,          // Vectors destroyed.
+	peak_capacity_bytes // The largest capacity of a single vector.
+};
+
+inline constexpr unsigned vector_counter_count = static_cast<unsigned>(vector_counter::peak_capacity_bytes) + 1;
+
+enum class stats_format
+{
+	text,
+	json
+};
+
+#if defined(JVECTOR_STATS)
+inline constexpr bool vector_stats_enabled = true;
+
+// Counters of one instantiation or call site. They register themselves on construction and live for the program.
+class vector_stats
+{
+public:
+	// For an instantiation, name is its mangled type name and line 0.
+	vector_stats(const char *name, const char *function, const unsigned line) noexcept;
+
+	vector_stats(const vector_stats&) = delete;
+	vector_stats& operator=(const vector_stats&) = delete;
+
+	void add(const vector_counter counter, const _STD uint64_t amount) noexcept
+	{
+		m_counters[static_cast<unsigned>(counter)].fetch_add(amount, _STD memory_order_relaxed);
+	}
+
+	void raise(const vector_counter counter, const _STD uint64_t amount) noexcept
+	{
+		_STD atomic<_STD uint64_t> &value = m_counters[static_cast<unsigned>(counter)];
+		_STD uint64_t current             = value.load(_STD memory_order_relaxed);
+
+		while (current < amount && !value.compare_exchange_weak(current, amount, _STD memory_order_relaxed))
+		{
+		}
+	}
+
+	NODISCARD _STD uint64_t get(const vector_counter counter) const noexcept
+	{
+		return m_counters[static_cast<unsigned>(counter)].load(_STD memory_order_relaxed);
+	}
+
+	void reset() noexcept
+	{
+		for (_STD atomic<_STD uint64_t> &value : m_counters)
+		{
+			value.store(0, _STD memory_order_relaxed);
+		}
+	}
+
+	NODISCARD const char* name() const noexcept
+	{
+		return m_name;
+	}
+
+	NODISCARD const char* function() const noexcept
+	{
+		return m_function;
+	}
+
+	NODISCARD unsigned line() const noexcept
+	{
+		return m_line;
+	}
+
+	NODISCARD vector_stats* next() const noexcept
+	{
+		return m_next;
+	}
+
+private:
+	const char                *m_name;
+	const char                *m_function;
+	unsigned                   m_line;
+	_STD atomic<_STD uint64_t> m_counters[vector_counter_count];
+	vector_stats              *m_next;
+};
+
+namespace stats_detail
+{
+	// Registered counters, newest first. Entries are only ever added.
+	inline _STD atomic<vector_stats*> registry{ nullptr };
+
+	inline thread_local vector_stats *current_site = nullptr;
+
+	inline const char *const counter_names[vector_counter_count] = {
+		"allocations",
+		"reallocations",
+		"relocated_bytes",
+		"moved_bytes",
+		"value_initialized",
+		"wasted_bytes",
+		"shrink_saved_bytes",
+		"destroyed",
+		"peak_capacity_bytes"
+	};
+
+	// The demangled name where the ABI provides one.
+	inline void write_type_name(_STD ostream &out, const char *name)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		int status      = 0;
+		char *demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+
+		if (status == 0 && demangled != nullptr)
+		{
+			out << demangled;
+			_STD free(demangled);
+			return;
+		}
+#endif // __GNUC__ || __clang__
+
+		out << name;
+	}
+
+	inline void write_json_string(_STD ostream &out, const char *text)
+	{
+		out << '"';
+
+		for (; *text != '\0'; ++text)
+		{
+			const unsigned char c = static_cast<unsigned char>(*text);
+
+			if (c == '"' || c == '\\')
+			{
+				out << '\\' << *text;
+			}
+			else if (c < 0x20)
+			{
+				static const char digits[] = "0123456789abcdef";
+				out << "\\u00" << digits[c >> 4] << digits[c & 15];
+			}
+			else
+			{
+				out << *text;
+			}
+		}
+
+		out << '"';
+	}
+} // namespace stats_detail
+
+inline
+vector_stats::vector_stats(const char *name, const char *function, const unsigned line) noexcept
+	: m_name(name),
+	  m_function(function),
+	  m_line(line),
+	  m_counters{},
+	  m_next(stats_detail::registry.load(_STD memory_order_relaxed))
+{
+	while (!stats_detail::registry.compare_exchange_weak(m_next, this, _STD memory_order_release, _STD memory_order_relaxed))
+	{
+	}
+}
+
+// Makes a call site current on this thread for its lifetime. Use it through JVECTOR_STATS_SITE().
+class vector_stats_scope
+{
+public:
+	explicit vector_stats_scope(vector_stats &site) noexcept
+		: m_previous(stats_detail::current_site)
+	{
+		stats_detail::current_site = &site;
+	}
+
+	vector_stats_scope(const vector_stats_scope&) = delete;
+	vector_stats_scope& operator=(const vector_stats_scope&) = delete;
+
+	~vector_stats_scope()
+	{
+		stats_detail::current_site = m_previous;
+	}
+
+private:
+	vector_stats *m_previous;
+};
+
+template <class Vector>
+NODISCARD vector_stats& instantiation_stats() noexcept
+{
+	static vector_stats stats(typeid(Vector).name(), nullptr, 0);
+	return stats;
+}
+
+// Hooks called by JVector.
+template <class Vector>
+inline void stats_add(const vector_counter counter, const _STD uint64_t amount) noexcept
+{
+	instantiation_stats<Vector>().add(counter, amount);
+
+	if (vector_stats *site = stats_detail::current_site)
+	{
+		site->add(counter, amount);
+	}
+}
+
+template <class Vector>
+inline void stats_raise(const vector_counter counter, const _STD uint64_t amount) noexcept
+{
+	instantiation_stats<Vector>().raise(counter, amount);
+
+	if (vector_stats *site = stats_detail::current_site)
+	{
+		site->raise(counter, amount);
+	}
+}
+
+// Writes every instantiation and call site that recorded something.
+inline void dump_vector_stats(_STD ostream &out, const stats_format format = stats_format::text)
+{
+	const bool json = format == stats_format::json;
+	bool first      = true;
+
+	out << (json ? "[" : "");
+
+	for (const vector_stats *stats = stats_detail::registry.load(_STD memory_order_acquire); stats != nullptr;
+		stats = stats->next())
+	{
+		bool used = false;
+
+		for (unsigned i = 0; i != vector_counter_count; ++i)
+		{
+			used = used || stats->get(static_cast<vector_counter>(i)) != 0;
+		}
+
+		if (!used)
+		{
+			continue;
+		}
+
+		if (json)
+		{
+			out << (first ? "\n" : ",\n") << "  {";
+
+			if (stats->line() == 0)
+			{
+				out << "\"type\": \"";
+				stats_detail::write_type_name(out, stats->name());
+				out << '"';
+			}
+			else
+			{
+				out << "\"file\": ";
+				stats_detail::write_json_string(out, stats->name());
+				out << ", \"function\": ";
+				stats_detail::write_json_string(out, stats->function());
+				out << ", \"line\": " << stats->line();
+			}
+
+			for (unsigned i = 0; i != vector_counter_count; ++i)
+			{
+				out << ", \"" << stats_detail::counter_names[i] << "\": " << stats->get(static_cast<vector_counter>(i));
+			}
+
+			out << '}';
+		}
+		else
+		{
+			if (stats->line() == 0)
+			{
+				stats_detail::write_type_name(out, stats->name());
+			}
+			else
+			{
+				out << stats->name() << ':' << stats->line() << " (" << stats->function() << ')';
+			}
+
+			out << '\n';
+
+			for (unsigned i = 0; i != vector_counter_count; ++i)
+			{
+				out << "  " << stats_detail::counter_names[i] << ' ' << stats->get(static_cast<vector_counter>(i)) << '\n';
+			}
+		}
+
+		first = false;
+	}
+
+	out << (json ? (first ? "]\n" : "\n]\n") : "");
+}
+
+// Zeroes every counter, e.g. after warming up.
+inline void reset_vector_stats() noexcept
+{
+	for (vector_stats *stats = stats_detail::registry.load(_STD memory_order_acquire); stats != nullptr;
+		stats = stats->next())
+	{
+		stats->reset();
+	}
+}
+
+#define JVECTOR_STATS_SITE()                                                                 \
+	static ::JSTD::vector_stats jvector_stats_site(__FILE__, __func__, __LINE__);          \
+	const ::JSTD::vector_stats_scope jvector_stats_scope(jvector_stats_site)
+#else
+inline constexpr bool vector_stats_enabled = false;
+
+template <class Vector>
+inline void stats_add(vector_counter, _STD uint64_t) noexcept
+{
+}
+
+template <class Vector>
+inline void stats_raise(vector_counter, _STD uint64_t) noexcept
+{
+}
+
+inline void dump_vector_stats(_STD ostream &out, const stats_format format = stats_format::text)
+{
+	out << (format == stats_format::json ? "[]\n" : "JVector statistics are off, define JVECTOR_STATS.\n");
+}
+
+inline void reset_vector_stats() noexcept
+{
+}
+
+#define JVECTOR_STATS_SITE() static_cast<void>(0)
+#endif // JVECTOR_STATS
+_JSTD_END
+
+#endif // !_JSTD_STATS_
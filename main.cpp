@@ -2,10 +2,35 @@
 #include <vector>
 #include <algorithm>
 #include <chrono>
-#include <Windows.h>
 #include <memory>
+#include <fstream>
+#include <string>
+#include <random>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
 
 #include "JVector.h"
+#include "JVector_View.h"
+#include "JBitVector.h"
+#include "JConcurrentVector.h"
+#include "JIncrementalVector.h"
+#include "JPackedVector.h"
+#include "JSoAVector.h"
+#include "JStableVector.h"
+#include "jstd_parallel.h"
+#include "jstd_recycling.h"
+#include "jstd_snapshot.h"
+
+#ifndef _WIN32
+#include "JMappedVector.h"
+#endif // !_WIN32
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+#include <malloc.h>
+#define JVECTOR_HAVE_MALLINFO2
+#endif // __GLIBC__
 
 #ifdef _WIN32
 #ifdef _MSC_VER
@@ -72,6 +97,828 @@ private:
 
 
 
+// Same as std::allocator but a distinct type, so JVector takes its generic allocate-move-free growth path.
+template <class T>
+struct plain_allocator : std::allocator<T>
+{
+	template <class U>
+	struct rebind
+	{
+		using other = plain_allocator<U>;
+	};
+
+	plain_allocator() = default;
+
+	template <class U>
+	plain_allocator(const plain_allocator<U>&) noexcept {}
+};
+
+// Resets the peak resident set size of this process. Linux only.
+void reset_peak_rss()
+{
+#ifdef __linux__
+	std::ofstream("/proc/self/clear_refs") << "5";
+#endif // __linux__
+}
+
+// Peak resident set size in MiB since the last reset_peak_rss(), 0 if unsupported.
+double peak_rss_mib()
+{
+#ifdef __linux__
+	std::ifstream status("/proc/self/status");
+	for (string line; std::getline(status, line);)
+	{
+		if (line.compare(0, 6, "VmHWM:") == 0)
+		{
+			return std::stod(line.substr(6)) / 1024.0;
+		}
+	}
+#endif // __linux__
+
+	return 0.0;
+}
+
+// Bytes the process holds from malloc, 0 if unsupported.
+std::size_t heap_in_use()
+{
+#ifdef JVECTOR_HAVE_MALLINFO2
+	return mallinfo2().uordblks;
+#else
+	return 0;
+#endif // JVECTOR_HAVE_MALLINFO2
+}
+
+// Appends count elements and reports the total time, the slowest reallocating push_back and the peak RSS.
+template <class Vector>
+void bench_growth(const char *name, std::size_t count)
+{
+	using clock = std::chrono::steady_clock;
+	using ms    = std::chrono::duration<double, std::milli>;
+
+	reset_peak_rss();
+
+	double worst_growth = 0.0;
+	double peak         = 0.0;
+	const auto start    = clock::now();
+
+	{
+		Vector vec;
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			if (vec.size() == vec.capacity())
+			{
+				const auto growth_start = clock::now();
+				vec.push_back(i);
+				worst_growth = (std::max)(worst_growth, ms(clock::now() - growth_start).count());
+			}
+			else
+			{
+				vec.push_back(i);
+			}
+		}
+
+		peak = peak_rss_mib();
+	}
+
+	cout << name << ": total " << ms(clock::now() - start).count() << " ms, worst growth "
+		<< worst_growth << " ms, peak RSS " << peak << " MiB" << endl;
+}
+
+// Appends count elements and reports, per growth policy, the element copies made by reallocations
+// per appended element and the average share of the capacity left unused.
+template <class Growth>
+void bench_growth_policy(const char *name, std::size_t count)
+{
+	using clock = std::chrono::steady_clock;
+	using ms    = std::chrono::duration<double, std::milli>;
+
+	std::size_t copies = 0;
+	double wasted      = 0.0;
+	const auto start   = clock::now();
+
+	{
+		JVector<std::uint64_t, plain_allocator<std::uint64_t>, Growth> vec;
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			if (vec.size() == vec.capacity())
+			{
+				copies += vec.size();
+			}
+
+			vec.push_back(i);
+			wasted += static_cast<double>(vec.capacity() - vec.size()) / static_cast<double>(vec.capacity());
+		}
+	}
+
+	cout << name << ": " << ms(clock::now() - start).count() << " ms, "
+		<< static_cast<double>(copies) / static_cast<double>(count) << " copies per element, "
+		<< 100.0 * wasted / static_cast<double>(count) << "% wasted capacity" << endl;
+}
+
+// Fills count vectors with size elements each and reports the reallocations per vector.
+template <class Vector>
+void bench_small_growth(const char *name, std::size_t count, std::size_t size)
+{
+	using clock = std::chrono::steady_clock;
+	using ms    = std::chrono::duration<double, std::milli>;
+
+	std::size_t reallocations = 0;
+	const auto start          = clock::now();
+
+	for (std::size_t n = 0; n < count; ++n)
+	{
+		Vector vec;
+
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			if (vec.size() == vec.capacity())
+			{
+				++reallocations;
+			}
+
+			vec.push_back(static_cast<typename Vector::value_type>(i));
+		}
+	}
+
+	cout << name << ": " << ms(clock::now() - start).count() << " ms, "
+		<< static_cast<double>(reallocations) / static_cast<double>(count) << " reallocations per vector" << endl;
+}
+
+// Sums lookups at random indices of a vector of count elements, where TLB misses dominate.
+template <class Vector>
+void bench_random_access(const char *name, std::size_t count, std::size_t lookups)
+{
+	using clock = std::chrono::steady_clock;
+	using ms    = std::chrono::duration<double, std::milli>;
+
+	Vector vec(count);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		vec[i] = i;
+	}
+
+	std::mt19937_64 engine(42);
+	std::uint64_t sum = 0;
+	const auto start  = clock::now();
+
+	for (std::size_t i = 0; i < lookups; ++i)
+	{
+		sum += vec[engine() % count];
+	}
+
+	cout << name << ": " << ms(clock::now() - start).count() << " ms (sum " << sum << ")" << endl;
+}
+
+// Compares two vectors of count elements differing only in the last one, with the JVector operators
+// and with the scalar std::equal / std::lexicographical_compare they replace for arithmetic types.
+template <class T>
+void bench_compare(const char *name, std::size_t count, std::size_t rounds)
+{
+	using clock = std::chrono::steady_clock;
+	using ms    = std::chrono::duration<double, std::milli>;
+
+	JVector<T> left(count, T(1));
+	JVector<T> right(count, T(1));
+	right[count - 1] = T(2);
+
+	std::size_t hits = 0;
+	auto start       = clock::now();
+
+	for (std::size_t i = 0; i < rounds; ++i)
+	{
+		hits += (left == right) + (left < right);
+	}
+
+	const double simd_time = ms(clock::now() - start).count();
+	start                  = clock::now();
+
+	for (std::size_t i = 0; i < rounds; ++i)
+	{
+		hits += std::equal(left.cbegin(), left.cend(), right.cbegin())
+			+ std::lexicographical_compare(left.cbegin(), left.cend(), right.cbegin(), right.cend());
+	}
+
+	const double scalar_time = ms(clock::now() - start).count();
+
+	cout << name << ": == and < " << simd_time << " ms, scalar " << scalar_time << " ms (" << hits << ")" << endl;
+}
+
+// Fills a vector of count elements with a non-zero value and overwrites it with assign, then times one pass
+// over a warm 4 MiB working set to show how much of it the fills evicted.
+template <class Vector>
+void bench_fill(const char *name, std::size_t count)
+{
+	using clock = std::chrono::steady_clock;
+	using ms    = std::chrono::duration<double, std::milli>;
+	using value = typename Vector::value_type;
+
+	std::vector<std::uint64_t> working_set((std::size_t(4) << 20) / sizeof(std::uint64_t), 1);
+	std::uint64_t sum = 0;
+
+	for (int pass = 0; pass < 4; ++pass)
+	{
+		for (const auto x : working_set)
+		{
+			sum += x;
+		}
+	}
+
+	auto start = clock::now();
+	Vector vec(count, value(0x5A5A5A5Au));
+	const double fill_time = ms(clock::now() - start).count();
+
+	start = clock::now();
+	vec.assign(count, value(0x12345678u));
+	const double assign_time = ms(clock::now() - start).count();
+
+	start = clock::now();
+	for (const auto x : working_set)
+	{
+		sum += x;
+	}
+	const double scan_time = ms(clock::now() - start).count();
+
+	cout << name << ": fill " << fill_time << " ms, assign " << assign_time << " ms, working set pass after them "
+		<< scan_time << " ms (" << sum + vec[count / 2] << ")" << endl;
+}
+
+// Copy-constructs and copy-assigns a vector of count elements, a config snapshot.
+template <class Vector>
+void bench_copy(const char *name, std::size_t count)
+{
+	using clock = std::chrono::steady_clock;
+	using ms    = std::chrono::duration<double, std::milli>;
+
+	Vector source(count);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		source[i] = i;
+	}
+
+	Vector target(count, 1);
+
+	auto start = clock::now();
+	Vector copy(source);
+	const double construct_time = ms(clock::now() - start).count();
+
+	start = clock::now();
+	target = source;
+	const double assign_time = ms(clock::now() - start).count();
+
+	cout << name << ": copy constructor " << construct_time << " ms, copy assignment " << assign_time
+		<< " ms (" << copy[count / 2] + target[count / 3] << ")" << endl;
+}
+
+void bench_parallel(const char *name, JSTD::parallel::thread_pool &pool, std::size_t count)
+{
+	using clock = std::chrono::steady_clock;
+	using ms    = std::chrono::duration<double, std::milli>;
+
+	JVector<std::uint64_t> keys(count);
+	std::mt19937_64 random(42);
+	for (auto &key : keys)
+	{
+		key = random();
+	}
+
+	JVector<double> scaled;
+
+	auto start = clock::now();
+	JSTD::parallel::parallel_transform(keys, scaled, [](std::uint64_t key) { return static_cast<double>(key >> 11); }, 0, pool);
+	const double transform_time = ms(clock::now() - start).count();
+
+	start = clock::now();
+	const double sum = JSTD::parallel::parallel_reduce(scaled, 0.0, std::plus<>(), 0, pool);
+	const double reduce_time = ms(clock::now() - start).count();
+
+	// An accumulator of another type than the elements, checked against the sequential fold.
+	JVector<int> small(count / 64);
+	for (std::size_t i = 0; i < small.size(); ++i)
+	{
+		small[i] = static_cast<int>(i % 1000) - 500;
+	}
+
+	long long squares = 0;
+	for (const int value : small)
+	{
+		squares += static_cast<long long>(value) * value;
+	}
+
+	const long long parallel_squares = JSTD::parallel::parallel_transform_reduce(small, 0LL, std::plus<>(),
+		[](int value) { return static_cast<long long>(value) * value; }, 1000, pool);
+	if (parallel_squares != squares)
+	{
+		cout << name << ": parallel_transform_reduce returned " << parallel_squares << ", expected " << squares << endl;
+	}
+
+	start = clock::now();
+	JSTD::parallel::parallel_sort(keys, std::less<>(), 0, pool);
+	const double sort_time = ms(clock::now() - start).count();
+
+	cout << name << ": transform " << transform_time << " ms, reduce " << reduce_time << " ms, sort " << sort_time
+		<< " ms (" << sum + keys[count / 2] << ")" << endl;
+}
+
+// Many short-lived vectors per request: malloc and free for each against one arena reset per request.
+template <class Vector, class MakeVector, class EndRequest>
+void bench_request(const char *name, std::size_t requests, MakeVector make_vector, EndRequest end_request)
+{
+	using clock = std::chrono::steady_clock;
+	using ms    = std::chrono::duration<double, std::milli>;
+
+	std::size_t total = 0;
+	auto start = clock::now();
+
+	for (std::size_t request = 0; request < requests; ++request)
+	{
+		{
+			for (std::size_t i = 0; i < 48; ++i)
+			{
+				Vector temporary = make_vector();
+				for (std::size_t j = 0; j < 20 + i; ++j)
+				{
+					temporary.push_back(static_cast<std::uint32_t>(request + j));
+				}
+
+				total += temporary.back();
+			}
+		}
+
+		end_request();
+	}
+
+	const double time = ms(clock::now() - start).count();
+	cout << name << ": " << time << " ms (" << total << ")" << endl;
+}
+
+// Vectors of similar sizes created and destroyed in a hot loop.
+template <class Vector>
+void bench_churn(const char *name, std::size_t rounds)
+{
+	using clock = std::chrono::steady_clock;
+	using ms    = std::chrono::duration<double, std::milli>;
+
+	std::size_t total = 0;
+	auto start = clock::now();
+
+	for (std::size_t round = 0; round < rounds; ++round)
+	{
+		Vector first(200 + round % 64, static_cast<std::uint32_t>(round));
+		Vector second(first);
+		second.push_back(1);
+		total += first.size() + second.back();
+	}
+
+	const double time = ms(clock::now() - start).count();
+	cout << name << ": " << time << " ms (" << total << ")" << endl;
+}
+
+#ifndef _WIN32
+// Loading a table written offline: reading it into a JVector against mapping it in place.
+void bench_mapped(const char *path, std::size_t count)
+{
+	using clock = std::chrono::steady_clock;
+	using ms    = std::chrono::duration<double, std::milli>;
+
+	{
+		JMappedVector<std::uint64_t> table;
+		table.create(path, count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			table.push_back(i);
+		}
+	}
+
+	auto start = clock::now();
+	std::ifstream file(path, std::ios::binary);
+	JVector<std::uint64_t> copy;
+	copy.resize_default_init(count);
+	file.read(reinterpret_cast<char*>(copy.data()), static_cast<std::streamsize>(count * sizeof(std::uint64_t)));
+	std::uint64_t copy_sum = 0;
+	for (const std::uint64_t value : copy)
+	{
+		copy_sum += value;
+	}
+	const double read_time = ms(clock::now() - start).count();
+
+	start = clock::now();
+	JMappedVector<std::uint64_t> mapped(path, JMappedVector_Mode::read_only);
+	mapped.advise(JMappedVector_Advice::sequential);
+	std::uint64_t mapped_sum = 0;
+	for (const std::uint64_t value : mapped)
+	{
+		mapped_sum += value;
+	}
+	const double map_time = ms(clock::now() - start).count();
+
+	cout << "load table: read into JVector " << read_time << " ms, JMappedVector " << map_time << " ms ("
+		<< copy_sum - mapped_sum << ")" << endl;
+	std::remove(path);
+}
+#endif // !_WIN32
+
+#ifndef _WIN32
+// Restoring a saved vector: element-wise deserialization against a mapped snapshot.
+void bench_snapshot(const char *path, std::size_t count)
+{
+	using clock = std::chrono::steady_clock;
+	using ms    = std::chrono::duration<double, std::milli>;
+
+	JVector<std::uint64_t> state(count);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		state[i] = i * 3;
+	}
+
+	auto start = clock::now();
+	JSTD::save(state, path);
+	const double save_time = ms(clock::now() - start).count();
+
+	start = clock::now();
+	std::ifstream file(path, std::ios::binary);
+	file.seekg(sizeof(JSTD::snapshot_header));
+	JVector<std::uint64_t> restored;
+	std::uint64_t value;
+	while (file.read(reinterpret_cast<char*>(&value), sizeof(value)))
+	{
+		restored.push_back(value);
+	}
+	const double deserialize_time = ms(clock::now() - start).count();
+
+	start = clock::now();
+	const JSTD::snapshot_view<std::uint64_t> view = JSTD::load_view<std::uint64_t>(path);
+	const double view_time = ms(clock::now() - start).count();
+
+	start = clock::now();
+	const bool intact = view.verify();
+	const double verify_time = ms(clock::now() - start).count();
+
+	cout << "snapshot: save " << save_time << " ms, element-wise restore " << deserialize_time << " ms, load_view "
+		<< view_time << " ms, verify " << verify_time << " ms (" << restored.size() + view[count / 2] + intact << ")"
+		<< endl;
+	std::remove(path);
+}
+#endif // !_WIN32
+
+// A decoder's output buffer handed to a JVector and back: copying the elements against adopting the buffer.
+void bench_handoff(std::size_t count, std::size_t rounds)
+{
+	using clock = std::chrono::steady_clock;
+	using ms    = std::chrono::duration<double, std::milli>;
+
+	std::uint64_t total = 0;
+	auto start = clock::now();
+	for (std::size_t round = 0; round < rounds; ++round)
+	{
+		auto *decoded = static_cast<std::uint64_t*>(JSTD::native_allocate(count * sizeof(std::uint64_t)));
+		decoded[count - 1] = round;
+		JVector<std::uint64_t> frame(decoded, decoded + count);
+		JSTD::native_deallocate(decoded, count * sizeof(std::uint64_t));
+		total += frame.back();
+	}
+	const double copy_time = ms(clock::now() - start).count();
+
+	start = clock::now();
+	for (std::size_t round = 0; round < rounds; ++round)
+	{
+		auto *decoded = static_cast<std::uint64_t*>(JSTD::native_allocate(count * sizeof(std::uint64_t)));
+		decoded[count - 1] = round;
+		JVector<std::uint64_t> frame;
+		frame.adopt(decoded, count, count);
+		const JVector_View<std::uint64_t> view(frame);
+		total += view.last(1)[0];
+	}
+	const double adopt_time = ms(clock::now() - start).count();
+
+	cout << "handoff: copy " << copy_time << " ms, adopt " << adopt_time << " ms (" << total << ")" << endl;
+}
+
+// Event collector: threads appending to a JVector behind a mutex against a JConcurrentVector.
+void bench_collector(unsigned threads, std::size_t events)
+{
+	using clock = std::chrono::steady_clock;
+	using ms    = std::chrono::duration<double, std::milli>;
+
+	JVector<std::uint64_t> locked;
+	std::mutex lock;
+	std::vector<std::thread> workers;
+
+	auto start = clock::now();
+	for (unsigned t = 0; t < threads; ++t)
+	{
+		workers.emplace_back([&, t] {
+			for (std::size_t i = 0; i < events; ++i)
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				locked.push_back(t + i);
+			}
+		});
+	}
+	for (auto &worker : workers)
+	{
+		worker.join();
+	}
+	const double locked_time = ms(clock::now() - start).count();
+
+	JConcurrentVector<std::uint64_t> concurrent;
+	workers.clear();
+
+	start = clock::now();
+	for (unsigned t = 0; t < threads; ++t)
+	{
+		workers.emplace_back([&, t] {
+			for (std::size_t i = 0; i < events; ++i)
+			{
+				concurrent.push_back(t + i);
+			}
+		});
+	}
+	for (auto &worker : workers)
+	{
+		worker.join();
+	}
+	const double concurrent_time = ms(clock::now() - start).count();
+
+	cout << "collector, " << threads << " threads: mutex and JVector " << locked_time << " ms, JConcurrentVector "
+		<< concurrent_time << " ms (" << locked.size() + concurrent.size() << ")" << endl;
+}
+
+// A 40 byte record scanned for one field: JVector of structs against the same fields in JSoAVector columns.
+struct particle
+{
+	double        x;
+	double        y;
+	double        z;
+	float         mass;
+	std::uint32_t id;
+	std::uint64_t flags;
+};
+
+void bench_soa(std::size_t count, std::size_t rounds)
+{
+	using clock = std::chrono::steady_clock;
+	using ms    = std::chrono::duration<double, std::milli>;
+
+	JVector<particle> aos;
+	JSoAVector<double, double, double, float, std::uint32_t, std::uint64_t> soa;
+	aos.reserve(count);
+	soa.reserve(count);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const particle p{ double(i), 0.5 * i, 0.25 * i, float(i % 100), std::uint32_t(i), i };
+		aos.push_back(p);
+		soa.push_back(p);
+	}
+
+	std::uint64_t total = 0;
+	auto start = clock::now();
+	for (std::size_t round = 0; round < rounds; ++round)
+	{
+		for (const particle &p : aos)
+		{
+			total += p.id;
+		}
+	}
+	const double aos_time = ms(clock::now() - start).count();
+
+	start = clock::now();
+	for (std::size_t round = 0; round < rounds; ++round)
+	{
+		for (const std::uint32_t id : soa.column<4>())
+		{
+			total += id;
+		}
+	}
+	const double soa_time = ms(clock::now() - start).count();
+
+	cout << "sum of one field: JVector of structs " << aos_time << " ms, JSoAVector column " << soa_time
+		<< " ms (" << total << ")" << endl;
+}
+
+// Counting and visiting the set flags of a sparse flag set, one bool per byte against packed bits.
+void bench_bits(std::size_t count, std::size_t rounds)
+{
+	using clock = std::chrono::steady_clock;
+	using ms    = std::chrono::duration<double, std::milli>;
+
+	std::mt19937_64 rng(42);
+	JVector<bool> bytes(count, false);
+	JBitVector<> bits(count);
+	for (std::size_t i = 0; i < count / 100; ++i)
+	{
+		const std::size_t pos = rng() % count;
+		bytes[pos] = true;
+		bits.set(pos);
+	}
+
+	std::size_t total = 0;
+	auto start = clock::now();
+	for (std::size_t round = 0; round < rounds; ++round)
+	{
+		total += std::count(bytes.begin(), bytes.end(), true);
+	}
+	const double bytes_count = ms(clock::now() - start).count();
+
+	start = clock::now();
+	for (std::size_t round = 0; round < rounds; ++round)
+	{
+		total += bits.count();
+	}
+	const double bits_count = ms(clock::now() - start).count();
+
+	start = clock::now();
+	for (std::size_t round = 0; round < rounds; ++round)
+	{
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			if (bytes[i])
+			{
+				total += i;
+			}
+		}
+	}
+	const double bytes_find = ms(clock::now() - start).count();
+
+	start = clock::now();
+	for (std::size_t round = 0; round < rounds; ++round)
+	{
+		for (std::size_t i = bits.find_first(); i != bits.npos; i = bits.find_next(i))
+		{
+			total += i;
+		}
+	}
+	const double bits_find = ms(clock::now() - start).count();
+
+	cout << count << " flags: JVector<bool> " << (count >> 20) << " MiB, count " << bytes_count << " ms, visit "
+		<< bytes_find << " ms; JBitVector " << (bits.word_count() * 8 >> 20) << " MiB, count " << bits_count
+		<< " ms, visit " << bits_find << " ms (" << total << ")" << endl;
+}
+
+// A sorted posting list as plain ids and packed: memory, a full scan and lookups.
+void bench_packed(std::size_t count, std::size_t lookups)
+{
+	using clock = std::chrono::steady_clock;
+	using ms    = std::chrono::duration<double, std::milli>;
+
+	std::mt19937 rng(7);
+	JVector<std::uint32_t> plain;
+	plain.reserve(count);
+	std::uint32_t id = 0;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		id += 1 + rng() % 32;
+		plain.push_back(id);
+	}
+
+	// A first block of equal values packs into no words at all.
+	JVector<std::uint32_t> constant(JPackedVector<std::uint32_t>::block_size * 2, 5);
+	for (std::size_t i = JPackedVector<std::uint32_t>::block_size; i < constant.size(); ++i)
+	{
+		constant[i] = static_cast<std::uint32_t>(rng());
+	}
+
+	const JPackedVector<std::uint32_t> constant_packed(constant);
+	if (!std::equal(constant.begin(), constant.end(), constant_packed.begin(), constant_packed.end()))
+	{
+		cout << "JPackedVector: a constant first block did not round trip" << endl;
+	}
+
+	auto start = clock::now();
+	JPackedVector<std::uint32_t> packed(plain);
+	const double encode_time = ms(clock::now() - start).count();
+
+	std::uint64_t total = 0;
+	start = clock::now();
+	for (const std::uint32_t value : plain)
+	{
+		total += value;
+	}
+	const double plain_scan = ms(clock::now() - start).count();
+
+	start = clock::now();
+	for (const std::uint32_t value : packed)
+	{
+		total += value;
+	}
+	const double packed_scan = ms(clock::now() - start).count();
+
+	start = clock::now();
+	for (std::size_t i = 0; i < lookups; ++i)
+	{
+		total += std::lower_bound(plain.begin(), plain.end(), rng() % id) - plain.begin();
+	}
+	const double plain_find = ms(clock::now() - start).count();
+
+	start = clock::now();
+	for (std::size_t i = 0; i < lookups; ++i)
+	{
+		total += packed.lower_bound(rng() % id);
+	}
+	const double packed_find = ms(clock::now() - start).count();
+
+	cout << count << " sorted ids: JVector " << (plain.size() * 4 >> 20) << " MiB, scan " << plain_scan
+		<< " ms, lower_bound " << plain_find << " ms; JPackedVector " << (packed.compressed_bytes() >> 20)
+		<< " MiB, encode " << encode_time << " ms, scan " << packed_scan << " ms, lower_bound " << packed_find
+		<< " ms (" << total << ")" << endl;
+}
+
+// Latency of each push_back while growing to count elements: median, 99.9th percentile and worst.
+template <class Vector>
+void bench_push_latency(const char *name, std::size_t count)
+{
+	using clock = std::chrono::steady_clock;
+
+	std::vector<std::uint32_t> latencies(count);
+	const typename Vector::value_type value{};
+	Vector vec;
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const auto start = clock::now();
+		vec.push_back(value);
+		latencies[i] = static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			clock::now() - start).count());
+	}
+
+	std::sort(latencies.begin(), latencies.end());
+	cout << name << " push_back: p50 " << latencies[count / 2] << " ns, p99.9 " << latencies[count - count / 1000]
+		<< " ns, max " << latencies.back() / 1000 << " us (" << vec.size() << ")" << endl;
+}
+
+// An element whose constructors throw once a countdown runs out, relocatable so JVector keeps it in native storage.
+struct throwing_element
+{
+	static int countdown;
+	static int live;
+
+	throwing_element()
+	{
+		if (--countdown == 0)
+		{
+			throw std::runtime_error("throwing_element");
+		}
+
+		++live;
+	}
+
+	throwing_element(const throwing_element&)
+		: throwing_element()
+	{}
+
+	~throwing_element()
+	{
+		--live;
+	}
+};
+int throwing_element::countdown = 0;
+int throwing_element::live      = 0;
+
+template <>
+struct JSTD::is_trivially_relocatable<throwing_element> : std::true_type {};
+
+// The count constructors give everything back when an element constructor throws.
+void check_throwing_construction(std::size_t rounds)
+{
+	const throwing_element value;
+	std::size_t heap = 0;
+
+	// The first round is not counted, the runtime allocates once for the first exception thrown.
+	for (std::size_t i = 0; i <= rounds; ++i)
+	{
+		if (i == 1)
+		{
+			heap = heap_in_use();
+		}
+
+		try
+		{
+			throwing_element::countdown = 8;
+			JVector<throwing_element> defaulted(16);
+		}
+		catch (const std::runtime_error&)
+		{
+		}
+
+		try
+		{
+			throwing_element::countdown = 8;
+			JVector<throwing_element> filled(16, value);
+		}
+		catch (const std::runtime_error&)
+		{
+		}
+	}
+
+	const std::size_t leaked = heap_in_use() - heap;
+	if (throwing_element::live != 1 || leaked != 0)
+	{
+		cout << "throwing construction: " << throwing_element::live - 1 << " elements and " << leaked
+			<< " bytes left behind" << endl;
+	}
+}
+
 int main()
 {
 #ifdef _WIN32
@@ -80,7 +927,114 @@ int main()
 #endif // WIN32
 
 	JVector<int> g;
-	
-	
+
+	check_throwing_construction(10000);
+
+	// Growth of a 512 MiB vector: realloc/mremap against allocate, copy and free.
+	constexpr std::size_t growth_count = std::size_t(1) << 26;
+	bench_growth<JVector<std::uint64_t>>("JVector (realloc/mremap)", growth_count);
+	bench_growth<JVector<std::uint64_t, plain_allocator<std::uint64_t>>>("JVector (allocate and copy)", growth_count);
+	bench_growth<std::vector<std::uint64_t>>("std::vector", growth_count);
+
+	constexpr std::size_t policy_count = std::size_t(1) << 22;
+	bench_growth_policy<JSTD::default_growth>("1.5x", policy_count);
+	bench_growth_policy<JSTD::double_growth>("2x", policy_count);
+	bench_growth_policy<JSTD::geometric_growth<5, 4>>("1.25x", policy_count);
+	bench_growth_policy<JSTD::page_growth<>>("1.5x, page rounded", policy_count);
+	bench_growth_policy<JSTD::size_class_growth<>>("1.5x, size class rounded", policy_count);
+	bench_growth_policy<JSTD::fixed_growth<65536>>("+65536", policy_count);
+
+	// Small vectors: the allocator's size class slack counted as capacity against exact capacities.
+	constexpr std::size_t small_count = 1000000;
+	constexpr std::size_t small_size  = 100;
+	bench_small_growth<JVector<std::uint16_t>>("JVector (usable size)", small_count, small_size);
+	bench_small_growth<JVector<std::uint16_t, plain_allocator<std::uint16_t>>>("JVector (exact size)", small_count, small_size);
+	bench_small_growth<std::vector<std::uint16_t>>("std::vector", small_count, small_size);
+
+	// Random reads over 1 GiB: huge page backed buffers against 4 KiB pages.
+	constexpr std::size_t random_count = (std::size_t(1) << 30) / sizeof(std::uint64_t);
+	bench_random_access<JVector<std::uint64_t>>("JVector (huge pages)", random_count, 20000000);
+	bench_random_access<std::vector<std::uint64_t>>("std::vector", random_count, 20000000);
+
+	// 64 KiB and 64 MiB key vectors.
+	bench_compare<std::uint8_t>("uint8_t, 64 KiB", std::size_t(1) << 16, 20000);
+	bench_compare<std::uint32_t>("uint32_t, 64 KiB", std::size_t(1) << 14, 20000);
+	bench_compare<float>("float, 64 KiB", std::size_t(1) << 14, 20000);
+	bench_compare<double>("double, 64 KiB", std::size_t(1) << 13, 20000);
+	bench_compare<std::uint32_t>("uint32_t, 64 MiB", std::size_t(1) << 24, 20);
+	bench_compare<double>("double, 64 MiB", std::size_t(1) << 23, 20);
+
+	// 1 GiB and 1 MiB fills.
+	bench_fill<JVector<std::uint32_t>>("JVector, 1 GiB", (std::size_t(1) << 30) / sizeof(std::uint32_t));
+	bench_fill<std::vector<std::uint32_t>>("std::vector, 1 GiB", (std::size_t(1) << 30) / sizeof(std::uint32_t));
+	bench_fill<JVector<std::uint32_t>>("JVector, 1 MiB", (std::size_t(1) << 20) / sizeof(std::uint32_t));
+	bench_fill<std::vector<std::uint32_t>>("std::vector, 1 MiB", (std::size_t(1) << 20) / sizeof(std::uint32_t));
+
+	// 512 MiB copies, on one thread and on all of them.
+	constexpr std::size_t copy_count = (std::size_t(512) << 20) / sizeof(std::uint64_t);
+	bench_copy<JVector<std::uint64_t>>("JVector, 1 thread", copy_count);
+	JSTD::set_copy_threads(0);
+	bench_copy<JVector<std::uint64_t>>("JVector, all threads", copy_count);
+	JSTD::set_copy_threads(1);
+	bench_copy<std::vector<std::uint64_t>>("std::vector", copy_count);
+
+	// Bulk operations over 256 MiB on one worker and on one per hardware thread.
+	constexpr std::size_t parallel_count = (std::size_t(256) << 20) / sizeof(std::uint64_t);
+	JSTD::parallel::thread_pool single(1);
+	bench_parallel("1 worker", single, parallel_count);
+	bench_parallel("all workers", JSTD::parallel::default_pool(), parallel_count);
+
+	// 48 temporaries per request.
+	constexpr std::size_t request_count = 200000;
+	bench_request<JVector<std::uint32_t>>("JVector (malloc)", request_count,
+		[] { return JVector<std::uint32_t>(); }, [] {});
+
+	static unsigned char arena_block[1 << 20];
+	JSTD::arena request_arena(arena_block, sizeof(arena_block));
+	using arena_vector = JVector<std::uint32_t, JSTD::arena_allocator<std::uint32_t>>;
+	bench_request<arena_vector>("JVector (arena)", request_count,
+		[&] { return arena_vector(JSTD::arena_allocator<std::uint32_t>(request_arena)); }, [&] { request_arena.reset(); });
+
+	// Steady churn: malloc and free against thread local free lists.
+	constexpr std::size_t churn_rounds = 10000000;
+	bench_churn<JVector<std::uint32_t>>("JVector (malloc)", churn_rounds);
+	bench_churn<JVector<std::uint32_t, JSTD::recycling_allocator<std::uint32_t>>>("JVector (recycling)", churn_rounds);
+	const JSTD::recycling_stats recycling = JSTD::recycling_thread_stats();
+	cout << "recycling: " << recycling.hits << " hits, " << recycling.misses << " misses" << endl;
+
+	// 4 threads appending 4M events each.
+	bench_collector(4, 4000000);
+
+	// 16M elements: JVector copies everything on each growth unless it can mremap, JStableVector adds a chunk
+	// and JIncrementalVector spreads the copy over the following push_back calls.
+	constexpr std::size_t latency_count = std::size_t(1) << 24;
+	bench_push_latency<JVector<std::string>>("JVector<string>", latency_count);
+	bench_push_latency<JStableVector<std::string>>("JStableVector<string>", latency_count);
+	bench_push_latency<JIncrementalVector<std::string>>("JIncrementalVector<string>", latency_count);
+	bench_push_latency<JVector<std::uint64_t>>("JVector<uint64_t>", latency_count);
+	bench_push_latency<JStableVector<std::uint64_t>>("JStableVector<uint64_t>", latency_count);
+
+	// 4M particles of 40 bytes, ids summed 20 times.
+	bench_soa(std::size_t(1) << 22, 20);
+	bench_bits(std::size_t(1) << 28, 10);
+	bench_packed(std::size_t(1) << 26, 1 << 20);
+
+	// 200 frames of 8 MiB.
+	bench_handoff((std::size_t(8) << 20) / sizeof(std::uint64_t), 200);
+
+#ifndef _WIN32
+	// 256 MiB table, in the page cache after it was written.
+	bench_mapped("jvector_table.bin", (std::size_t(256) << 20) / sizeof(std::uint64_t));
+
+	// 256 MiB of state saved and restored.
+	bench_snapshot("jvector_state.snap", (std::size_t(256) << 20) / sizeof(std::uint64_t));
+#endif // !_WIN32
+
+	// Built with JVECTOR_STATS, what the JVectors above allocated, moved and left unused.
+	if constexpr (JSTD::vector_stats_enabled)
+	{
+		JSTD::dump_vector_stats(cout);
+	}
+
 	return 0;
 }
\ No newline at end of file